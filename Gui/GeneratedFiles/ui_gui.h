@@ -16,11 +16,13 @@
 #include <QtWidgets/QAction>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QButtonGroup>
+#include <QtWidgets/QComboBox>
 #include <QtWidgets/QDoubleSpinBox>
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QGroupBox>
 #include <QtWidgets/QHeaderView>
 #include <QtWidgets/QLabel>
+#include <QtWidgets/QLineEdit>
 #include <QtWidgets/QMainWindow>
 #include <QtWidgets/QProgressBar>
 #include <QtWidgets/QPushButton>
@@ -45,6 +47,10 @@ public:
     QDoubleSpinBox *sensitivitySpinBox;
     QLabel *harrisThreshholdLabel;
     QSpinBox *harrisThreshholdSpinBox;
+    QLabel *suppressionModeLabel;
+    QComboBox *suppressionModeComboBox;
+    QLabel *suppressionRangeLabel;
+    QSpinBox *suppressionRangeSpinBox;
     QGroupBox *progressGroupBox;
     QProgressBar *cpuProgressBar;
     QProgressBar *gpuProgressBar;
@@ -59,6 +65,8 @@ public:
     QLabel *templateUpdateFramesLabel;
     QLabel *label_12;
     QDoubleSpinBox *templateUpdateMaximumDistanceSpinBox;
+    QLabel *threadsLabel;
+    QSpinBox *threadsSpinBox;
     QGroupBox *groupBox;
     QPushButton *startButton;
     QPushButton *stopButton;
@@ -84,6 +92,8 @@ public:
     QLabel *label_2;
     QLabel *label_3;
     QLabel *cpuTotalProcessingTimeLabel;
+    QLabel *label_13;
+    QLabel *cpuDroppedFramesLabel;
     QGroupBox *groupBox_4;
     QWidget *gridLayoutWidget_5;
     QGridLayout *gridLayout_5;
@@ -95,6 +105,26 @@ public:
     QLabel *gpuFramesProcessedLabel;
     QLabel *label_6;
     QLabel *gpuTotalProcessingTimeLabel;
+    QLabel *label_14;
+    QLabel *gpuDroppedFramesLabel;
+    QWidget *acquisitionTab;
+    QGroupBox *acquisitionSettingsGroupBox;
+    QWidget *gridLayoutWidget_6;
+    QGridLayout *gridLayout_6;
+    QLabel *framePolicyLabel;
+    QComboBox *framePolicyComboBox;
+    QLabel *imageQueueBudgetLabel;
+    QSpinBox *imageQueueBudgetSpinBox;
+    QLabel *panguServersLabel;
+    QLineEdit *panguServersLineEdit;
+    QLabel *panguConnectionsLabel;
+    QSpinBox *panguConnectionsSpinBox;
+    QLabel *pipelineDepthLabel;
+    QSpinBox *pipelineDepthSpinBox;
+    QLabel *frameCachePathLabel;
+    QLineEdit *frameCachePathLineEdit;
+    QLabel *sceneTagLabel;
+    QLineEdit *sceneTagLineEdit;
 
     void setupUi(QMainWindow *GuiClass)
     {
@@ -118,10 +148,10 @@ public:
         tableView->horizontalHeader()->setVisible(true);
         featureDetectionSettingsGroupBox = new QGroupBox(centralWidget);
         featureDetectionSettingsGroupBox->setObjectName(QStringLiteral("featureDetectionSettingsGroupBox"));
-        featureDetectionSettingsGroupBox->setGeometry(QRect(20, 170, 281, 151));
+        featureDetectionSettingsGroupBox->setGeometry(QRect(20, 170, 281, 211));
         gridLayoutWidget_2 = new QWidget(featureDetectionSettingsGroupBox);
         gridLayoutWidget_2->setObjectName(QStringLiteral("gridLayoutWidget_2"));
-        gridLayoutWidget_2->setGeometry(QRect(9, 29, 261, 111));
+        gridLayoutWidget_2->setGeometry(QRect(9, 29, 261, 171));
         gridLayout_2 = new QGridLayout(gridLayoutWidget_2);
         gridLayout_2->setSpacing(6);
         gridLayout_2->setContentsMargins(11, 11, 11, 11);
@@ -170,9 +200,32 @@ public:
 
         gridLayout_2->addWidget(harrisThreshholdSpinBox, 2, 1, 1, 1);
 
+        suppressionModeLabel = new QLabel(gridLayoutWidget_2);
+        suppressionModeLabel->setObjectName(QStringLiteral("suppressionModeLabel"));
+
+        gridLayout_2->addWidget(suppressionModeLabel, 3, 0, 1, 1);
+
+        suppressionModeComboBox = new QComboBox(gridLayoutWidget_2);
+        suppressionModeComboBox->setObjectName(QStringLiteral("suppressionModeComboBox"));
+
+        gridLayout_2->addWidget(suppressionModeComboBox, 3, 1, 1, 1);
+
+        suppressionRangeLabel = new QLabel(gridLayoutWidget_2);
+        suppressionRangeLabel->setObjectName(QStringLiteral("suppressionRangeLabel"));
+
+        gridLayout_2->addWidget(suppressionRangeLabel, 4, 0, 1, 1);
+
+        suppressionRangeSpinBox = new QSpinBox(gridLayoutWidget_2);
+        suppressionRangeSpinBox->setObjectName(QStringLiteral("suppressionRangeSpinBox"));
+        suppressionRangeSpinBox->setMinimum(1);
+        suppressionRangeSpinBox->setMaximum(16);
+        suppressionRangeSpinBox->setValue(3);
+
+        gridLayout_2->addWidget(suppressionRangeSpinBox, 4, 1, 1, 1);
+
         progressGroupBox = new QGroupBox(centralWidget);
         progressGroupBox->setObjectName(QStringLiteral("progressGroupBox"));
-        progressGroupBox->setGeometry(QRect(20, 580, 281, 151));
+        progressGroupBox->setGeometry(QRect(20, 670, 281, 151));
         cpuProgressBar = new QProgressBar(progressGroupBox);
         cpuProgressBar->setObjectName(QStringLiteral("cpuProgressBar"));
         cpuProgressBar->setGeometry(QRect(60, 40, 201, 23));
@@ -190,10 +243,10 @@ public:
         label_11->setGeometry(QRect(20, 100, 31, 16));
         featureTrackingSettingsGroupBox = new QGroupBox(centralWidget);
         featureTrackingSettingsGroupBox->setObjectName(QStringLiteral("featureTrackingSettingsGroupBox"));
-        featureTrackingSettingsGroupBox->setGeometry(QRect(20, 330, 281, 141));
+        featureTrackingSettingsGroupBox->setGeometry(QRect(20, 390, 281, 171));
         gridLayoutWidget = new QWidget(featureTrackingSettingsGroupBox);
         gridLayoutWidget->setObjectName(QStringLiteral("gridLayoutWidget"));
-        gridLayoutWidget->setGeometry(QRect(10, 30, 261, 101));
+        gridLayoutWidget->setGeometry(QRect(10, 30, 261, 131));
         gridLayout = new QGridLayout(gridLayoutWidget);
         gridLayout->setSpacing(6);
         gridLayout->setContentsMargins(11, 11, 11, 11);
@@ -240,9 +293,22 @@ public:
 
         gridLayout->addWidget(templateUpdateMaximumDistanceSpinBox, 3, 1, 1, 1);
 
+        threadsLabel = new QLabel(gridLayoutWidget);
+        threadsLabel->setObjectName(QStringLiteral("threadsLabel"));
+
+        gridLayout->addWidget(threadsLabel, 4, 0, 1, 1);
+
+        threadsSpinBox = new QSpinBox(gridLayoutWidget);
+        threadsSpinBox->setObjectName(QStringLiteral("threadsSpinBox"));
+        threadsSpinBox->setMinimum(0);
+        threadsSpinBox->setMaximum(64);
+        threadsSpinBox->setValue(0);
+
+        gridLayout->addWidget(threadsSpinBox, 4, 1, 1, 1);
+
         groupBox = new QGroupBox(centralWidget);
         groupBox->setObjectName(QStringLiteral("groupBox"));
-        groupBox->setGeometry(QRect(20, 480, 281, 91));
+        groupBox->setGeometry(QRect(20, 570, 281, 91));
         startButton = new QPushButton(groupBox);
         startButton->setObjectName(QStringLiteral("startButton"));
         startButton->setEnabled(false);
@@ -361,6 +427,18 @@ public:
 
         gridLayout_4->addWidget(cpuTotalProcessingTimeLabel, 3, 1, 1, 1);
 
+        label_13 = new QLabel(gridLayoutWidget_4);
+        label_13->setObjectName(QStringLiteral("label_13"));
+        label_13->setFont(font1);
+
+        gridLayout_4->addWidget(label_13, 4, 0, 1, 1);
+
+        cpuDroppedFramesLabel = new QLabel(gridLayoutWidget_4);
+        cpuDroppedFramesLabel->setObjectName(QStringLiteral("cpuDroppedFramesLabel"));
+        cpuDroppedFramesLabel->setFont(font);
+
+        gridLayout_4->addWidget(cpuDroppedFramesLabel, 4, 1, 1, 1);
+
         groupBox_4 = new QGroupBox(statisticsTab);
         groupBox_4->setObjectName(QStringLiteral("groupBox_4"));
         groupBox_4->setGeometry(QRect(530, 20, 451, 251));
@@ -420,7 +498,112 @@ public:
 
         gridLayout_5->addWidget(gpuTotalProcessingTimeLabel, 3, 1, 1, 1);
 
+        label_14 = new QLabel(gridLayoutWidget_5);
+        label_14->setObjectName(QStringLiteral("label_14"));
+        label_14->setFont(font1);
+
+        gridLayout_5->addWidget(label_14, 4, 0, 1, 1);
+
+        gpuDroppedFramesLabel = new QLabel(gridLayoutWidget_5);
+        gpuDroppedFramesLabel->setObjectName(QStringLiteral("gpuDroppedFramesLabel"));
+        gpuDroppedFramesLabel->setFont(font);
+
+        gridLayout_5->addWidget(gpuDroppedFramesLabel, 4, 1, 1, 1);
+
         tabWidget->addTab(statisticsTab, QString());
+        acquisitionTab = new QWidget();
+        acquisitionTab->setObjectName(QStringLiteral("acquisitionTab"));
+        acquisitionSettingsGroupBox = new QGroupBox(acquisitionTab);
+        acquisitionSettingsGroupBox->setObjectName(QStringLiteral("acquisitionSettingsGroupBox"));
+        acquisitionSettingsGroupBox->setGeometry(QRect(29, 20, 451, 271));
+        gridLayoutWidget_6 = new QWidget(acquisitionSettingsGroupBox);
+        gridLayoutWidget_6->setObjectName(QStringLiteral("gridLayoutWidget_6"));
+        gridLayoutWidget_6->setGeometry(QRect(30, 30, 391, 231));
+        gridLayout_6 = new QGridLayout(gridLayoutWidget_6);
+        gridLayout_6->setSpacing(6);
+        gridLayout_6->setContentsMargins(11, 11, 11, 11);
+        gridLayout_6->setObjectName(QStringLiteral("gridLayout_6"));
+        gridLayout_6->setContentsMargins(0, 0, 0, 0);
+        framePolicyLabel = new QLabel(gridLayoutWidget_6);
+        framePolicyLabel->setObjectName(QStringLiteral("framePolicyLabel"));
+
+        gridLayout_6->addWidget(framePolicyLabel, 0, 0, 1, 1);
+
+        framePolicyComboBox = new QComboBox(gridLayoutWidget_6);
+        framePolicyComboBox->setObjectName(QStringLiteral("framePolicyComboBox"));
+
+        gridLayout_6->addWidget(framePolicyComboBox, 0, 1, 1, 1);
+
+        imageQueueBudgetLabel = new QLabel(gridLayoutWidget_6);
+        imageQueueBudgetLabel->setObjectName(QStringLiteral("imageQueueBudgetLabel"));
+
+        gridLayout_6->addWidget(imageQueueBudgetLabel, 1, 0, 1, 1);
+
+        imageQueueBudgetSpinBox = new QSpinBox(gridLayoutWidget_6);
+        imageQueueBudgetSpinBox->setObjectName(QStringLiteral("imageQueueBudgetSpinBox"));
+        imageQueueBudgetSpinBox->setMinimum(1);
+        imageQueueBudgetSpinBox->setMaximum(4096);
+        imageQueueBudgetSpinBox->setValue(64);
+
+        gridLayout_6->addWidget(imageQueueBudgetSpinBox, 1, 1, 1, 1);
+
+        panguServersLabel = new QLabel(gridLayoutWidget_6);
+        panguServersLabel->setObjectName(QStringLiteral("panguServersLabel"));
+
+        gridLayout_6->addWidget(panguServersLabel, 2, 0, 1, 1);
+
+        panguServersLineEdit = new QLineEdit(gridLayoutWidget_6);
+        panguServersLineEdit->setObjectName(QStringLiteral("panguServersLineEdit"));
+
+        gridLayout_6->addWidget(panguServersLineEdit, 2, 1, 1, 1);
+
+        panguConnectionsLabel = new QLabel(gridLayoutWidget_6);
+        panguConnectionsLabel->setObjectName(QStringLiteral("panguConnectionsLabel"));
+
+        gridLayout_6->addWidget(panguConnectionsLabel, 3, 0, 1, 1);
+
+        panguConnectionsSpinBox = new QSpinBox(gridLayoutWidget_6);
+        panguConnectionsSpinBox->setObjectName(QStringLiteral("panguConnectionsSpinBox"));
+        panguConnectionsSpinBox->setMinimum(1);
+        panguConnectionsSpinBox->setMaximum(16);
+        panguConnectionsSpinBox->setValue(1);
+
+        gridLayout_6->addWidget(panguConnectionsSpinBox, 3, 1, 1, 1);
+
+        pipelineDepthLabel = new QLabel(gridLayoutWidget_6);
+        pipelineDepthLabel->setObjectName(QStringLiteral("pipelineDepthLabel"));
+
+        gridLayout_6->addWidget(pipelineDepthLabel, 4, 0, 1, 1);
+
+        pipelineDepthSpinBox = new QSpinBox(gridLayoutWidget_6);
+        pipelineDepthSpinBox->setObjectName(QStringLiteral("pipelineDepthSpinBox"));
+        pipelineDepthSpinBox->setMinimum(1);
+        pipelineDepthSpinBox->setMaximum(32);
+        pipelineDepthSpinBox->setValue(4);
+
+        gridLayout_6->addWidget(pipelineDepthSpinBox, 4, 1, 1, 1);
+
+        frameCachePathLabel = new QLabel(gridLayoutWidget_6);
+        frameCachePathLabel->setObjectName(QStringLiteral("frameCachePathLabel"));
+
+        gridLayout_6->addWidget(frameCachePathLabel, 5, 0, 1, 1);
+
+        frameCachePathLineEdit = new QLineEdit(gridLayoutWidget_6);
+        frameCachePathLineEdit->setObjectName(QStringLiteral("frameCachePathLineEdit"));
+
+        gridLayout_6->addWidget(frameCachePathLineEdit, 5, 1, 1, 1);
+
+        sceneTagLabel = new QLabel(gridLayoutWidget_6);
+        sceneTagLabel->setObjectName(QStringLiteral("sceneTagLabel"));
+
+        gridLayout_6->addWidget(sceneTagLabel, 6, 0, 1, 1);
+
+        sceneTagLineEdit = new QLineEdit(gridLayoutWidget_6);
+        sceneTagLineEdit->setObjectName(QStringLiteral("sceneTagLineEdit"));
+
+        gridLayout_6->addWidget(sceneTagLineEdit, 6, 1, 1, 1);
+
+        tabWidget->addTab(acquisitionTab, QString());
         GuiClass->setCentralWidget(centralWidget);
 
         retranslateUi(GuiClass);
@@ -438,6 +621,13 @@ public:
         sensitivityLabel->setText(QApplication::translate("GuiClass", "Detection sensitivity", Q_NULLPTR));
         maxTrackedLabel->setText(QApplication::translate("GuiClass", "Maximum tracked features", Q_NULLPTR));
         harrisThreshholdLabel->setText(QApplication::translate("GuiClass", "Harris response threshhold", Q_NULLPTR));
+        suppressionModeLabel->setText(QApplication::translate("GuiClass", "CPU suppression mode", Q_NULLPTR));
+        suppressionModeComboBox->clear();
+        suppressionModeComboBox->insertItems(0, QStringList()
+         << QApplication::translate("GuiClass", "Greedy", Q_NULLPTR)
+         << QApplication::translate("GuiClass", "Dense", Q_NULLPTR)
+        );
+        suppressionRangeLabel->setText(QApplication::translate("GuiClass", "CPU suppression range", Q_NULLPTR));
         progressGroupBox->setTitle(QApplication::translate("GuiClass", "Progress", Q_NULLPTR));
         label_7->setText(QApplication::translate("GuiClass", "CPU", Q_NULLPTR));
         label_11->setText(QApplication::translate("GuiClass", "GPU", Q_NULLPTR));
@@ -445,6 +635,8 @@ public:
         correlationThreshholdLabel->setText(QApplication::translate("GuiClass", "Correlation threshhold", Q_NULLPTR));
         templateUpdateFramesLabel->setText(QApplication::translate("GuiClass", "Template update frames", Q_NULLPTR));
         label_12->setText(QApplication::translate("GuiClass", "<html><head/><body><p>Template update<br/>maximum distance</p></body></html>", Q_NULLPTR));
+        threadsLabel->setText(QApplication::translate("GuiClass", "CPU tracking threads", Q_NULLPTR));
+        threadsSpinBox->setSpecialValueText(QApplication::translate("GuiClass", "Auto", Q_NULLPTR));
         groupBox->setTitle(QApplication::translate("GuiClass", "Controls", Q_NULLPTR));
         startButton->setText(QApplication::translate("GuiClass", "Start", Q_NULLPTR));
         stopButton->setText(QApplication::translate("GuiClass", "Stop", Q_NULLPTR));
@@ -462,6 +654,8 @@ public:
         label_2->setText(QApplication::translate("GuiClass", "Max Frame Time", Q_NULLPTR));
         label_3->setText(QApplication::translate("GuiClass", "Average Frame Time", Q_NULLPTR));
         cpuTotalProcessingTimeLabel->setText(QApplication::translate("GuiClass", "N/A", Q_NULLPTR));
+        label_13->setText(QApplication::translate("GuiClass", "Dropped Frames", Q_NULLPTR));
+        cpuDroppedFramesLabel->setText(QApplication::translate("GuiClass", "0", Q_NULLPTR));
         groupBox_4->setTitle(QApplication::translate("GuiClass", "GPU Stats", Q_NULLPTR));
         label_9->setText(QApplication::translate("GuiClass", "Average Frame Time", Q_NULLPTR));
         label_8->setText(QApplication::translate("GuiClass", "Max Frame Time", Q_NULLPTR));
@@ -471,7 +665,28 @@ public:
         gpuFramesProcessedLabel->setText(QApplication::translate("GuiClass", "0", Q_NULLPTR));
         label_6->setText(QApplication::translate("GuiClass", "Total Processing Time", Q_NULLPTR));
         gpuTotalProcessingTimeLabel->setText(QApplication::translate("GuiClass", "N/A", Q_NULLPTR));
+        label_14->setText(QApplication::translate("GuiClass", "Dropped Frames", Q_NULLPTR));
+        gpuDroppedFramesLabel->setText(QApplication::translate("GuiClass", "0", Q_NULLPTR));
         tabWidget->setTabText(tabWidget->indexOf(statisticsTab), QApplication::translate("GuiClass", "Statistics", Q_NULLPTR));
+        acquisitionSettingsGroupBox->setTitle(QApplication::translate("GuiClass", "Acquisition Settings", Q_NULLPTR));
+        framePolicyLabel->setText(QApplication::translate("GuiClass", "Frame policy", Q_NULLPTR));
+        framePolicyComboBox->clear();
+        framePolicyComboBox->insertItems(0, QStringList()
+         << QApplication::translate("GuiClass", "Block, track every frame", Q_NULLPTR)
+         << QApplication::translate("GuiClass", "Latest frame wins", Q_NULLPTR)
+        );
+        imageQueueBudgetLabel->setText(QApplication::translate("GuiClass", "Image queue budget", Q_NULLPTR));
+        imageQueueBudgetSpinBox->setSuffix(QApplication::translate("GuiClass", " MB", Q_NULLPTR));
+        panguServersLabel->setText(QApplication::translate("GuiClass", "PANGU servers", Q_NULLPTR));
+        panguServersLineEdit->setText(QApplication::translate("GuiClass", "localhost:10363", Q_NULLPTR));
+        panguServersLineEdit->setPlaceholderText(QApplication::translate("GuiClass", "host:port,host:port", Q_NULLPTR));
+        panguConnectionsLabel->setText(QApplication::translate("GuiClass", "Connections", Q_NULLPTR));
+        pipelineDepthLabel->setText(QApplication::translate("GuiClass", "Requests in flight per connection", Q_NULLPTR));
+        frameCachePathLabel->setText(QApplication::translate("GuiClass", "Frame cache file", Q_NULLPTR));
+        frameCachePathLineEdit->setPlaceholderText(QApplication::translate("GuiClass", "Empty to always render", Q_NULLPTR));
+        sceneTagLabel->setText(QApplication::translate("GuiClass", "Scene tag", Q_NULLPTR));
+        sceneTagLineEdit->setPlaceholderText(QApplication::translate("GuiClass", "Change when the PANGU scene changes", Q_NULLPTR));
+        tabWidget->setTabText(tabWidget->indexOf(acquisitionTab), QApplication::translate("GuiClass", "Acquisition", Q_NULLPTR));
     } // retranslateUi
 
 };
@@ -0,0 +1,246 @@
+#include <string.h>
+#ifdef _WIN32
+#include <Windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "frame_cache.hpp"
+
+static const char pack_magic[8] = {'P', 'G', 'U', 'C', 'A', 'C', 'H', '1'};
+
+struct PackEntryHeader {
+	unsigned long long key;
+	unsigned long long size;
+};
+
+static bool seek_file(FILE *file, long long offset, int origin) {
+#ifdef _MSC_VER
+	return _fseeki64(file, offset, origin) == 0;
+#else
+	return fseeko(file, offset, origin) == 0;
+#endif
+}
+
+static long long tell_file(FILE *file) {
+#ifdef _MSC_VER
+	return _ftelli64(file);
+#else
+	return ftello(file);
+#endif
+}
+
+/* Cut the file back to size bytes, anything still buffered is flushed first so it cannot land past the new end */
+static bool truncate_file(FILE *file, long long size) {
+	fflush(file);
+#ifdef _MSC_VER
+	return _chsize_s(_fileno(file), size) == 0;
+#else
+	return ftruncate(fileno(file), (off_t)size) == 0;
+#endif
+}
+
+FrameCache::FrameCache() :
+	mapping(nullptr),
+	mapping_size(0),
+	mapping_handle(nullptr),
+	file(nullptr),
+	num_hits(0),
+	num_misses(0)
+{
+	/* Empty */
+}
+
+FrameCache::~FrameCache() {
+	close();
+}
+
+bool FrameCache::open(const std::string &path) {
+	close();
+
+	file = fopen(path.c_str(), "r+b");
+	if(!file) {
+		file = fopen(path.c_str(), "w+b");
+		if(!file || fwrite(pack_magic, sizeof(pack_magic), 1, file) != 1) {
+			printf("Failed to create frame cache %s\n", path.c_str());
+			close();
+			return false;
+		}
+	}
+
+	char magic[sizeof(pack_magic)];
+	seek_file(file, 0, SEEK_END);
+	const long long file_size = tell_file(file);
+	seek_file(file, 0, SEEK_SET);
+	if(file_size < (long long)sizeof(pack_magic) || fread(magic, sizeof(magic), 1, file) != 1 || memcmp(magic, pack_magic, sizeof(magic)) != 0) {
+		printf("%s is not a frame cache\n", path.c_str());
+		close();
+		return false;
+	}
+
+	/* Index the pack. Without the mapping the entries cannot be found, and
+	appending after the magic would overwrite them, so the pack is refused */
+	size_t end = sizeof(pack_magic);
+	if(file_size > (long long)end) {
+		if(!map_file(path, (size_t)file_size)) {
+			printf("Failed to map frame cache %s\n", path.c_str());
+			close();
+			return false;
+		}
+
+		while(end + sizeof(PackEntryHeader) <= mapping_size) {
+			PackEntryHeader header;
+			memcpy(&header, mapping + end, sizeof(header));
+			if(header.size > mapping_size - end - sizeof(header)) {
+				break;
+			}
+
+			Entry entry;
+			entry.offset = end + sizeof(header);
+			entry.size = (size_t)header.size;
+			if(entries.emplace(header.key, entry).second) {
+				order.push_back(header.key);
+			}
+			end = entry.offset + entry.size;
+		}
+	}
+
+	/* An entry cut short by a crash is cut off the pack, otherwise a shorter
+	write over it would leave its tail to be indexed as entries next time.
+	Windows cannot shrink a mapped file, so the mapping is remade after */
+	if((long long)end < file_size) {
+		unmap_file();
+		if(!truncate_file(file, end) || (end > sizeof(pack_magic) && !map_file(path, end))) {
+			printf("Failed to remove a partial entry from frame cache %s\n", path.c_str());
+			close();
+			return false;
+		}
+	}
+
+	seek_file(file, end, SEEK_SET);
+	num_hits = 0;
+	num_misses = 0;
+	return true;
+}
+
+void FrameCache::close() {
+	unmap_file();
+	entries.clear();
+	order.clear();
+	written.clear();
+
+	if(file) {
+		fclose(file);
+		file = nullptr;
+	}
+}
+
+const uchar * FrameCache::find(unsigned long long key, size_t &size) {
+	std::unordered_map<unsigned long long, Entry>::const_iterator entry = entries.find(key);
+	if(entry == entries.end()) {
+		++num_misses;
+		return nullptr;
+	}
+
+	++num_hits;
+	size = entry->second.size;
+	return mapping + entry->second.offset;
+}
+
+void FrameCache::write(unsigned long long key, const uchar *data, size_t size) {
+	std::lock_guard<std::mutex> guard(write_lock);
+	if(!file || entries.count(key) || !written.insert(key).second) {
+		return;
+	}
+
+	PackEntryHeader header;
+	header.key = key;
+	header.size = size;
+	const long long position = tell_file(file);
+	if(fwrite(&header, sizeof(header), 1, file) != 1 || fwrite(data, 1, size, file) != size) {
+		/* Drop the partial entry so the next write replaces it, otherwise
+		open() stops indexing at it and every later entry is lost */
+		printf("Failed to write to the frame cache\n");
+		truncate_file(file, position);
+		seek_file(file, position, SEEK_SET);
+		written.erase(key);
+	}
+}
+
+unsigned long long FrameCache::hash(const void *data, size_t size, unsigned long long seed) {
+	const uchar *bytes = (const uchar *)data;
+	for(size_t i=0; i<size; ++i) {
+		seed = (seed ^ bytes[i]) * 1099511628211ULL;
+	}
+	return seed;
+}
+
+unsigned long long FrameCache::image_key(
+	const double *viewpoint,
+	ulong width, ulong height,
+	double horizontal_fov, double vertical_fov,
+	const std::string &scene_tag)
+{
+	const double camera[4] = {(double)width, (double)height, horizontal_fov, vertical_fov};
+
+	unsigned long long key = hash(viewpoint, 6 * sizeof(double));
+	key = hash(camera, sizeof(camera), key);
+	return hash(scene_tag.data(), scene_tag.size(), key);
+}
+
+bool FrameCache::map_file(const std::string &path, size_t size) {
+#ifdef _WIN32
+	/* Shared for writing, new entries are appended through file while mapped */
+	HANDLE handle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if(handle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	/* The mapping keeps the file open */
+	HANDLE file_mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(handle);
+	if(!file_mapping) {
+		return false;
+	}
+
+	mapping = (const uchar *)MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, size);
+	if(!mapping) {
+		CloseHandle(file_mapping);
+		return false;
+	}
+	mapping_handle = file_mapping;
+#else
+	const int fd = ::open(path.c_str(), O_RDONLY);
+	if(fd < 0) {
+		return false;
+	}
+
+	void *view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if(view == MAP_FAILED) {
+		return false;
+	}
+	mapping = (const uchar *)view;
+#endif
+	mapping_size = size;
+	return true;
+}
+
+void FrameCache::unmap_file() {
+	if(!mapping) {
+		return;
+	}
+
+#ifdef _WIN32
+	UnmapViewOfFile(mapping);
+	CloseHandle((HANDLE)mapping_handle);
+	mapping_handle = nullptr;
+#else
+	munmap((void *)mapping, mapping_size);
+#endif
+	mapping = nullptr;
+	mapping_size = 0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+#ifndef FRAME_CACHE_HPP
+#define FRAME_CACHE_HPP
+
+#include <atomic>
+#include <mutex>
+#include <stdio.h>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Utils/types.hpp"
+
+/* Rendered images kept on disk under a content key, so a flight which has
+been rendered once can be replayed without PANGU. Every image is appended
+to one pack file as a key and payload size followed by the payload. The
+pack is memory mapped when opened and hits are read straight out of the
+mapping. Images written while the pack is open go to the end of the file
+and can be found the next time it is opened */
+class FrameCache {
+public:
+	const static unsigned long long hash_seed = 14695981039346656037ULL;
+
+	FrameCache();
+	~FrameCache();
+
+	/* Open the pack at path, creating it if needed. Returns false if the
+	file cannot be created or is not a pack */
+	bool open(const std::string &path);
+	void close();
+	bool is_open() const { return file != nullptr; }
+
+	/* Payload cached under key, or nullptr. The pointer is into the mapping
+	and stays valid until close() */
+	const uchar * find(unsigned long long key, size_t &size);
+	/* Append a payload, keys which are already cached are ignored. A failed
+	write is cut back off the pack. Safe to call from several threads */
+	void write(unsigned long long key, const uchar *data, size_t size);
+	/* Keys of the entries found when the pack was opened, in the order they
+	were written, so a recorded flight can be replayed without its viewpoints */
+	const std::vector<unsigned long long> &keys() const { return order; }
+
+	ulong hits() const { return num_hits; }
+	ulong misses() const { return num_misses; }
+
+	/* 64 bit FNV-1a, pass the previous result as seed to hash several fields into one key */
+	static unsigned long long hash(const void *data, size_t size, unsigned long long seed = hash_seed);
+	/* Key of the image rendered from viewpoint (x, y, z, yaw, pitch, roll) by a camera of the given size and field of view */
+	static unsigned long long image_key(
+		const double *viewpoint,
+		ulong width, ulong height,
+		double horizontal_fov, double vertical_fov,
+		const std::string &scene_tag);
+
+private:
+	struct Entry {
+		size_t offset;
+		size_t size;
+	};
+
+	/* Only changed by open() and close(), so lookups need no lock */
+	std::unordered_map<unsigned long long, Entry> entries;
+	std::vector<unsigned long long> order;
+	const uchar *mapping;
+	size_t mapping_size;
+	void *mapping_handle;
+
+	std::mutex write_lock;
+	std::unordered_set<unsigned long long> written;
+	FILE *file;
+
+	std::atomic<ulong> num_hits;
+	std::atomic<ulong> num_misses;
+
+	bool map_file(const std::string &path, size_t size);
+	void unmap_file();
+};
+
+#endif /* FRAME_CACHE_HPP */
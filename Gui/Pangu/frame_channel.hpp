@@ -0,0 +1,197 @@
+#pragma once
+#ifndef FRAME_CHANNEL_HPP
+#define FRAME_CHANNEL_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "Utils/types.hpp"
+
+/* What a frame producer does when its consumer falls behind */
+enum FramePolicy {
+	/* Wait for room, every frame is delivered */
+	FRAME_POLICY_BLOCK,
+	/* Drop the oldest undelivered frames, the consumer always gets the newest */
+	FRAME_POLICY_LATEST
+};
+
+struct FrameChannelStats {
+	/* Time push() spent waiting for room, the consumer is the bottleneck */
+	double producer_blocked_ms;
+	/* Time pop() spent waiting for a frame, the producer is the bottleneck */
+	double consumer_starved_ms;
+	ulong frames;
+	/* Frames discarded by push_latest() before being delivered */
+	ulong dropped;
+
+	FrameChannelStats() {
+		producer_blocked_ms = 0;
+		consumer_starved_ms = 0;
+		frames = 0;
+		dropped = 0;
+	}
+};
+
+/* Bounded blocking queue between one frame producer and one consumer. Every
+item has a cost, 1 to bound the channel by count or the size of the frame to
+bound it by bytes, and the channel holds items while their total cost is
+within capacity. An item is always accepted into an empty channel, so one
+larger than capacity cannot stall the producer. Both sides sleep on a
+condition variable and are woken as soon as the other side makes a frame or
+room available. Closing the channel wakes both sides, push() then fails and
+pop() returns the frames left before failing. Items are kept in a ring
+allocated when the channel is created or reset, so passing a frame through
+the channel never allocates */
+template<typename T>
+class FrameChannel {
+public:
+	/* See reset() */
+	FrameChannel(size_t capacity, size_t max_items = 0) :
+		closed(false)
+	{
+		resize(capacity, max_items);
+	}
+
+	/* Reopen an empty channel with a new capacity and clear its statistics.
+	The channel holds no more than max_items at once, 0 for a channel bounded
+	by count holds up to capacity items */
+	void reset(size_t capacity, size_t max_items = 0) {
+		std::lock_guard<std::mutex> guard(lock);
+		resize(capacity, max_items);
+		closed = false;
+		stats = FrameChannelStats();
+	}
+
+	/* Wait for room and add item, returns false if the channel was closed */
+	bool push(const T &item, size_t cost = 1) {
+		std::unique_lock<std::mutex> guard(lock);
+		if(!closed && !has_room(cost)) {
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			space_available.wait(guard, [&] { return closed || has_room(cost); });
+			stats.producer_blocked_ms += elapsed_ms(start);
+		}
+
+		return add(item, cost);
+	}
+
+	/* Add item without waiting, making room by removing the oldest items into
+	dropped for the caller to release. Returns false if the channel was closed */
+	bool push_latest(const T &item, size_t cost, std::vector<T> &dropped) {
+		std::lock_guard<std::mutex> guard(lock);
+		while(!closed && !has_room(cost)) {
+			dropped.push_back(items[head].first);
+			used -= items[head].second;
+			head = (head + 1) % items.size();
+			--count;
+			++stats.dropped;
+		}
+
+		return add(item, cost);
+	}
+
+	/* Wait for room if policy is FRAME_POLICY_BLOCK, otherwise push_latest() */
+	bool push(FramePolicy policy, const T &item, size_t cost, std::vector<T> &dropped) {
+		if(policy == FRAME_POLICY_LATEST) {
+			return push_latest(item, cost, dropped);
+		}
+		return push(item, cost);
+	}
+
+	/* Wait up to ms for an item, returns false on timeout or once closed and empty */
+	bool pop(T &item, uint ms) {
+		std::unique_lock<std::mutex> guard(lock);
+		if(!closed && count == 0) {
+			const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			frame_available.wait_for(guard, std::chrono::milliseconds(ms), [this] { return closed || count > 0; });
+			stats.consumer_starved_ms += elapsed_ms(start);
+		}
+
+		return take(item);
+	}
+
+	bool try_pop(T &item) {
+		std::lock_guard<std::mutex> guard(lock);
+		return take(item);
+	}
+
+	void close() {
+		std::lock_guard<std::mutex> guard(lock);
+		closed = true;
+		space_available.notify_all();
+		frame_available.notify_all();
+	}
+
+	size_t size() const {
+		std::lock_guard<std::mutex> guard(lock);
+		return count;
+	}
+
+	FrameChannelStats statistics() const {
+		std::lock_guard<std::mutex> guard(lock);
+		return stats;
+	}
+
+private:
+	mutable std::mutex lock;
+	std::condition_variable space_available;
+	std::condition_variable frame_available;
+	/* Ring of items along with their cost, count of them from head */
+	std::vector<std::pair<T, size_t>> items;
+	size_t head;
+	size_t count;
+	size_t capacity;
+	size_t used;
+	bool closed;
+	FrameChannelStats stats;
+
+	/* Called with lock held */
+	void resize(size_t capacity, size_t max_items) {
+		this->capacity = capacity > 0 ? capacity : 1;
+		items.assign(max_items > 0 ? max_items : this->capacity, std::pair<T, size_t>());
+		head = 0;
+		count = 0;
+		used = 0;
+	}
+
+	/* Called with lock held */
+	bool has_room(size_t cost) const {
+		return count == 0 || (count < items.size() && used + cost <= capacity);
+	}
+
+	/* Called with lock held */
+	bool add(const T &item, size_t cost) {
+		if(closed) {
+			return false;
+		}
+
+		items[(head + count) % items.size()] = std::make_pair(item, cost);
+		++count;
+		used += cost;
+		++stats.frames;
+		frame_available.notify_one();
+		return true;
+	}
+
+	/* Called with lock held */
+	bool take(T &item) {
+		if(count == 0) {
+			return false;
+		}
+
+		item = items[head].first;
+		used -= items[head].second;
+		head = (head + 1) % items.size();
+		--count;
+		space_available.notify_one();
+		return true;
+	}
+
+	static double elapsed_ms(std::chrono::steady_clock::time_point start) {
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+#endif /* FRAME_CHANNEL_HPP */
@@ -0,0 +1,146 @@
+#include "frame_distributor.hpp"
+
+FrameDistributor::WorkerState::WorkerState(const Worker &worker, uint queue_size) :
+	worker(worker),
+	frames(queue_size),
+	finished(false)
+{
+	/* Empty */
+}
+
+FrameDistributor::FrameDistributor(PanguServer &pangu) :
+	pangu(pangu),
+	idle_frames(1),
+	exit(true)
+{
+	/* Empty */
+}
+
+FrameDistributor::~FrameDistributor() {
+	stop();
+}
+
+uint FrameDistributor::add_worker(const Worker &worker) {
+	workers.emplace_back(new WorkerState(worker, max_worker_queue_size));
+	return workers.size() - 1;
+}
+
+void FrameDistributor::start(uint max_frames) {
+	this->max_frames = max_frames;
+	exit = false;
+
+	const uint num_frames = max_held_images();
+	shared_frames.reset(new SharedFrame[num_frames]);
+	idle_frames.reset(num_frames);
+	for(uint i=0; i<num_frames; ++i) {
+		idle_frames.push(&shared_frames[i]);
+	}
+
+	for(uint i=0; i<workers.size(); ++i) {
+		workers[i]->finished = false;
+		workers[i]->frames.reset(max_worker_queue_size);
+		workers[i]->thread = std::thread(&FrameDistributor::run_worker, this, i);
+	}
+	distribute_thread = std::thread(&FrameDistributor::distribute_frames, this);
+}
+
+void FrameDistributor::join() {
+	if(distribute_thread.joinable()) {
+		distribute_thread.join();
+	}
+
+	for(uint i=0; i<workers.size(); ++i) {
+		if(workers[i]->thread.joinable()) {
+			workers[i]->thread.join();
+		}
+		/* A worker which returned early may have been handed frames after it drained its queue */
+		drain_worker(i);
+	}
+}
+
+void FrameDistributor::stop() {
+	exit = true;
+	/* Wake the distributor if it is waiting on a full queue or for an idle frame */
+	idle_frames.close();
+	for(uint i=0; i<workers.size(); ++i) {
+		workers[i]->frames.close();
+	}
+	join();
+}
+
+SharedFrame * FrameDistributor::get_frame(uint worker_idx, uint ms) {
+	SharedFrame *frame = nullptr;
+	workers[worker_idx]->frames.pop(frame, ms);
+	return frame;
+}
+
+void FrameDistributor::release_frame(SharedFrame *frame) {
+	if(frame->references.fetch_sub(1) == 1) {
+		pangu.release_image(frame->image);
+		idle_frames.push(frame);
+	}
+}
+
+FrameChannelStats FrameDistributor::worker_stats(uint worker_idx) const {
+	return workers[worker_idx]->frames.statistics();
+}
+
+void FrameDistributor::run_worker(uint worker_idx) {
+	workers[worker_idx]->worker(worker_idx);
+	workers[worker_idx]->finished = true;
+	/* Any further frames for this worker are released by the distributor */
+	workers[worker_idx]->frames.close();
+	drain_worker(worker_idx);
+}
+
+void FrameDistributor::drain_worker(uint worker_idx) {
+	SharedFrame *frame = nullptr;
+	while(workers[worker_idx]->frames.try_pop(frame)) {
+		release_frame(frame);
+	}
+}
+
+void FrameDistributor::distribute_frames() {
+	const uint num_workers = workers.size();
+
+	for(uint frame_count=0; frame_count<max_frames && !exit; ++frame_count) {
+		/* Stop taking frames once every worker has returned */
+		bool workers_running = false;
+		for(uint i=0; i<num_workers; ++i) {
+			workers_running |= !workers[i]->finished;
+		}
+		if(!workers_running) {
+			break;
+		}
+
+		/* Waits only if a worker holds more frames than max_held_images() allows for */
+		SharedFrame *frame = nullptr;
+		if(!idle_frames.pop(frame, frame_timeout_ms)) {
+			break;
+		}
+
+		const PanguFrame image = pangu.get_image(frame_timeout_ms);
+		if(!image.image) {
+			idle_frames.push(frame);
+			break;
+		}
+
+		frame->image = image.image;
+		frame->frame_idx = image.step_idx;
+		frame->dropped = image.dropped;
+		frame->references = num_workers;
+
+		for(uint i=0; i<num_workers; ++i) {
+			/* Waits for a worker whose queue is full rather than buffering the
+			flight for it, fails once the worker has returned */
+			if(exit || !workers[i]->frames.push(frame)) {
+				release_frame(frame);
+			}
+		}
+	}
+
+	/* Workers see the end of the flight once their queue is empty */
+	for(uint i=0; i<num_workers; ++i) {
+		workers[i]->frames.close();
+	}
+}
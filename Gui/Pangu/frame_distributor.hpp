@@ -0,0 +1,93 @@
+#pragma once
+#ifndef FRAME_DISTRIBUTOR_HPP
+#define FRAME_DISTRIBUTOR_HPP
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Pangu/frame_channel.hpp"
+#include "Pangu/pangu_server.hpp"
+#include "Utils/types.hpp"
+
+/* A frame from PANGU shared by every worker of a FrameDistributor. The
+image goes back to the server's pool and the frame to the distributor's idle
+frames when the last worker releases it */
+struct SharedFrame {
+	uchar *image;
+	/* Flight step of the image and the frames dropped by the server just
+	before it, see PanguServer::frame_policy */
+	uint frame_idx;
+	uint dropped;
+	std::atomic<uint> references;
+};
+
+/* Takes each frame from a PanguServer once and hands it to any number of
+workers, each running on its own thread. A worker is typically one tracking
+engine, so engines can be compared on the same frames at the same time
+without the flight being rendered once per engine */
+class FrameDistributor {
+public:
+	typedef std::function<void(uint worker_idx)> Worker;
+
+	/* Frames buffered per worker, a real-time run under FRAME_POLICY_LATEST
+	keeps this small so a slow worker backs up into the server's queue where
+	stale frames are dropped */
+	uint max_worker_queue_size = 8;
+	uint frame_timeout_ms = 5000;
+
+	FrameDistributor(PanguServer &pangu);
+	~FrameDistributor();
+
+	/* Register a worker before start(), it is called on its own thread and
+	reads its frames with get_frame(worker_idx, ...) */
+	uint add_worker(const Worker &worker);
+
+	void start(uint max_frames);
+	/* Wait for the flight to end and every worker to return */
+	void join();
+	void stop();
+
+	/* Next frame for a worker, or nullptr once the flight has ended or no
+	frame arrived within ms. Every frame must be handed back with release_frame */
+	SharedFrame * get_frame(uint worker_idx, uint ms);
+	void release_frame(SharedFrame *frame);
+
+	/* Most server images held at once, a full queue for the slowest worker
+	plus the frame it is tracking and the frame being handed out. Set
+	PanguServer::max_consumer_images to this before starting the server */
+	uint max_held_images() const { return max_worker_queue_size + 2; }
+
+	/* Time the distributor waited on a worker's full queue and the worker
+	waited on its empty queue */
+	FrameChannelStats worker_stats(uint worker_idx) const;
+
+private:
+	struct WorkerState {
+		Worker worker;
+		FrameChannel<SharedFrame *> frames;
+		std::thread thread;
+		std::atomic<bool> finished;
+
+		WorkerState(const Worker &worker, uint queue_size);
+	};
+
+	PanguServer &pangu;
+	std::vector<std::unique_ptr<WorkerState>> workers;
+	/* max_held_images() frames allocated by start(), the ones not handed out
+	wait in idle_frames so no frame is allocated during the flight */
+	std::unique_ptr<SharedFrame[]> shared_frames;
+	FrameChannel<SharedFrame *> idle_frames;
+	std::thread distribute_thread;
+	std::atomic<bool> exit;
+
+	uint max_frames = 0;
+
+	void distribute_frames();
+	void run_worker(uint worker_idx);
+	void drain_worker(uint worker_idx);
+};
+
+#endif /* FRAME_DISTRIBUTOR_HPP */
@@ -0,0 +1,97 @@
+#include <stdlib.h>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
+
+#include "frame_pool.hpp"
+
+static uchar * alloc_pages(size_t size) {
+#ifdef _MSC_VER
+	return (uchar *)_aligned_malloc(size, FramePool::page_size);
+#else
+	void *buffer = nullptr;
+	return posix_memalign(&buffer, FramePool::page_size, size) == 0 ? (uchar *)buffer : nullptr;
+#endif
+}
+
+static void free_pages(uchar *buffer) {
+#ifdef _MSC_VER
+	_aligned_free(buffer);
+#else
+	free(buffer);
+#endif
+}
+
+FramePool::FramePool() :
+	size(0),
+	num_buffers(0),
+	closed(true)
+{
+	/* Empty */
+}
+
+FramePool::~FramePool() {
+	free_idle_buffers();
+}
+
+void FramePool::reset(size_t buffer_size, uint num_buffers) {
+	std::lock_guard<std::mutex> guard(lock);
+	free_idle_buffers();
+
+	/* Round up to whole pages */
+	size = ((buffer_size + page_size - 1) / page_size) * page_size;
+	idle_buffers.reserve(num_buffers);
+	for(uint i=0; i<num_buffers; ++i) {
+		uchar *buffer = alloc_pages(size);
+		if(buffer) {
+			idle_buffers.push_back(buffer);
+		}
+	}
+	this->num_buffers = idle_buffers.size();
+	closed = false;
+}
+
+uchar * FramePool::acquire() {
+	std::unique_lock<std::mutex> guard(lock);
+	buffer_released.wait(guard, [this] { return closed || !idle_buffers.empty(); });
+	if(idle_buffers.empty()) {
+		return nullptr;
+	}
+
+	uchar *buffer = idle_buffers.back();
+	idle_buffers.pop_back();
+	return buffer;
+}
+
+void FramePool::release(uchar *buffer) {
+	if(!buffer) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(lock);
+	idle_buffers.push_back(buffer);
+	buffer_released.notify_one();
+}
+
+void FramePool::close() {
+	std::lock_guard<std::mutex> guard(lock);
+	closed = true;
+	buffer_released.notify_all();
+}
+
+size_t FramePool::buffer_size() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return size;
+}
+
+uint FramePool::capacity() const {
+	std::lock_guard<std::mutex> guard(lock);
+	return num_buffers;
+}
+
+void FramePool::free_idle_buffers() {
+	for(size_t i=0; i<idle_buffers.size(); ++i) {
+		free_pages(idle_buffers[i]);
+	}
+	idle_buffers.clear();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#ifndef FRAME_POOL_HPP
+#define FRAME_POOL_HPP
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "Utils/types.hpp"
+
+/* A fixed number of reusable page aligned buffers for received frames. Every
+buffer is allocated by reset, so no frame causes an allocation and memory
+stays bounded however far the consumer falls behind. acquire() waits for a
+buffer to be released when all of them are in use. Closing the pool wakes
+any waiting acquire(), which then fails unless a buffer is idle */
+class FramePool {
+public:
+	const static size_t page_size = 4096;
+
+	FramePool();
+	~FramePool();
+
+	/* Free every idle buffer and allocate num_buffers new ones of buffer_size
+	bytes, reopening a closed pool. All buffers must have been released first */
+	void reset(size_t buffer_size, uint num_buffers);
+
+	/* Wait for an idle buffer, returns nullptr once the pool is closed and none is idle */
+	uchar * acquire();
+	void release(uchar *buffer);
+	void close();
+
+	size_t buffer_size() const;
+	/* Buffers allocated by the last reset */
+	uint capacity() const;
+
+private:
+	mutable std::mutex lock;
+	std::condition_variable buffer_released;
+	std::vector<uchar *> idle_buffers;
+	size_t size;
+	uint num_buffers;
+	bool closed;
+
+	void free_idle_buffers();
+};
+
+#endif /* FRAME_POOL_HPP */
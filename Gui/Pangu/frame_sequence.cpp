@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <ctype.h>
+#include <fstream>
+#include <iterator>
+#include <stdio.h>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dirent.h>
+#endif
+
+#include "frame_sequence.hpp"
+#include "frame_cache.hpp"
+
+/* Skips whitespace and # comments between the fields of a PGM header */
+static bool read_pgm_field(const uchar *data, size_t size, size_t &offset, ulong &value) {
+	while(offset < size && (isspace(data[offset]) || data[offset] == '#')) {
+		if(data[offset] == '#') {
+			while(offset < size && data[offset] != '\n') {
+				++offset;
+			}
+		} else {
+			++offset;
+		}
+	}
+
+	if(offset >= size || !isdigit(data[offset])) {
+		return false;
+	}
+	value = 0;
+	while(offset < size && isdigit(data[offset])) {
+		value = value * 10 + (data[offset++] - '0');
+	}
+	return true;
+}
+
+bool parse_pgm_header(const uchar *data, size_t size, ulong &width, ulong &height, size_t &offset) {
+	ulong max_value;
+	offset = 2;
+	if(size < 2 || data[0] != 'P' || data[1] != '5'
+		|| !read_pgm_field(data, size, offset, width)
+		|| !read_pgm_field(data, size, offset, height)
+		|| !read_pgm_field(data, size, offset, max_value)
+		|| max_value != 255 || offset >= size || !isspace(data[offset]))
+	{
+		return false;
+	}
+
+	/* A single whitespace character separates the header from the pixels */
+	++offset;
+	return true;
+}
+
+static std::vector<std::string> list_frame_files(const std::string &directory) {
+	std::vector<std::string> files;
+#ifdef _WIN32
+	WIN32_FIND_DATAA find_data;
+	HANDLE find = FindFirstFileA((directory + "\\*.pgm").c_str(), &find_data);
+	if(find != INVALID_HANDLE_VALUE) {
+		do {
+			files.push_back(directory + "\\" + find_data.cFileName);
+		} while(FindNextFileA(find, &find_data));
+		FindClose(find);
+	}
+#else
+	DIR *dir = opendir(directory.c_str());
+	if(dir) {
+		while(struct dirent *entry = readdir(dir)) {
+			const std::string name = entry->d_name;
+			if(name.size() > 4 && name.compare(name.size() - 4, 4, ".pgm") == 0) {
+				files.push_back(directory + "/" + name);
+			}
+		}
+		closedir(dir);
+	}
+#endif
+
+	/* Tracked in name order, so number the frames of a recorded flight */
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+static bool add_frame(
+	const uchar *data, size_t size, const std::string &name,
+	uint cols, uint rows,
+	std::vector<std::vector<uchar>> &frames)
+{
+	ulong width = 0;
+	ulong height = 0;
+	size_t offset = 0;
+	if(!parse_pgm_header(data, size, width, height, offset)) {
+		fprintf(stderr, "%s does not hold binary PGM images\n", name.c_str());
+		return false;
+	}
+	if(width != cols || height != rows || size - offset < (size_t)width * height) {
+		fprintf(stderr, "%s holds a %lux%lu image, the engines track %ux%u images\n", name.c_str(), width, height, cols, rows);
+		return false;
+	}
+
+	frames.push_back(std::vector<uchar>(data + offset, data + offset + width * height));
+	return true;
+}
+
+bool load_frame_sequence(
+	const std::string &frame_directory, const std::string &pack_path,
+	uint cols, uint rows,
+	std::vector<std::vector<uchar>> &frames)
+{
+	if(!pack_path.empty()) {
+		FrameCache pack;
+		if(!pack.open(pack_path)) {
+			fprintf(stderr, "Failed to open %s\n", pack_path.c_str());
+			return false;
+		}
+
+		const std::vector<unsigned long long> &keys = pack.keys();
+		for(size_t i=0; i<keys.size(); ++i) {
+			size_t size = 0;
+			const uchar *data = pack.find(keys[i], size);
+			if(!add_frame(data, size, pack_path, cols, rows, frames)) {
+				return false;
+			}
+		}
+	} else if(!frame_directory.empty()) {
+		const std::vector<std::string> files = list_frame_files(frame_directory);
+		for(size_t i=0; i<files.size(); ++i) {
+			std::ifstream file(files[i], std::ios::binary);
+			const std::vector<uchar> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+			if(!add_frame(data.data(), data.size(), files[i], cols, rows, frames)) {
+				return false;
+			}
+		}
+	}
+
+	if(frames.empty()) {
+		fprintf(stderr, "No frames to track, give a PGM directory or a frame cache pack\n");
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#ifndef FRAME_SEQUENCE_HPP
+#define FRAME_SEQUENCE_HPP
+
+#include <string>
+#include <vector>
+
+#include "Utils/types.hpp"
+
+/* Load the frames of a recorded flight for the headless tools, either the
+binary PGM files of a directory in name order or every image of a frame
+cache pack in the order it was recorded. The pack is used when pack_path is
+given. Only the pixels are kept, as the Gui passes the engines image_offset
+bytes into PANGU's reply. Every image must be cols x rows. Returns false
+and prints the reason if nothing could be loaded or an image is unusable */
+bool load_frame_sequence(
+	const std::string &frame_directory, const std::string &pack_path,
+	uint cols, uint rows,
+	std::vector<std::vector<uchar>> &frames);
+
+/* Binary PGM header, offset is set to the first pixel */
+bool parse_pgm_header(const uchar *data, size_t size, ulong &width, ulong &height, size_t &offset);
+
+#endif /* FRAME_SEQUENCE_HPP */
@@ -69,6 +69,14 @@
  * These are the new split TX/RX interface functions. We recommend that
  * users use these if they want to use their own error handling functionality.
  * Otherwise the pan_protocol_* methods below can be used.
+ *
+ * Each pan_net_*_TX function is pan_net_*_request, which only sends the
+ * message, followed by pan_net_want for the reply code. The _request
+ * functions keep no state between calls so threads talking to different
+ * servers may use them at the same time. The TX functions return errors in
+ * the shared buffer of pan_net_want; threaded clients call the _request
+ * function and pan_net_want_r with a buffer of their own instead, as the
+ * PanguConnection class does.
  **************************************************************************/
 
 
@@ -169,9 +177,29 @@ pan_net_safety_checks(void)
  * to see if it matches the message type "t". If it doesn't and the message
  * type read is an error message then the error will be returned. Otherwise
  * an "unexpected message" error will be returned.
+ *
+ * The message is returned in a buffer shared by every caller so this is not
+ * safe to use from several threads; see pan_net_want_r().
  */
 char *
 pan_net_want(SOCKET s, unsigned long want)
+{
+	/* Declare buffer to store any error message. */
+	static char err_buf[1024];
+	const int err_buf_size = sizeof(err_buf)/sizeof(*err_buf);
+
+	return pan_net_want_r(s, want, err_buf, err_buf_size);
+}
+
+
+/*
+ * err = pan_net_want_r(s, t, buf, n) is pan_net_want(s, t) with any error
+ * message written to the caller's buffer "buf" of "n" bytes, which is
+ * returned. Threads with their own connections and buffers may call this
+ * at the same time.
+ */
+char *
+pan_net_want_r(SOCKET s, unsigned long want, char *err_buf, unsigned long err_buf_size)
 {
 	/* Get the reply code from the server */
 	unsigned long mcode;
@@ -180,10 +208,6 @@ pan_net_want(SOCKET s, unsigned long want)
 	/* If it is what we expect then return happy. */
 	if (mcode == want) return NULL;
 
-	/* Declare buffer to store any error message. */
-	static char err_buf[1024];
-	const int err_buf_size = sizeof(err_buf)/sizeof(*err_buf);
-
 	/* Deal with any incoming error messages */
 	if (mcode == MSG_ERROR)
 	{
@@ -193,8 +217,8 @@ pan_net_want(SOCKET s, unsigned long want)
 		pan_socket_read_long(s, &ecode);
 		pan_socket_read_string(s, &emsg);
 		/* Write the start of the message to buffer */
-		int count = 0;
-		(void)sprintf(err_buf, "Error from server: %n", &count);
+		(void)snprintf(err_buf, err_buf_size, "Error from server: ");
+		int count = strlen(err_buf);
 		/* Copy the error message to the buffer. Leaving space
 		   for newline and terminator characters. */
 		strncat(err_buf, emsg, err_buf_size - count - 2);
@@ -206,8 +230,7 @@ pan_net_want(SOCKET s, unsigned long want)
 	}
 
 	/* Unexpected message received */
-	int count = 0;
-	(void)sprintf(err_buf, "Error: received message type %ld when expecting message type %ld.\n%n", mcode, want, &count);
+	(void)snprintf(err_buf, err_buf_size, "Error: received message type %ld when expecting message type %ld.\n", mcode, want);
 	return err_buf;
 }
 
@@ -217,12 +240,17 @@ pan_net_want(SOCKET s, unsigned long want)
  *
  * pan_net_start_RX() is not required.
  */
-char *
-pan_net_start_TX(SOCKET s)
+void
+pan_net_start_request(SOCKET s)
 {
 	/* Send the version number of the protocol we wish to use (1.20) */
 	unsigned long vno = 0x114;
 	(void)pan_socket_write_ulong(s, vno);
+}
+char *
+pan_net_start_TX(SOCKET s)
+{
+	pan_net_start_request(s);
 
 	/* Want an Okay response */
 	return pan_net_want(s, MSG_OKAY);
@@ -255,11 +283,16 @@ pan_net_finish_TX(SOCKET s)
  *
  * IMPLEMENTS GetImage (1)
  */
-char *
-pan_net_get_image_TX(SOCKET s)
+void
+pan_net_get_image_request(SOCKET s)
 {
 	/* Send the empty GetImage message and want a MSG_IMAGE reply */
 	(void)pan_socket_write_ulong(s, MSG_GET_IMAGE);
+}
+char *
+pan_net_get_image_TX(SOCKET s)
+{
+	pan_net_get_image_request(s);
 	return pan_net_want(s, MSG_IMAGE);
 }
 unsigned char *
@@ -284,6 +317,40 @@ pan_net_get_image_RX(SOCKET s, unsigned long *psize)
 }
 
 
+/*
+ * ok = pan_net_get_image_RX_into(s, buf, cap, &size) receives the image
+ * from any MSG_IMAGE reply into the caller's buffer of "cap" bytes rather
+ * than one allocated by malloc(). The size field will be updated with the
+ * number of bytes in the image. If the image does not fit it is read and
+ * discarded, so the stream stays in step, and zero is returned.
+ */
+int
+pan_net_get_image_RX_into(SOCKET s, unsigned char *buffer, unsigned long capacity, unsigned long *psize)
+{
+	long fsize;
+
+	/* Read the size of the data in the message */
+	(void)pan_socket_read_long(s, &fsize);
+	if (psize) *psize = fsize;
+
+	if ((unsigned long)fsize > capacity)
+	{
+		char discard[4096];
+		while (fsize > 0)
+		{
+			long n = fsize < (long)sizeof(discard) ? fsize : (long)sizeof(discard);
+			(void)pan_socket_read(s, (void *)discard, n);
+			fsize -= n;
+		}
+		return 0;
+	}
+
+	/* Read the data directly into the caller's buffer */
+	(void)pan_socket_read(s, (void *)buffer, fsize);
+	return 1;
+}
+
+
 /*
  * err = pan_net_get_elevation_TX(s) requests the elevation of the
  * camera relative to the remote model.
@@ -296,11 +363,16 @@ pan_net_get_image_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS GetElevation (2)
  */
-char *
-pan_net_get_elevation_TX(SOCKET s)
+void
+pan_net_get_elevation_request(SOCKET s)
 {
 	/* Send the empty GetElevation message and want a MSG_FLOAT reply */
 	(void)pan_socket_write_ulong(s, MSG_GET_ELEVATION);
+}
+char *
+pan_net_get_elevation_TX(SOCKET s)
+{
+	pan_net_get_elevation_request(s);
 	return pan_net_want(s, MSG_FLOAT);
 }
 float
@@ -327,8 +399,8 @@ pan_net_get_elevation_RX(SOCKET s, char *perr)
  *
  * IMPLEMENTS GetElevations (3)
  */
-char *
-pan_net_get_elevations_TX(SOCKET s, unsigned long n, float *posv)
+void
+pan_net_get_elevations_request(SOCKET s, unsigned long n, float *posv)
 {
 	unsigned long i;
 
@@ -360,6 +432,11 @@ pan_net_get_elevations_TX(SOCKET s, unsigned long n, float *posv)
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
 	(void)free(buf); buf = 0;
+}
+char *
+pan_net_get_elevations_TX(SOCKET s, unsigned long n, float *posv)
+{
+	pan_net_get_elevations_request(s, n, posv);
 
 	/* We want a MSG_FLOAT_ARRAY reply */
 	return pan_net_want(s, MSG_FLOAT_ARRAY);
@@ -394,15 +471,15 @@ pan_net_get_elevations_RX(SOCKET s, float *resultv, char *errorv)
  *
  * IMPLEMENTS LookupPoint (4)
  */
-char *
-pan_net_lookup_point_TX(SOCKET s, float x, float y)
+void
+pan_net_lookup_point_request(SOCKET s, float x, float y)
 {
 	/*
 	 * Send the LookupPoint message with parameters (x, y) and want
 	 * a MSG_3D_POINT reply. We're sending one ulong and two floats.
 	 */
 	const int bufsize = 1*4 + 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -415,6 +492,11 @@ pan_net_lookup_point_TX(SOCKET s, float x, float y)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_lookup_point_TX(SOCKET s, float x, float y)
+{
+	pan_net_lookup_point_request(s, x, y);
 	return pan_net_want(s, MSG_3D_POINT);
 }
 void
@@ -442,8 +524,8 @@ pan_net_lookup_point_RX(SOCKET s, float *px, float *py, float *pz, char *perr)
  *
  * IMPLEMENTS LookupPoints (5)
  */
-char *
-pan_net_lookup_points_TX(SOCKET s, unsigned long n, float *posv)
+void
+pan_net_lookup_points_request(SOCKET s, unsigned long n, float *posv)
 {
 	unsigned long i;
 
@@ -474,6 +556,11 @@ pan_net_lookup_points_TX(SOCKET s, unsigned long n, float *posv)
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
 	(void)free(buf); buf = 0;
+}
+char *
+pan_net_lookup_points_TX(SOCKET s, unsigned long n, float *posv)
+{
+	pan_net_lookup_points_request(s, n, posv);
 
 	/* We want a MSG_3D_POINT_ARRAY reply */
 	return pan_net_want(s, MSG_3D_POINT_ARRAY);
@@ -509,15 +596,15 @@ pan_net_lookup_points_RX(SOCKET s, float *resultv, char *errorv)
  *
  * IMPLEMENTS GetPoint (6)
  */
-char *
-pan_net_get_point_TX(SOCKET s, float dx, float dy, float dz)
+void
+pan_net_get_point_request(SOCKET s, float dx, float dy, float dz)
 {
 	/*
 	 * Send the GetPoint message with parameters (dx, dy, dz) and expect
 	 * a MSG_3D_POINT reply. We're sending one ulong and three floats.
 	 */
 	const int bufsize = 1*4 + 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -531,6 +618,11 @@ pan_net_get_point_TX(SOCKET s, float dx, float dy, float dz)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_point_TX(SOCKET s, float dx, float dy, float dz)
+{
+	pan_net_get_point_request(s, dx, dy, dz);
 	return pan_net_want(s, MSG_3D_POINT);
 }
 void
@@ -557,8 +649,8 @@ pan_net_get_point_RX(SOCKET s, float *px, float *py, float *pz, char *perr)
  *
  * IMPLEMENTS GetPoints (7)
  */
-char *
-pan_net_get_points_TX(SOCKET s, unsigned long n, float *posv)
+void
+pan_net_get_points_request(SOCKET s, unsigned long n, float *posv)
 {
 	unsigned long i;
 
@@ -590,6 +682,11 @@ pan_net_get_points_TX(SOCKET s, unsigned long n, float *posv)
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
 	(void)free(buf); buf = 0;
+}
+char *
+pan_net_get_points_TX(SOCKET s, unsigned long n, float *posv)
+{
+	pan_net_get_points_request(s, n, posv);
 
 	/* We want a MSG_3D_POINT_ARRAY reply */
 	return pan_net_want(s, MSG_3D_POINT_ARRAY);
@@ -623,9 +720,8 @@ pan_net_get_points_RX(SOCKET s, float *resultv, char *errorv)
  *
  * IMPLEMENTS Echo (8)
  */
-char *
-pan_net_echo_TX
-(
+void
+pan_net_echo_request(
 	SOCKET s,
 	void *src,
 	unsigned long n
@@ -653,6 +749,15 @@ pan_net_echo_TX
 	(void)free(buf); buf = 0;
 
 	// Want an EchoReply
+}
+char *
+pan_net_echo_TX(
+	SOCKET s,
+	void *src,
+	unsigned long n
+)
+{
+	pan_net_echo_request(s, src, n);
 	return pan_net_want(s, MSG_ECHO_REPLY);
 }
 void *
@@ -698,15 +803,15 @@ pan_net_echo_RX
  *
  * IMPLEMENTS GetRangeImage (9)
  */
-char *
-pan_net_get_range_image_TX(SOCKET s, float offset, float scale)
+void
+pan_net_get_range_image_request(SOCKET s, float offset, float scale)
 {
 	/*
 	 * Send the GetRangeImage message, offset and scale.
 	 * We're sending one ulong and two floats.
 	 */
 	const int bufsize = 1*4 + 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -719,6 +824,11 @@ pan_net_get_range_image_TX(SOCKET s, float offset, float scale)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_range_image_TX(SOCKET s, float offset, float scale)
+{
+	pan_net_get_range_image_request(s, offset, scale);
 
 	/* Want a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -759,11 +869,16 @@ pan_net_get_range_image_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS GetRangeTexture (10)
  */
-char *
-pan_net_get_range_texture_TX(SOCKET s)
+void
+pan_net_get_range_texture_request(SOCKET s)
 {
 	/* Send empty GetRangeTexture message and want a MSG_IMAGE reply */
 	(void)pan_socket_write_ulong(s, MSG_GET_RANGE_TEXTURE);
+}
+char *
+pan_net_get_range_texture_TX(SOCKET s)
+{
+	pan_net_get_range_texture_request(s);
 	return pan_net_want(s, MSG_IMAGE);
 }
 unsigned char *
@@ -800,15 +915,15 @@ pan_net_get_range_texture_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS GetViewpointByDegreesS (11)
  */
-char *
-pan_net_get_viewpoint_by_degrees_s_TX(SOCKET s, float x, float y, float z, float yw, float pi, float rl)
+void
+pan_net_get_viewpoint_by_degrees_s_request(SOCKET s, float x, float y, float z, float yw, float pi, float rl)
 {
 	/*
 	 * Send the GetViewpointByDegrees message with parameters (x, y, z)
 	 * and (yw, pi, rl). We're sending one ulong and six floats.
 	 */
 	const int bufsize = 1*4 + 6*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -825,6 +940,11 @@ pan_net_get_viewpoint_by_degrees_s_TX(SOCKET s, float x, float y, float z, float
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_viewpoint_by_degrees_s_TX(SOCKET s, float x, float y, float z, float yw, float pi, float rl)
+{
+	pan_net_get_viewpoint_by_degrees_s_request(s, x, y, z, yw, pi, rl);
 
 	/* We want a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -864,15 +984,15 @@ pan_net_get_viewpoint_by_degrees_s_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS GetViewpointByQuaternionS (12)
  */
-char *
-pan_net_get_viewpoint_by_quaternion_s_TX(SOCKET s, float x, float y, float z, float q0, float q1, float q2, float q3)
+void
+pan_net_get_viewpoint_by_quaternion_s_request(SOCKET s, float x, float y, float z, float q0, float q1, float q2, float q3)
 {
 	/*
 	 * Send the GetViewpointByQuaternion message with parameters (x, y, z)
 	 * and (q0, q1, q2, q3). We're sending one ulong and seven floats.
 	 */
 	const int bufsize = 1*4 + 7*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -890,6 +1010,11 @@ pan_net_get_viewpoint_by_quaternion_s_TX(SOCKET s, float x, float y, float z, fl
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_viewpoint_by_quaternion_s_TX(SOCKET s, float x, float y, float z, float q0, float q1, float q2, float q3)
+{
+	pan_net_get_viewpoint_by_quaternion_s_request(s, x, y, z, q0, q1, q2, q3);
 
 	/* We expect a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -927,15 +1052,15 @@ pan_net_get_viewpoint_by_quaternion_s_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS GetLidarPulseResult (13)
  */
-char *
-pan_net_get_lidar_pulse_result_TX(SOCKET s, float x, float y, float z, float dx, float dy, float dz)
+void
+pan_net_get_lidar_pulse_result_request(SOCKET s, float x, float y, float z, float dx, float dy, float dz)
 {
 	/*
 	 * Send the GetLidarPulseResult message with parameters (x, y, z)
 	 * and (dx, dy, dz). We're sending one ulong and six floats.
 	 */
 	const int bufsize = 1*4 + 6*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -952,6 +1077,11 @@ pan_net_get_lidar_pulse_result_TX(SOCKET s, float x, float y, float z, float dx,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_lidar_pulse_result_TX(SOCKET s, float x, float y, float z, float dx, float dy, float dz)
+{
+	pan_net_get_lidar_pulse_result_request(s, x, y, z, dx, dy, dz);
 
 	/* We want a MSG_LIDAR_PULSE_RESULT reply */
 	return pan_net_want(s, MSG_LIDAR_PULSE_RESULT);
@@ -983,8 +1113,8 @@ pan_net_get_lidar_pulse_result_RX(SOCKET s, float *pr, float *pa)
  *
  * IMPLEMENTS GetLidarMeasurement (14)
  */
-char *
-pan_net_get_lidar_measurement_TX(SOCKET s,
+void
+pan_net_get_lidar_measurement_request(SOCKET s,
 	float px, float py, float pz,
 	float q0, float q1, float q2, float q3,
 	float vx, float vy, float vz,
@@ -999,7 +1129,7 @@ pan_net_get_lidar_measurement_TX(SOCKET s,
 	 * We're sending one ulong and 25 floats.
 	 */
 	const int bufsize = 1*4 + 25*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1035,6 +1165,20 @@ pan_net_get_lidar_measurement_TX(SOCKET s,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_lidar_measurement_TX(SOCKET s,
+	float px, float py, float pz,
+	float q0, float q1, float q2, float q3,
+	float vx, float vy, float vz,
+	float rx, float ry, float rz,
+	float ax, float ay, float az,
+	float sx, float sy, float sz,
+	float jx, float jy, float jz,
+	float tx, float ty, float tz)
+{
+	pan_net_get_lidar_measurement_request(s, px, py, pz, q0, q1, q2, q3, vx, vy,
+			vz, rx, ry, rz, ax, ay, az, sx, sy, sz, jx, jy, jz, tx, ty, tz);
 
 	/* We want a MSG_LIDAR_MEASUREMENT reply */
 	return pan_net_want(s, MSG_LIDAR_MEASUREMENT);
@@ -1200,9 +1344,8 @@ pan_net_get_lidar_measurement_RX(SOCKET s,
  *
  * IMPLEMENTS GetRadarResponse (15)
  */
-char *
-pan_net_get_radar_response_TX
-(
+void
+pan_net_get_radar_response_request(
 	SOCKET s,
 	unsigned long flags,
 	unsigned long n,
@@ -1222,7 +1365,7 @@ pan_net_get_radar_response_TX
 	 * We're sending five ulongs, fifteen floats and 13 ulong pads.
 	 */
 	const int bufsize = 5*4 + 15*4 + 13*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1253,6 +1396,23 @@ pan_net_get_radar_response_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_radar_response_TX(
+	SOCKET s,
+	unsigned long flags,
+	unsigned long n,
+	unsigned long nr, unsigned long ns,
+	float ox, float oy, float oz,
+	float vx, float vy, float vz,
+	float q0, float q1, float q2, float q3,
+	float bwidth,
+	float rmid, float smid, // Ooops: we ought to have swapped these
+	float rbs, float sbs   // two lines to match PROTOCOL.txt
+)
+{
+	pan_net_get_radar_response_request(s, flags, n, nr, ns, ox, oy, oz, vx, vy,
+			vz, q0, q1, q2, q3, bwidth, rmid, smid, rbs, sbs);
 
 	/* We want a MSG_RADAR_RESPONSE reply */
 	return pan_net_want(s, MSG_RADAR_RESPONSE);
@@ -1347,21 +1507,24 @@ pan_net_get_radar_response_RX
  * released by free(). The size field will be updated with the number
  * of bytes in the result array.
  *
+ * pan_net_get_viewpoint_by_degrees_d_request(s, x, y, z, yw, pi, rl) only
+ * sends the request and does not wait for the reply. Several requests may
+ * be sent before the replies are read; each reply is then read in order
+ * with pan_net_want(s, MSG_IMAGE) followed by the _RX function.
+ *
+ * pan_net_get_viewpoint_by_degrees_d_queue(m, x, y, z, yw, pi, rl) adds
+ * the same request to the message builder "m" without sending it. All of
+ * the requests queued in "m" go out together on pan_socket_msg_flush().
+ *
  * IMPLEMENTS GetViewpointByDegreesD (16)
  */
-char *
-pan_net_get_viewpoint_by_degrees_d_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+static char *
+pan_net_poke_viewpoint_by_degrees_d(char *p, double x, double y, double z, double yw, double pi, double rl)
 {
 	/*
-	 * Send the GetViewpointByDegrees message with parameters (x, y, z)
-	 * and (yw, pi, rl). We're sending one ulong and six doubles.
+	 * The GetViewpointByDegrees message has parameters (x, y, z) and
+	 * (yw, pi, rl). That is one ulong and six doubles.
 	 */
-	const int bufsize = 1*4 + 6*8;
-	static char buf[bufsize];
-	int nbytes;
-
-	/* Initialise the buffer. */
-	char *p = buf;
 	p = pan_socket_poke_ulong (p, MSG_GET_VIEWPOINT_BY_DEGREES_D);
 	p = pan_socket_poke_double(p, x);
 	p = pan_socket_poke_double(p, y);
@@ -1369,11 +1532,37 @@ pan_net_get_viewpoint_by_degrees_d_TX(SOCKET s, double x, double y, double z, do
 	p = pan_socket_poke_double(p, yw);
 	p = pan_socket_poke_double(p, pi);
 	p = pan_socket_poke_double(p, rl);
+	return p;
+}
+void
+pan_net_get_viewpoint_by_degrees_d_request(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+{
+	const int bufsize = 1*4 + 6*8;
+	char buf[bufsize];
+	int nbytes;
+
+	/* Initialise the buffer. */
+	char *p = pan_net_poke_viewpoint_by_degrees_d(buf, x, y, z, yw, pi, rl);
 	nbytes = p - buf;
 
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+void
+pan_net_get_viewpoint_by_degrees_d_queue(struct pan_socket_msg *m, double x, double y, double z, double yw, double pi, double rl)
+{
+	const int bufsize = 1*4 + 6*8;
+	char *buf = pan_socket_msg_reserve(m, bufsize); assert(buf);
+
+	char *p = pan_net_poke_viewpoint_by_degrees_d(buf, x, y, z, yw, pi, rl);
+	assert(p - buf == bufsize);
+	pan_socket_msg_commit(m, p);
+}
+char *
+pan_net_get_viewpoint_by_degrees_d_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+{
+	pan_net_get_viewpoint_by_degrees_d_request(s, x, y, z, yw, pi, rl);
 
 	/* We want a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -1413,15 +1602,15 @@ pan_net_get_viewpoint_by_degrees_d_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS GetViewpointByQuaternionD (17)
  */
-char *
-pan_net_get_viewpoint_by_quaternion_d_TX(SOCKET s, double x, double y, double z, double q0, double q1, double q2, double q3)
+void
+pan_net_get_viewpoint_by_quaternion_d_request(SOCKET s, double x, double y, double z, double q0, double q1, double q2, double q3)
 {
 	/*
 	 * Send the GetViewpointByQuaternion message with parameters (x, y, z)
 	 * and (q0, q1, q2, q3). We're sending one ulong and seven doubles.
 	 */
 	const int bufsize = 1*4 + 7*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1439,6 +1628,11 @@ pan_net_get_viewpoint_by_quaternion_d_TX(SOCKET s, double x, double y, double z,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_viewpoint_by_quaternion_d_TX(SOCKET s, double x, double y, double z, double q0, double q1, double q2, double q3)
+{
+	pan_net_get_viewpoint_by_quaternion_d_request(s, x, y, z, q0, q1, q2, q3);
 
 	/* We expect a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -1483,15 +1677,15 @@ pan_net_get_viewpoint_by_quaternion_d_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS GetJoints (18)
  */
-char * 
-pan_net_get_joints_TX(SOCKET s, unsigned long o)
+void
+pan_net_get_joints_request(SOCKET s, unsigned long o)
 {
 	/*
 	 * Send the GetJoints message.
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1503,6 +1697,11 @@ pan_net_get_joints_TX(SOCKET s, unsigned long o)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_joints_TX(SOCKET s, unsigned long o)
+{
+	pan_net_get_joints_request(s, o);
 
 	/* We want a MSG_JOINT_LIST reply */
 	return pan_net_want(s, MSG_JOINT_LIST);
@@ -1556,9 +1755,8 @@ pan_net_get_joints_RX(SOCKET s, unsigned long *n)
  *
  * IMPLEMENTS GetJointConfig (19)
  */
-char * 
-pan_net_get_joint_config_TX
-(
+void
+pan_net_get_joint_config_request(
 	SOCKET s,
 	unsigned long obj,
 	unsigned long joint
@@ -1569,7 +1767,7 @@ pan_net_get_joint_config_TX
 	 * We're sending three ulongs.
 	 */
 	const int bufsize = 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1582,6 +1780,15 @@ pan_net_get_joint_config_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_joint_config_TX(
+	SOCKET s,
+	unsigned long obj,
+	unsigned long joint
+)
+{
+	pan_net_get_joint_config_request(s, obj, joint);
 
 	/* We want an MSG_DOUBLE_ARRAY message */
 	return pan_net_want(s, MSG_DOUBLE_ARRAY);
@@ -1621,15 +1828,15 @@ pan_net_get_joint_config_RX
  *
  * IMPLEMENTS GetFrames (20)
  */
-char *
-pan_net_get_frames_TX(SOCKET s, unsigned long obj)
+void
+pan_net_get_frames_request(SOCKET s, unsigned long obj)
 {
 	/*
 	 * Send the GetFrames message.
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1641,6 +1848,11 @@ pan_net_get_frames_TX(SOCKET s, unsigned long obj)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_frames_TX(SOCKET s, unsigned long obj)
+{
+	pan_net_get_frames_request(s, obj);
 
 	/* We want a MSG_FRAME_LIST reply */
 	return pan_net_want(s, MSG_FRAME_LIST);
@@ -1677,9 +1889,8 @@ pan_net_get_frames_RX(SOCKET s, unsigned long *n)
  *
  * IMPLEMENTS GetFrame (21)
  */
-char *
-pan_net_get_frame_TX
-(
+void
+pan_net_get_frame_request(
 	SOCKET s,
 	unsigned long obj,
 	unsigned long id
@@ -1690,7 +1901,7 @@ pan_net_get_frame_TX
 	 * We're sending three ulongs.
 	 */
 	const int bufsize = 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1703,6 +1914,15 @@ pan_net_get_frame_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_frame_TX(
+	SOCKET s,
+	unsigned long obj,
+	unsigned long id
+)
+{
+	pan_net_get_frame_request(s, obj, id);
 
 	/* We want a MSG_DOUBLE_ARRAY reply */
 	return pan_net_want(s, MSG_DOUBLE_ARRAY);
@@ -1740,9 +1960,8 @@ pan_net_get_frame_RX
  *
  * IMPLEMENTS GetFrameAsRadians (22)
  */
-char *
-pan_net_get_frame_as_radians_TX
-(
+void
+pan_net_get_frame_as_radians_request(
 	SOCKET s,
 	unsigned long obj,
 	unsigned long id
@@ -1753,7 +1972,7 @@ pan_net_get_frame_as_radians_TX
 	 * We're sending three ulongs.
 	 */
 	const int bufsize = 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1766,6 +1985,15 @@ pan_net_get_frame_as_radians_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_frame_as_radians_TX(
+	SOCKET s,
+	unsigned long obj,
+	unsigned long id
+)
+{
+	pan_net_get_frame_as_radians_request(s, obj, id);
 
 	/* We want a MSG_DOUBLE_ARRAY reply */
 	return pan_net_want(s, MSG_DOUBLE_ARRAY);
@@ -1809,9 +2037,8 @@ pan_net_get_frame_as_radians_RX
  *
  * IMPLEMENTS GetSurfaceElevation (23)
  */
-char *
-pan_net_get_surface_elevation_TX
-(
+void
+pan_net_get_surface_elevation_request(
 	SOCKET s,
 	unsigned char boulders,
 	float x,
@@ -1823,7 +2050,7 @@ pan_net_get_surface_elevation_TX
 	 * We're sending one ulong, one bool and two floats.
 	 */
 	const int bufsize = 1*4 + 1*1 + 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1837,6 +2064,16 @@ pan_net_get_surface_elevation_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_surface_elevation_TX(
+	SOCKET s,
+	unsigned char boulders,
+	float x,
+	float y
+)
+{
+	pan_net_get_surface_elevation_request(s, boulders, x, y);
 
 	/* Want a MSG_FLOAT reply */
 	return pan_net_want(s, MSG_FLOAT);
@@ -1872,9 +2109,8 @@ pan_net_get_surface_elevation_RX
  *
  * IMPLEMENTS GetSurfaceElevations (24)
  */
-char *
-pan_net_get_surface_elevations_TX
-(
+void
+pan_net_get_surface_elevations_request(
 	SOCKET s,
 	unsigned char boulders,
 	unsigned long n,
@@ -1909,6 +2145,16 @@ pan_net_get_surface_elevations_TX
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
 	(void)free(buf); buf = 0;
+}
+char *
+pan_net_get_surface_elevations_TX(
+	SOCKET s,
+	unsigned char boulders,
+	unsigned long n,
+	float *posv
+)
+{
+	pan_net_get_surface_elevations_request(s, boulders, n, posv);
 
 	/* We want a MSG_FLOAT_ARRAY reply */
 	return pan_net_want(s, MSG_FLOAT_ARRAY);
@@ -1957,9 +2203,8 @@ pan_net_get_surface_elevations_RX
  *
  * IMPLEMENTS GetSurfacePatch (25)
  */
-char *
-pan_net_get_surface_patch_TX
-(
+void
+pan_net_get_surface_patch_request(
 	SOCKET s,
 	unsigned char boulders,
 	float cx, float cy,
@@ -1973,7 +2218,7 @@ pan_net_get_surface_patch_TX
 	 * We're sending three ulongs, one bool and four floats.
 	 */
 	const int bufsize = 3*4 + 1*1 + 4*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -1991,6 +2236,18 @@ pan_net_get_surface_patch_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_surface_patch_TX(
+	SOCKET s,
+	unsigned char boulders,
+	float cx, float cy,
+	unsigned long nx, unsigned long ny,
+	float d,
+	float theta
+)
+{
+	pan_net_get_surface_patch_request(s, boulders, cx, cy, nx, ny, d, theta);
 
 	/* We want a MSG_FLOAT_ARRAY reply */
 	return pan_net_want(s, MSG_FLOAT_ARRAY);
@@ -2030,15 +2287,15 @@ pan_net_get_surface_patch_RX
  *
  * IMPLEMENTS GetViewpointByRadians (26)
  */
-char *
-pan_net_get_viewpoint_by_radians_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+void
+pan_net_get_viewpoint_by_radians_request(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
 {
 	/*
 	 * Send the GetViewpointByRadians message with parameters (x, y, z)
 	 * and (yw, pi, rl). We're sending one ulong and six doubles.
 	 */
 	const int bufsize = 1*4 + 6*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -2055,6 +2312,11 @@ pan_net_get_viewpoint_by_radians_TX(SOCKET s, double x, double y, double z, doub
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_viewpoint_by_radians_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+{
+	pan_net_get_viewpoint_by_radians_request(s, x, y, z, yw, pi, rl);
 
 	/* We want a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -2090,11 +2352,16 @@ pan_net_get_viewpoint_by_radians_RX(SOCKET s, unsigned long *psize)
  *
  * IMPLEMENTS Quit (27)
  */
-char *
-pan_net_quit_TX(SOCKET s)
+void
+pan_net_quit_request(SOCKET s)
 {
 	/* Send the Quit message */
 	pan_socket_write_ulong(s, MSG_QUIT);
+}
+char *
+pan_net_quit_TX(SOCKET s)
+{
+	pan_net_quit_request(s);
 	return pan_net_want(s, MSG_OKAY);
 }
 
@@ -2112,9 +2379,8 @@ pan_net_quit_TX(SOCKET s)
  *
  * IMPLEMENTS GetViewpointByFrame (28)
  */
-char *
-pan_net_get_viewpoint_by_frame_TX
-(
+void
+pan_net_get_viewpoint_by_frame_request(
 	SOCKET s,
 	unsigned long oid,
 	unsigned long fid
@@ -2125,7 +2391,7 @@ pan_net_get_viewpoint_by_frame_TX
 	 * We're sending three ulongs.
 	 */
 	const int bufsize = 1*4 + 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -2138,6 +2404,15 @@ pan_net_get_viewpoint_by_frame_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_viewpoint_by_frame_TX(
+	SOCKET s,
+	unsigned long oid,
+	unsigned long fid
+)
+{
+	pan_net_get_viewpoint_by_frame_request(s, oid, fid);
 
 	/* Want a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -2183,9 +2458,8 @@ pan_net_get_viewpoint_by_frame_RX
  *
  * IMPLEMENTS GetCameraProperties (29)
  */
-char *
-pan_net_get_camera_properties_TX
-(
+void
+pan_net_get_camera_properties_request(
 	SOCKET s,
 	unsigned long cid
 )
@@ -2197,7 +2471,7 @@ pan_net_get_camera_properties_TX
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -2208,6 +2482,14 @@ pan_net_get_camera_properties_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_camera_properties_TX(
+	SOCKET s,
+	unsigned long cid
+)
+{
+	pan_net_get_camera_properties_request(s, cid);
 
 	/* We want a MSG_CAMERA_PROPERTIES reply */
 	return pan_net_want(s, MSG_CAMERA_PROPERTIES);
@@ -2314,9 +2596,8 @@ pan_net_get_camera_properties_RX
  *
  * IMPLEMENTS GetViewpointByCamera (30)
  */
-char *
-pan_net_get_viewpoint_by_camera_TX
-(
+void
+pan_net_get_viewpoint_by_camera_request(
 	SOCKET s,
 	unsigned long cid
 )
@@ -2326,7 +2607,7 @@ pan_net_get_viewpoint_by_camera_TX
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -2338,6 +2619,14 @@ pan_net_get_viewpoint_by_camera_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_viewpoint_by_camera_TX(
+	SOCKET s,
+	unsigned long cid
+)
+{
+	pan_net_get_viewpoint_by_camera_request(s, cid);
 
 	/* Want a MSG_IMAGE reply */
 	return pan_net_want(s, MSG_IMAGE);
@@ -2387,9 +2676,8 @@ pan_net_get_viewpoint_by_camera_RX
  *
  * IMPLEMENTS GetViewAsDEM (31)
  */
-char *
-pan_net_get_view_as_dem_TX
-(
+void
+pan_net_get_view_as_dem_request(
 	SOCKET s,
 	unsigned long cid,
 	unsigned char boulders,
@@ -2403,7 +2691,7 @@ pan_net_get_view_as_dem_TX
 	 * We're sending four ulongs, one bool and three floats.
 	 */
 	const int bufsize = 3*4 + 1*1 + 4*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -2421,6 +2709,18 @@ pan_net_get_view_as_dem_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_view_as_dem_TX(
+	SOCKET s,
+	unsigned long cid,
+	unsigned char boulders,
+	unsigned long nx, unsigned long ny,
+	float dx, float dy,
+	float rd
+)
+{
+	pan_net_get_view_as_dem_request(s, cid, boulders, nx, ny, dx, dy, rd);
 
 	/* We want a MSG_FLOAT_ARRAY reply */
 	return pan_net_want(s, MSG_FLOAT_ARRAY);
@@ -2476,8 +2776,8 @@ pan_net_get_view_as_dem_RX
  *
  * IMPLEMENTS GetLidarMeasurementD (32)
  */
-char *
-pan_net_get_lidar_measurement_d_TX(SOCKET s,
+void
+pan_net_get_lidar_measurement_d_request(SOCKET s,
 	double px, double py, double pz,
 	double q0, double q1, double q2, double q3,
 	double vx, double vy, double vz,
@@ -2492,7 +2792,7 @@ pan_net_get_lidar_measurement_d_TX(SOCKET s,
 	 * We're sending one ulong and 25 doubles.
 	 */
 	const int bufsize = 1*4 + 25*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -2528,6 +2828,20 @@ pan_net_get_lidar_measurement_d_TX(SOCKET s,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_lidar_measurement_d_TX(SOCKET s,
+	double px, double py, double pz,
+	double q0, double q1, double q2, double q3,
+	double vx, double vy, double vz,
+	double rx, double ry, double rz,
+	double ax, double ay, double az,
+	double sx, double sy, double sz,
+	double jx, double jy, double jz,
+	double tx, double ty, double tz)
+{
+	pan_net_get_lidar_measurement_d_request(s, px, py, pz, q0, q1, q2, q3, vx, vy,
+			vz, rx, ry, rz, ax, ay, az, sx, sy, sz, jx, jy, jz, tx, ty, tz);
 
 	/* We want a MSG_LIDAR_MEASUREMENT reply */
 	return pan_net_want(s, MSG_LIDAR_MEASUREMENT);
@@ -2646,11 +2960,16 @@ pan_net_get_lidar_measurement_d_RX(SOCKET s,
  *
  * IMPLEMENTS GetTimeTag (33)
  */
-char *
-pan_net_get_time_tag_TX(SOCKET s)
+void
+pan_net_get_time_tag_request(SOCKET s)
 {
 	/* Send the empty GetTimeTag message and want a MSG_DOUBLE reply */
 	(void)pan_socket_write_ulong(s, MSG_GET_TIME_TAG);
+}
+char *
+pan_net_get_time_tag_TX(SOCKET s)
+{
+	pan_net_get_time_tag_request(s);
 	return pan_net_want(s, MSG_DOUBLE);
 }
 double
@@ -2694,8 +3013,8 @@ pan_net_get_time_tag_RX(SOCKET s, char *perr)
  *
  * IMPLEMENTS GetLidarMeasurementS (34)
  */
-char *
-pan_net_get_lidar_measurement_s_TX(SOCKET s,
+void
+pan_net_get_lidar_measurement_s_request(SOCKET s,
 	float px, float py, float pz,
 	float q0, float q1, float q2, float q3,
 	float vx, float vy, float vz,
@@ -2710,7 +3029,7 @@ pan_net_get_lidar_measurement_s_TX(SOCKET s,
 	 * We're sending one ulong and 25 floats.
 	 */
 	const int bufsize = 1*4 + 25*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -2746,6 +3065,20 @@ pan_net_get_lidar_measurement_s_TX(SOCKET s,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_lidar_measurement_s_TX(SOCKET s,
+	float px, float py, float pz,
+	float q0, float q1, float q2, float q3,
+	float vx, float vy, float vz,
+	float rx, float ry, float rz,
+	float ax, float ay, float az,
+	float sx, float sy, float sz,
+	float jx, float jy, float jz,
+	float tx, float ty, float tz)
+{
+	pan_net_get_lidar_measurement_s_request(s, px, py, pz, q0, q1, q2, q3, vx, vy,
+			vz, rx, ry, rz, ax, ay, az, sx, sy, sz, jx, jy, jz, tx, ty, tz);
 
 	/* We want a MSG_LIDAR_MEASUREMENT reply */
 	return pan_net_want(s, MSG_LIDAR_MEASUREMENT);
@@ -2871,8 +3204,8 @@ pan_net_get_lidar_measurement_s_RX(SOCKET s,
  *
  * IMPLEMENTS GetLidarSnapshot (35)
  */
-char *
-pan_net_get_lidar_snapshot_TX(SOCKET s, unsigned long cid,
+void
+pan_net_get_lidar_snapshot_request(SOCKET s, unsigned long cid,
 		double px, double py, double pz,
 		double q0, double q1, double q2, double q3)
 {
@@ -2881,7 +3214,7 @@ pan_net_get_lidar_snapshot_TX(SOCKET s, unsigned long cid,
 	 * We're sending 2 ulongs and 7 doubles.
 	 */
 	const int bufsize = 2*4 + 7*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -2900,6 +3233,13 @@ pan_net_get_lidar_snapshot_TX(SOCKET s, unsigned long cid,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_get_lidar_snapshot_TX(SOCKET s, unsigned long cid,
+		double px, double py, double pz,
+		double q0, double q1, double q2, double q3)
+{
+	pan_net_get_lidar_snapshot_request(s, cid, px, py, pz, q0, q1, q2, q3);
 
 	/* We want a MSG_RAW_IMAGE reply */
 	return pan_net_want(s, MSG_RAW_IMAGE);
@@ -2977,15 +3317,15 @@ pan_net_get_lidar_snapshot_RX(SOCKET s,
  *
  * IMPLEMENTS SetViewpointByDegreesS (256)
  */
-char *
-pan_net_set_viewpoint_by_degrees_s_TX(SOCKET s, float x, float y, float z, float yw, float pi, float rl)
+void
+pan_net_set_viewpoint_by_degrees_s_request(SOCKET s, float x, float y, float z, float yw, float pi, float rl)
 {
 	/*
 	 * Send the SetViewpointByDegrees message with parameters (x, y, z)
 	 * and (yw, pi, rl). We're sending one ulong and six floats.
 	 */
 	const int bufsize = 1*4 + 6*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3002,6 +3342,11 @@ pan_net_set_viewpoint_by_degrees_s_TX(SOCKET s, float x, float y, float z, float
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_viewpoint_by_degrees_s_TX(SOCKET s, float x, float y, float z, float yw, float pi, float rl)
+{
+	pan_net_set_viewpoint_by_degrees_s_request(s, x, y, z, yw, pi, rl);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3017,15 +3362,15 @@ pan_net_set_viewpoint_by_degrees_s_TX(SOCKET s, float x, float y, float z, float
  *
  * IMPLEMENTS SetViewpointByQuaternionS (257)
  */
-char *
-pan_net_set_viewpoint_by_quaternion_s_TX(SOCKET s, float x, float y, float z, float q0, float q1, float q2, float q3)
+void
+pan_net_set_viewpoint_by_quaternion_s_request(SOCKET s, float x, float y, float z, float q0, float q1, float q2, float q3)
 {
 	/*
 	 * Send the SetViewpointByQuaternion message with parameters (x, y, z)
 	 * and (q0, q1, q2, q3). We're sending one ulong and seven floats.
 	 */
 	const int bufsize = 1*4 + 7*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3043,6 +3388,11 @@ pan_net_set_viewpoint_by_quaternion_s_TX(SOCKET s, float x, float y, float z, fl
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_viewpoint_by_quaternion_s_TX(SOCKET s, float x, float y, float z, float q0, float q1, float q2, float q3)
+{
+	pan_net_set_viewpoint_by_quaternion_s_request(s, x, y, z, q0, q1, q2, q3);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3057,15 +3407,15 @@ pan_net_set_viewpoint_by_quaternion_s_TX(SOCKET s, float x, float y, float z, fl
  *
  * IMPLEMENTS SetAmbientLight (258)
  */
-char *
-pan_net_set_ambient_light_TX(SOCKET s, float r, float g, float b)
+void
+pan_net_set_ambient_light_request(SOCKET s, float r, float g, float b)
 {
 	/*
 	 * Send the SetAmbientLight message with parameters (r, g, b).
 	 * We're sending one ulong and three floats.
 	 */
 	const int bufsize = 1*4 + 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3079,6 +3429,11 @@ pan_net_set_ambient_light_TX(SOCKET s, float r, float g, float b)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_ambient_light_TX(SOCKET s, float r, float g, float b)
+{
+	pan_net_set_ambient_light_request(s, r, g, b);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3093,15 +3448,15 @@ pan_net_set_ambient_light_TX(SOCKET s, float r, float g, float b)
  *
  * IMPLEMENTS SetSunColour (259)
  */
-char *
-pan_net_set_sun_colour_TX(SOCKET s, float r, float g, float b)
+void
+pan_net_set_sun_colour_request(SOCKET s, float r, float g, float b)
 {
 	/*
 	 * Send the SetSunColour message with parameters (r, g, b).
 	 * We're sending one ulong and three floats.
 	 */
 	const int bufsize = 1*4 + 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3115,6 +3470,11 @@ pan_net_set_sun_colour_TX(SOCKET s, float r, float g, float b)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_sun_colour_TX(SOCKET s, float r, float g, float b)
+{
+	pan_net_set_sun_colour_request(s, r, g, b);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3139,15 +3499,15 @@ pan_net_set_sun_colour_TX(SOCKET s, float r, float g, float b)
  *
  * IMPLEMENTS SetSkyType (260)
  */
-char *
-pan_net_set_sky_type_TX(SOCKET s, unsigned long t)
+void
+pan_net_set_sky_type_request(SOCKET s, unsigned long t)
 {
 	/*
 	 * Send the SetSkyType message with parameter t.
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3159,6 +3519,11 @@ pan_net_set_sky_type_TX(SOCKET s, unsigned long t)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_sky_type_TX(SOCKET s, unsigned long t)
+{
+	pan_net_set_sky_type_request(s, t);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3174,15 +3539,15 @@ pan_net_set_sky_type_TX(SOCKET s, unsigned long t)
  *
  * IMPLEMENTS SetFieldOfViewByDegrees (261)
  */
-char *
-pan_net_set_field_of_view_by_degrees_TX(SOCKET s, float f)
+void
+pan_net_set_field_of_view_by_degrees_request(SOCKET s, float f)
 {
 	/*
 	 * Send the SetFieldOfViewByDegrees message with parameter f.
 	 * We're sending one ulong and one float.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3194,6 +3559,11 @@ pan_net_set_field_of_view_by_degrees_TX(SOCKET s, float f)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_field_of_view_by_degrees_TX(SOCKET s, float f)
+{
+	pan_net_set_field_of_view_by_degrees_request(s, f);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3209,15 +3579,15 @@ pan_net_set_field_of_view_by_degrees_TX(SOCKET s, float f)
  *
  * IMPLEMENTS SetAspectRatio (262)
  */
-char *
-pan_net_set_aspect_ratio_TX(SOCKET s, float r)
+void
+pan_net_set_aspect_ratio_request(SOCKET s, float r)
 {
 	/*
 	 * Send the SetAspectRatio message with parameter r.
 	 * We're sending one ulong and one float.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3229,6 +3599,11 @@ pan_net_set_aspect_ratio_TX(SOCKET s, float r)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_aspect_ratio_TX(SOCKET s, float r)
+{
+	pan_net_set_aspect_ratio_request(s, r);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3244,15 +3619,15 @@ pan_net_set_aspect_ratio_TX(SOCKET s, float r)
  *
  * IMPLEMENTS SetBoulderView (263)
  */
-char *
-pan_net_set_boulder_view_TX(SOCKET s, unsigned long type, int texture)
+void
+pan_net_set_boulder_view_request(SOCKET s, unsigned long type, int texture)
 {
 	/*
 	 * Send the SetBoulderView message with parameters (type, texture).
 	 * We're sending two ulongs and one bool.
 	 */
 	const int bufsize = 2*4 + 1*1;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3265,6 +3640,11 @@ pan_net_set_boulder_view_TX(SOCKET s, unsigned long type, int texture)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_boulder_view_TX(SOCKET s, unsigned long type, int texture)
+{
+	pan_net_set_boulder_view_request(s, type, texture);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3280,15 +3660,15 @@ pan_net_set_boulder_view_TX(SOCKET s, unsigned long type, int texture)
  *
  * IMPLEMENTS SetSurfaceView (264)
  */
-char *
-pan_net_set_surface_view_TX(SOCKET s, unsigned long type, int tex, int det)
+void
+pan_net_set_surface_view_request(SOCKET s, unsigned long type, int tex, int det)
 {
 	/*
 	 * Send the SetSurfaceView message with parameters (type, tex, det).
 	 * We're sending two ulongs and two bools.
 	 */
 	const int bufsize = 2*4 + 2*1;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3302,6 +3682,11 @@ pan_net_set_surface_view_TX(SOCKET s, unsigned long type, int tex, int det)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_surface_view_TX(SOCKET s, unsigned long type, int tex, int det)
+{
+	pan_net_set_surface_view_request(s, type, tex, det);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3349,8 +3734,8 @@ pan_net_set_surface_view_TX(SOCKET s, unsigned long type, int tex, int det)
  *
  * IMPLEMENTS SetLidarParameters (265)
  */
-char *
-pan_net_set_lidar_parameters_TX(SOCKET s,
+void
+pan_net_set_lidar_parameters_request(SOCKET s,
 	float fx, float fy,
 	unsigned long nx, unsigned long ny,
 	float tx, float ty,
@@ -3369,7 +3754,7 @@ pan_net_set_lidar_parameters_TX(SOCKET s,
 	 * We're sending one ulong and 32 words (ulongs and floats).
 	 */
 	const int bufsize = 1*4 + 32*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3403,6 +3788,21 @@ pan_net_set_lidar_parameters_TX(SOCKET s,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_lidar_parameters_TX(SOCKET s,
+	float fx, float fy,
+	unsigned long nx, unsigned long ny,
+	float tx, float ty,
+	unsigned long n, unsigned long m,
+	unsigned long t, unsigned long fl,
+	float az, float el, float th,
+	float wx, float wy,
+	float faz, float fel,
+	float toff, float taz0, float tel0)
+{
+	pan_net_set_lidar_parameters_request(s, fx, fy, nx, ny, tx, ty, n, m, t, fl,
+			az, el, th, wx, wy, faz, fel, toff, taz0, tel0);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3425,9 +3825,8 @@ pan_net_set_lidar_parameters_TX(SOCKET s,
  *
  * IMPLEMENTS SetCornerCubesS (266)
  */
-char *
-pan_net_set_corner_cubes_s_TX
-(
+void
+pan_net_set_corner_cubes_s_request(
 	SOCKET s,
 	unsigned long n,
 	unsigned long fmt,
@@ -3466,6 +3865,16 @@ pan_net_set_corner_cubes_s_TX
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
 	(void)free(buf); buf = 0;
+}
+char *
+pan_net_set_corner_cubes_s_TX(
+	SOCKET s,
+	unsigned long n,
+	unsigned long fmt,
+	float *pcc
+)
+{
+	pan_net_set_corner_cubes_s_request(s, n, fmt, pcc);
 
 	/* Want an Okay response */
 	return pan_net_want(s, MSG_OKAY);
@@ -3483,9 +3892,8 @@ pan_net_set_corner_cubes_s_TX
  *
  * IMPLEMENTS SetCornerCubeAttitude (267)
  */
-char *
-pan_net_set_corner_cube_attitude_TX
-(
+void
+pan_net_set_corner_cube_attitude_request(
 	SOCKET s,
 	float q0, float q1, float q2, float q3,
 	float rx, float ry, float rz,
@@ -3498,7 +3906,7 @@ pan_net_set_corner_cube_attitude_TX
 	 * We're sending one ulong and thirteen floats.
 	 */
 	const int bufsize = 1*4 + 13*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3522,6 +3930,18 @@ pan_net_set_corner_cube_attitude_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_corner_cube_attitude_TX(
+	SOCKET s,
+	float q0, float q1, float q2, float q3,
+	float rx, float ry, float rz,
+	float ax, float ay, float az,
+	float jx, float jy, float jz
+)
+{
+	pan_net_set_corner_cube_attitude_request(s, q0, q1, q2, q3, rx, ry, rz, ax,
+			ay, az, jx, jy, jz);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3537,15 +3957,15 @@ pan_net_set_corner_cube_attitude_TX
  *
  * IMPLEMENTS SetViewpointByDegreesD (268)
  */
-char *
-pan_net_set_viewpoint_by_degrees_d_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+void
+pan_net_set_viewpoint_by_degrees_d_request(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
 {
 	/*
 	 * Send the SetViewpointByDegrees message with parameters (x, y, z)
 	 * and (yw, pi, rl). We're sending one ulong and six doubles.
 	 */
 	const int bufsize = 1*4 + 6*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3562,6 +3982,11 @@ pan_net_set_viewpoint_by_degrees_d_TX(SOCKET s, double x, double y, double z, do
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_viewpoint_by_degrees_d_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+{
+	pan_net_set_viewpoint_by_degrees_d_request(s, x, y, z, yw, pi, rl);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3577,15 +4002,15 @@ pan_net_set_viewpoint_by_degrees_d_TX(SOCKET s, double x, double y, double z, do
  *
  * IMPLEMENTS SetViewpointByQuaternionD (269)
  */
-char *
-pan_net_set_viewpoint_by_quaternion_d_TX(SOCKET s, double x, double y, double z, double q0, double q1, double q2, double q3)
+void
+pan_net_set_viewpoint_by_quaternion_d_request(SOCKET s, double x, double y, double z, double q0, double q1, double q2, double q3)
 {
 	/*
 	 * Send the SetViewpointByQuaternion message with parameters (x, y, z)
 	 * and (q0, q1, q2, q3). We're sending one ulong and seven doubles.
 	 */
 	const int bufsize = 1*4 + 7*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3603,6 +4028,11 @@ pan_net_set_viewpoint_by_quaternion_d_TX(SOCKET s, double x, double y, double z,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_viewpoint_by_quaternion_d_TX(SOCKET s, double x, double y, double z, double q0, double q1, double q2, double q3)
+{
+	pan_net_set_viewpoint_by_quaternion_d_request(s, x, y, z, q0, q1, q2, q3);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3618,9 +4048,8 @@ pan_net_set_viewpoint_by_quaternion_d_TX(SOCKET s, double x, double y, double z,
  *
  * IMPLEMENTS SetObjectPositionAttitude (270)
  */
-char *
-pan_net_set_object_position_attitude_TX
-(
+void
+pan_net_set_object_position_attitude_request(
 	SOCKET s,
 	unsigned long id,
 	double x, double y, double z,
@@ -3632,7 +4061,7 @@ pan_net_set_object_position_attitude_TX
 	 * We're sending two ulongs and seven doubles.
 	 */
 	const int bufsize = 2*4 + 7*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3651,6 +4080,16 @@ pan_net_set_object_position_attitude_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_object_position_attitude_TX(
+	SOCKET s,
+	unsigned long id,
+	double x, double y, double z,
+	double q0, double q1, double q2, double q3
+)
+{
+	pan_net_set_object_position_attitude_request(s, id, x, y, z, q0, q1, q2, q3);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3665,15 +4104,15 @@ pan_net_set_object_position_attitude_TX
  *
  * IMPLEMENTS SetSunByDegrees (271)
  */
-char *
-pan_net_set_sun_by_degrees_TX(SOCKET s, double r, double a, double e)
+void
+pan_net_set_sun_by_degrees_request(SOCKET s, double r, double a, double e)
 {
 	/*
 	 * Send the SetSunByDegrees message.
 	 * We're sending one ulong and three doubles.
 	 */
 	const int bufsize = 1*4 + 3*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3687,6 +4126,11 @@ pan_net_set_sun_by_degrees_TX(SOCKET s, double r, double a, double e)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_sun_by_degrees_TX(SOCKET s, double r, double a, double e)
+{
+	pan_net_set_sun_by_degrees_request(s, r, a, e);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3701,9 +4145,8 @@ pan_net_set_sun_by_degrees_TX(SOCKET s, double r, double a, double e)
  *
  * IMPLEMENTS SetJointConfig (272)
  */
-char *
-pan_net_set_joint_config_TX
-(
+void
+pan_net_set_joint_config_request(
 	SOCKET s,
 	unsigned long obj,
 	unsigned long joint,
@@ -3717,7 +4160,7 @@ pan_net_set_joint_config_TX
 	 * We're sending four ulongs, nine doubles and nine bools.
 	 */
 	const int bufsize = 4*4 + 9*8 + 9*1;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3736,6 +4179,16 @@ pan_net_set_joint_config_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_joint_config_TX(
+	SOCKET s,
+	unsigned long obj,
+	unsigned long joint,
+	double config[9]
+)
+{
+	pan_net_set_joint_config_request(s, obj, joint, config);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3750,9 +4203,8 @@ pan_net_set_joint_config_TX
  *
  * IMPLEMENTS SetStarQuaternion (273)
  */
-char *
-pan_net_set_star_quaternion_TX
-(
+void
+pan_net_set_star_quaternion_request(
 	SOCKET s,
 	double q0, double q1, double q2, double q3
 )
@@ -3762,7 +4214,7 @@ pan_net_set_star_quaternion_TX
 	 * We're sending one ulong and four doubles.
 	 */
 	const int bufsize = 1*4 + 4*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3777,6 +4229,14 @@ pan_net_set_star_quaternion_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_star_quaternion_TX(
+	SOCKET s,
+	double q0, double q1, double q2, double q3
+)
+{
+	pan_net_set_star_quaternion_request(s, q0, q1, q2, q3);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3791,15 +4251,15 @@ pan_net_set_star_quaternion_TX
  *
  * IMPLEMENTS SetStarMagnitudes (274)
  */
-char *
-pan_net_set_star_magnitudes_TX(SOCKET s, double m)
+void
+pan_net_set_star_magnitudes_request(SOCKET s, double m)
 {
 	/*
 	 * Send the SetStarMagnitudes message.
 	 * We're sending one ulong and one double.
 	 */
 	const int bufsize = 1*4 + 1*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3811,6 +4271,11 @@ pan_net_set_star_magnitudes_TX(SOCKET s, double m)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_star_magnitudes_TX(SOCKET s, double m)
+{
+	pan_net_set_star_magnitudes_request(s, m);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3825,15 +4290,15 @@ pan_net_set_star_magnitudes_TX(SOCKET s, double m)
  *
  * IMPLEMENTS SetSecondaryByDegrees (275)
  */
-char *
-pan_net_set_secondary_by_degrees_TX(SOCKET s, double r, double a, double e)
+void
+pan_net_set_secondary_by_degrees_request(SOCKET s, double r, double a, double e)
 {
 	/*
 	 * Send the SetSecondaryByDegrees message.
 	 * We're sending one ulong and three doubles.
 	 */
 	const int bufsize = 1*4 + 3*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3847,6 +4312,11 @@ pan_net_set_secondary_by_degrees_TX(SOCKET s, double r, double a, double e)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_secondary_by_degrees_TX(SOCKET s, double r, double a, double e)
+{
+	pan_net_set_secondary_by_degrees_request(s, r, a, e);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3861,15 +4331,15 @@ pan_net_set_secondary_by_degrees_TX(SOCKET s, double r, double a, double e)
  *
  * IMPLEMENTS SetGlobalTime (276)
  */
-char *
-pan_net_set_global_time_TX(SOCKET s, double t)
+void
+pan_net_set_global_time_request(SOCKET s, double t)
 {
 	/*
 	 * Send the SetStarMagnitudes message.
 	 * We're sending one ulong and one double.
 	 */
 	const int bufsize = 1*4 + 1*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3881,6 +4351,11 @@ pan_net_set_global_time_TX(SOCKET s, double t)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_global_time_TX(SOCKET s, double t)
+{
+	pan_net_set_global_time_request(s, t);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3895,15 +4370,15 @@ pan_net_set_global_time_TX(SOCKET s, double t)
  *
  * IMPLEMENTS SetObjectView (277)
  */
-char * 
-pan_net_set_object_view_TX(SOCKET s, unsigned long id, unsigned long type)
+void
+pan_net_set_object_view_request(SOCKET s, unsigned long id, unsigned long type)
 {
 	/*
 	 * Send the SetObjectView message with parameters (id, type).
 	 * We're sending three ulongs.
 	 */
 	const int bufsize = 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3916,6 +4391,11 @@ pan_net_set_object_view_TX(SOCKET s, unsigned long id, unsigned long type)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_object_view_TX(SOCKET s, unsigned long id, unsigned long type)
+{
+	pan_net_set_object_view_request(s, id, type);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3931,15 +4411,15 @@ pan_net_set_object_view_TX(SOCKET s, unsigned long id, unsigned long type)
  *
  * IMPLEMENTS SetViewpointByRadians (278)
  */
-char *
-pan_net_set_viewpoint_by_radians_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+void
+pan_net_set_viewpoint_by_radians_request(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
 {
 	/*
 	 * Send the SetViewpointByRadians message with parameters (x, y, z)
 	 * and (yw, pi, rl). We're sending one ulong and six doubles.
 	 */
 	const int bufsize = 1*4 + 6*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3956,6 +4436,11 @@ pan_net_set_viewpoint_by_radians_TX(SOCKET s, double x, double y, double z, doub
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_viewpoint_by_radians_TX(SOCKET s, double x, double y, double z, double yw, double pi, double rl)
+{
+	pan_net_set_viewpoint_by_radians_request(s, x, y, z, yw, pi, rl);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -3971,15 +4456,15 @@ pan_net_set_viewpoint_by_radians_TX(SOCKET s, double x, double y, double z, doub
  *
  * IMPLEMENTS SetFieldOfViewByRadians (279)
  */
-char *
-pan_net_set_field_of_view_by_radians_TX(SOCKET s, float f)
+void
+pan_net_set_field_of_view_by_radians_request(SOCKET s, float f)
 {
 	/*
 	 * Send the SetFieldOfViewByRadians message with parameter f.
 	 * We're sending one ulong and one float.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -3991,6 +4476,11 @@ pan_net_set_field_of_view_by_radians_TX(SOCKET s, float f)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_field_of_view_by_radians_TX(SOCKET s, float f)
+{
+	pan_net_set_field_of_view_by_radians_request(s, f);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4005,15 +4495,15 @@ pan_net_set_field_of_view_by_radians_TX(SOCKET s, float f)
  *
  * IMPLEMENTS SetSunByRadians (280)
  */
-char *
-pan_net_set_sun_by_radians_TX(SOCKET s, double r, double a, double e)
+void
+pan_net_set_sun_by_radians_request(SOCKET s, double r, double a, double e)
 {
 	/*
 	 * Send the SetSunByRadians message.
 	 * We're sending one ulong and three doubles.
 	 */
 	const int bufsize = 1*4 + 3*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4027,6 +4517,11 @@ pan_net_set_sun_by_radians_TX(SOCKET s, double r, double a, double e)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_sun_by_radians_TX(SOCKET s, double r, double a, double e)
+{
+	pan_net_set_sun_by_radians_request(s, r, a, e);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4041,15 +4536,15 @@ pan_net_set_sun_by_radians_TX(SOCKET s, double r, double a, double e)
  *
  * IMPLEMENTS SetSecondaryByRadians (281)
  */
-char *
-pan_net_set_secondary_by_radians_TX(SOCKET s, double r, double a, double e)
+void
+pan_net_set_secondary_by_radians_request(SOCKET s, double r, double a, double e)
 {
 	/*
 	 * Send the SetSecondaryByRadians message.
 	 * We're sending one ulong and three doubles.
 	 */
 	const int bufsize = 1*4 + 3*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4063,6 +4558,11 @@ pan_net_set_secondary_by_radians_TX(SOCKET s, double r, double a, double e)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_secondary_by_radians_TX(SOCKET s, double r, double a, double e)
+{
+	pan_net_set_secondary_by_radians_request(s, r, a, e);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4077,15 +4577,15 @@ pan_net_set_secondary_by_radians_TX(SOCKET s, double r, double a, double e)
  *
  * IMPLEMENTS SetSkyRGB (282)
  */
-char *
-pan_net_set_sky_rgb_TX(SOCKET s, float r, float g, float b)
+void
+pan_net_set_sky_rgb_request(SOCKET s, float r, float g, float b)
 {
 	/*
 	 * Send the SetSkyRGB message with parameters (r,g,b).
 	 * We're sending one ulong and three floats.
 	 */
 	const int bufsize = 1*4 + 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4099,6 +4599,11 @@ pan_net_set_sky_rgb_TX(SOCKET s, float r, float g, float b)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_sky_rgb_TX(SOCKET s, float r, float g, float b)
+{
+	pan_net_set_sky_rgb_request(s, r, g, b);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4113,15 +4618,15 @@ pan_net_set_sky_rgb_TX(SOCKET s, float r, float g, float b)
  *
  * IMPLEMENTS SetSkyCIE (283)
  */
-char *
-pan_net_set_sky_cie_TX(SOCKET s, float x, float y, float Y)
+void
+pan_net_set_sky_cie_request(SOCKET s, float x, float y, float Y)
 {
 	/*
 	 * Send the SetSkyCIE message with parameters (x,y,Y).
 	 * We're sending one ulong and three floats.
 	 */
 	const int bufsize = 1*4 + 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4135,6 +4640,11 @@ pan_net_set_sky_cie_TX(SOCKET s, float x, float y, float Y)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_sky_cie_TX(SOCKET s, float x, float y, float Y)
+{
+	pan_net_set_sky_cie_request(s, x, y, Y);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4151,15 +4661,15 @@ pan_net_set_sky_cie_TX(SOCKET s, float x, float y, float Y)
  *
  * IMPLEMENTS SetAtmosphereTau (284)
  */
-char *
-pan_net_set_atmosphere_tau_TX(SOCKET s, float mr, float mg, float mb, float rr, float rg, float rb)
+void
+pan_net_set_atmosphere_tau_request(SOCKET s, float mr, float mg, float mb, float rr, float rg, float rb)
 {
 	/*
 	 * Send the SetAtmosphereTau message with parameters (mie,ray).
 	 * We're sending one ulong and six floats.
 	 */
 	const int bufsize = 1*4 + 6*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4176,6 +4686,11 @@ pan_net_set_atmosphere_tau_TX(SOCKET s, float mr, float mg, float mb, float rr,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_atmosphere_tau_TX(SOCKET s, float mr, float mg, float mb, float rr, float rg, float rb)
+{
+	pan_net_set_atmosphere_tau_request(s, mr, mg, mb, rr, rg, rb);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4190,15 +4705,15 @@ pan_net_set_atmosphere_tau_TX(SOCKET s, float mr, float mg, float mb, float rr,
  *
  * IMPLEMENTS SetGlobalFogMode (285)
  */
-char *
-pan_net_set_global_fog_mode_TX(SOCKET s, unsigned long mode)
+void
+pan_net_set_global_fog_mode_request(SOCKET s, unsigned long mode)
 {
 	/*
 	 * Send the SetGlobalFogMode message with parameter mode.
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4210,6 +4725,11 @@ pan_net_set_global_fog_mode_TX(SOCKET s, unsigned long mode)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_global_fog_mode_TX(SOCKET s, unsigned long mode)
+{
+	pan_net_set_global_fog_mode_request(s, mode);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4227,8 +4747,8 @@ pan_net_set_global_fog_mode_TX(SOCKET s, unsigned long mode)
  *
  * IMPLEMENTS SetGlobalFogProperties (286)
  */
-char *
-pan_net_set_global_fog_properties_TX(SOCKET s, double radius, double density, double lin0, double lin1)
+void
+pan_net_set_global_fog_properties_request(SOCKET s, double radius, double density, double lin0, double lin1)
 {
 	/*
 	 * Send the SetGlobalFogProperties message with parameters
@@ -4236,7 +4756,7 @@ pan_net_set_global_fog_properties_TX(SOCKET s, double radius, double density, do
 	 * We're sending one ulong and four doubles.
 	 */
 	const int bufsize = 1*4 + 4*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4251,6 +4771,11 @@ pan_net_set_global_fog_properties_TX(SOCKET s, double radius, double density, do
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_global_fog_properties_TX(SOCKET s, double radius, double density, double lin0, double lin1)
+{
+	pan_net_set_global_fog_properties_request(s, radius, density, lin0, lin1);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4267,8 +4792,8 @@ pan_net_set_global_fog_properties_TX(SOCKET s, double radius, double density, do
  *
  * IMPLEMENTS SetAtmosphereMode (287)
  */
-char *
-pan_net_set_atmosphere_mode_TX(SOCKET s, unsigned long smode, unsigned long gmode, unsigned long amode)
+void
+pan_net_set_atmosphere_mode_request(SOCKET s, unsigned long smode, unsigned long gmode, unsigned long amode)
 {
 	/*
 	 * Send the SetAtmosphereMode message with parameters
@@ -4276,7 +4801,7 @@ pan_net_set_atmosphere_mode_TX(SOCKET s, unsigned long smode, unsigned long gmod
 	 * We're sending four ulongs.
 	 */
 	const int bufsize = 1*4 + 3*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 	int nbytes;
 
 	/* Initialise the buffer. */
@@ -4290,6 +4815,11 @@ pan_net_set_atmosphere_mode_TX(SOCKET s, unsigned long smode, unsigned long gmod
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_atmosphere_mode_TX(SOCKET s, unsigned long smode, unsigned long gmode, unsigned long amode)
+{
+	pan_net_set_atmosphere_mode_request(s, smode, gmode, amode);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4304,8 +4834,8 @@ pan_net_set_atmosphere_mode_TX(SOCKET s, unsigned long smode, unsigned long gmod
  *
  * IMPLEMENTS SelectCamera (288)
  */
-char *
-pan_net_select_camera_TX(SOCKET s, unsigned long cid)
+void
+pan_net_select_camera_request(SOCKET s, unsigned long cid)
 {
 	int nbytes;
 
@@ -4314,7 +4844,7 @@ pan_net_select_camera_TX(SOCKET s, unsigned long cid)
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4325,6 +4855,11 @@ pan_net_select_camera_TX(SOCKET s, unsigned long cid)
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_select_camera_TX(SOCKET s, unsigned long cid)
+{
+	pan_net_select_camera_request(s, cid);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4341,8 +4876,8 @@ pan_net_select_camera_TX(SOCKET s, unsigned long cid)
  *
  * IMPLEMENTS BindLightToCamera (289)
  */
-char *
-pan_net_bind_light_to_camera_TX(SOCKET s, unsigned long lid, unsigned long cid, unsigned char en)
+void
+pan_net_bind_light_to_camera_request(SOCKET s, unsigned long lid, unsigned long cid, unsigned char en)
 {
 	int nbytes;
 
@@ -4351,7 +4886,7 @@ pan_net_bind_light_to_camera_TX(SOCKET s, unsigned long lid, unsigned long cid,
 	 * We're sending three ulongs and a bool.
 	 */
 	const int bufsize = 1*4 + 1*4 + 1*4 + 1*1;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4364,6 +4899,11 @@ pan_net_bind_light_to_camera_TX(SOCKET s, unsigned long lid, unsigned long cid,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_bind_light_to_camera_TX(SOCKET s, unsigned long lid, unsigned long cid, unsigned char en)
+{
+	pan_net_bind_light_to_camera_request(s, lid, cid, en);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4382,8 +4922,8 @@ pan_net_bind_light_to_camera_TX(SOCKET s, unsigned long lid, unsigned long cid,
  *
  * IMPLEMENTS ConfigureLightByDegrees (290)
  */
-char *
-pan_net_configure_light_by_degrees_TX(SOCKET s, unsigned long lid, double r, double g, double b, double h, double e)
+void
+pan_net_configure_light_by_degrees_request(SOCKET s, unsigned long lid, double r, double g, double b, double h, double e)
 {
 	int nbytes;
 
@@ -4392,7 +4932,7 @@ pan_net_configure_light_by_degrees_TX(SOCKET s, unsigned long lid, double r, dou
 	 * We're sending 1+16 ulongs/floats.
 	 */
 	const int bufsize = 1*4 + 16*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4410,6 +4950,11 @@ pan_net_configure_light_by_degrees_TX(SOCKET s, unsigned long lid, double r, dou
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_configure_light_by_degrees_TX(SOCKET s, unsigned long lid, double r, double g, double b, double h, double e)
+{
+	pan_net_configure_light_by_degrees_request(s, lid, r, g, b, h, e);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4428,8 +4973,8 @@ pan_net_configure_light_by_degrees_TX(SOCKET s, unsigned long lid, double r, dou
  *
  * IMPLEMENTS ConfigureLightByRadians (291)
  */
-char *
-pan_net_configure_light_by_radians_TX(SOCKET s, unsigned long lid, double r, double g, double b, double h, double e)
+void
+pan_net_configure_light_by_radians_request(SOCKET s, unsigned long lid, double r, double g, double b, double h, double e)
 {
 	int nbytes;
 
@@ -4438,7 +4983,7 @@ pan_net_configure_light_by_radians_TX(SOCKET s, unsigned long lid, double r, dou
 	 * We're sending 1+16 ulongs/floats.
 	 */
 	const int bufsize = 1*4 + 16*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4456,6 +5001,11 @@ pan_net_configure_light_by_radians_TX(SOCKET s, unsigned long lid, double r, dou
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_configure_light_by_radians_TX(SOCKET s, unsigned long lid, double r, double g, double b, double h, double e)
+{
+	pan_net_configure_light_by_radians_request(s, lid, r, g, b, h, e);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4473,8 +5023,8 @@ pan_net_configure_light_by_radians_TX(SOCKET s, unsigned long lid, double r, dou
  *
  * IMPLEMENTS SetLightPositionDirection (292)
  */
-char *
-pan_net_set_light_position_direction_TX(SOCKET s, unsigned long lid, double ox, double oy, double oz, double dx, double dy, double dz)
+void
+pan_net_set_light_position_direction_request(SOCKET s, unsigned long lid, double ox, double oy, double oz, double dx, double dy, double dz)
 {
 	int nbytes;
 
@@ -4483,7 +5033,7 @@ pan_net_set_light_position_direction_TX(SOCKET s, unsigned long lid, double ox,
 	 * We're sending two ulongs and six doubles.
 	 */
 	const int bufsize = 1*4 + 1*4 + 6*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4500,6 +5050,11 @@ pan_net_set_light_position_direction_TX(SOCKET s, unsigned long lid, double ox,
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_light_position_direction_TX(SOCKET s, unsigned long lid, double ox, double oy, double oz, double dx, double dy, double dz)
+{
+	pan_net_set_light_position_direction_request(s, lid, ox, oy, oz, dx, dy, dz);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4515,9 +5070,8 @@ pan_net_set_light_position_direction_TX(SOCKET s, unsigned long lid, double ox,
  *
  * IMPLEMENTS RenderToHoldBuffer (293)
  */
-char *
-pan_net_render_to_hold_buffer_TX
-(
+void
+pan_net_render_to_hold_buffer_request(
 	SOCKET s,
 	unsigned long cid,
 	unsigned long bid
@@ -4530,7 +5084,7 @@ pan_net_render_to_hold_buffer_TX
 	 * We're sending three ulongs.
 	 */
 	const int bufsize = 1*4 + 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4542,6 +5096,15 @@ pan_net_render_to_hold_buffer_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_render_to_hold_buffer_TX(
+	SOCKET s,
+	unsigned long cid,
+	unsigned long bid
+)
+{
+	pan_net_render_to_hold_buffer_request(s, cid, bid);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4557,9 +5120,8 @@ pan_net_render_to_hold_buffer_TX
  *
  * IMPLEMENTS DisplayHoldBuffer (294)
  */
-char *
-pan_net_display_hold_buffer_TX
-(
+void
+pan_net_display_hold_buffer_request(
 	SOCKET s,
 	unsigned long bid
 )
@@ -4571,7 +5133,7 @@ pan_net_display_hold_buffer_TX
 	 * We're sending two ulongs.
 	 */
 	const int bufsize = 1*4 + 1*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4582,6 +5144,14 @@ pan_net_display_hold_buffer_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_display_hold_buffer_TX(
+	SOCKET s,
+	unsigned long bid
+)
+{
+	pan_net_display_hold_buffer_request(s, bid);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4604,9 +5174,8 @@ pan_net_display_hold_buffer_TX
  *
  * IMPLEMENTS SetCornerCubesD (295)
  */
-char *
-pan_net_set_corner_cubes_d_TX
-(
+void
+pan_net_set_corner_cubes_d_request(
 	SOCKET s,
 	unsigned long n,
 	unsigned long fmt,
@@ -4645,6 +5214,16 @@ pan_net_set_corner_cubes_d_TX
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
 	(void)free(buf); buf = 0;
+}
+char *
+pan_net_set_corner_cubes_d_TX(
+	SOCKET s,
+	unsigned long n,
+	unsigned long fmt,
+	double *pcc
+)
+{
+	pan_net_set_corner_cubes_d_request(s, n, fmt, pcc);
 
 	/* Want an Okay response */
 	return pan_net_want(s, MSG_OKAY);
@@ -4660,9 +5239,8 @@ pan_net_set_corner_cubes_d_TX
  *
  * IMPLEMENTS SetProjectionMode (296)
  */
-char *
-pan_net_set_projection_mode_TX
-(
+void
+pan_net_set_projection_mode_request(
 	SOCKET s,
 	unsigned long cid,
 	unsigned long mode
@@ -4675,7 +5253,7 @@ pan_net_set_projection_mode_TX
 	 * We're sending three ulongs.
 	 */
 	const int bufsize = 1*4 + 2*4;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4687,6 +5265,15 @@ pan_net_set_projection_mode_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_projection_mode_TX(
+	SOCKET s,
+	unsigned long cid,
+	unsigned long mode
+)
+{
+	pan_net_set_projection_mode_request(s, cid, mode);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4702,9 +5289,8 @@ pan_net_set_projection_mode_TX
  *
  * IMPLEMENTS SetOrthoFieldOfView (297)
  */
-char *
-pan_net_set_ortho_field_of_view_TX
-(
+void
+pan_net_set_ortho_field_of_view_request(
 	SOCKET s,
 	unsigned long cid,
 	double width,
@@ -4718,7 +5304,7 @@ pan_net_set_ortho_field_of_view_TX
 	 * We're sending two ulongs and two doubles.
 	 */
 	const int bufsize = 1*4 + 1*4 + 2*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4731,6 +5317,16 @@ pan_net_set_ortho_field_of_view_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_ortho_field_of_view_TX(
+	SOCKET s,
+	unsigned long cid,
+	double width,
+	double height
+)
+{
+	pan_net_set_ortho_field_of_view_request(s, cid, width, height);
 
 	/* We want a MSG_OKAY reply */
 	return pan_net_want(s, MSG_OKAY);
@@ -4753,9 +5349,8 @@ pan_net_set_ortho_field_of_view_TX
  *
  * IMPLEMENTS SetLidarScan (298)
  */
-char *
-pan_net_set_lidar_scan_TX
-(
+void
+pan_net_set_lidar_scan_request(
 	SOCKET s,
 	unsigned long n,
 	unsigned long fmt,
@@ -4794,6 +5389,16 @@ pan_net_set_lidar_scan_TX
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
 	(void)free(buf); buf = 0;
+}
+char *
+pan_net_set_lidar_scan_TX(
+	SOCKET s,
+	unsigned long n,
+	unsigned long fmt,
+	double *pls         // pointer to lidar scan samples
+)
+{
+	pan_net_set_lidar_scan_request(s, n, fmt, pls);
 
 	/* Want an Okay response */
 	return pan_net_want(s, MSG_OKAY);
@@ -4815,9 +5420,8 @@ pan_net_set_lidar_scan_TX
  *
  * IMPLEMENTS SetCameraMotion (299)
  */
-char *
-pan_net_set_camera_motion_TX
-(
+void
+pan_net_set_camera_motion_request(
 	SOCKET s,
 	unsigned long cid,
 	double vx, double vy, double vz, /* linear velocity */
@@ -4834,7 +5438,7 @@ pan_net_set_camera_motion_TX
 	 * doubles (ijk).
 	 */
 	const int bufsize = (1+1)*4 + 3*2*3*8;
-	static char buf[bufsize];
+	char buf[bufsize];
 
 	/* Initialise the buffer. */
 	char *p = buf;
@@ -4864,6 +5468,21 @@ pan_net_set_camera_motion_TX
 	/* Write the buffer in one go. */
 	assert(nbytes == bufsize);
 	pan_socket_write(s, buf, nbytes);
+}
+char *
+pan_net_set_camera_motion_TX(
+	SOCKET s,
+	unsigned long cid,
+	double vx, double vy, double vz, /* linear velocity */
+	double rx, double ry, double rz, /* angular velocity */
+	double ax, double ay, double az, /* linear acceleration */
+	double sx, double sy, double sz, /* angular acceleration */
+	double jx, double jy, double jz, /* linear jerk */
+	double tx, double ty, double tz  /* angular jerk */
+)
+{
+	pan_net_set_camera_motion_request(s, cid, vx, vy, vz, rx, ry, rz, ax, ay, az,
+			sx, sy, sz, jx, jy, jz, tx, ty, tz);
 
 	/* Want an Okay response */
 	return pan_net_want(s, MSG_OKAY);
@@ -1362,263 +1362,346 @@ extern void pan_protocol_set_camera_motion(SOCKET, unsigned long, double, double
 extern char *pan_net_safety_checks(void);
 
 extern char *pan_net_want(SOCKET, unsigned long);
+extern char *pan_net_want_r(SOCKET, unsigned long, char *, unsigned long);
 
 extern char *pan_net_start_TX(SOCKET);
+extern void  pan_net_start_request(SOCKET);
 /*           pan_net_start_RX() is not required.  */
 
 extern char *pan_net_finish_TX(SOCKET);
 /*           pan_net_finish_RX() is not required.  */
 
 extern char *         pan_net_get_image_TX(SOCKET, unsigned long *);
+extern void           pan_net_get_image_request(SOCKET);
 extern unsigned char *pan_net_get_image_RX(SOCKET, unsigned long *);
+extern int            pan_net_get_image_RX_into(SOCKET, unsigned char *, unsigned long, unsigned long *);
 
 extern char *pan_net_get_elevation_TX(SOCKET);
+extern void  pan_net_get_elevation_request(SOCKET);
 extern float pan_net_get_elevation_RX(SOCKET, char *);
 
 extern char *pan_net_get_elevations_TX(SOCKET, unsigned long, float *);
+extern void  pan_net_get_elevations_request(SOCKET, unsigned long, float *);
 extern void  pan_net_get_elevations_RX(SOCKET, float *, char *);
 
 extern char *pan_net_lookup_point_TX(SOCKET, float, float);
+extern void  pan_net_lookup_point_request(SOCKET, float, float);
 extern void  pan_net_lookup_point_RX(SOCKET, float *, float *, float *, char *);
 
 extern char *pan_net_lookup_points_TX(SOCKET, unsigned long, float *);
+extern void  pan_net_lookup_points_request(SOCKET, unsigned long, float *);
 extern void  pan_net_lookup_points_RX(SOCKET, float *, char *);
 
 extern char *pan_net_get_point_TX(SOCKET, float, float, float);
+extern void  pan_net_get_point_request(SOCKET, float, float, float);
 extern void  pan_net_get_point_RX(SOCKET, float *, float *, float *, char *);
 
 extern char *pan_net_get_points_TX(SOCKET, unsigned long, float *);
+extern void  pan_net_get_points_request(SOCKET, unsigned long, float *);
 extern void  pan_net_get_points_RX(SOCKET, float *, char *);
 
 extern char *pan_net_echo_TX(SOCKET, void *, unsigned long);
+extern void  pan_net_echo_request(SOCKET, void *, unsigned long);
 extern void *pan_net_echo_RX(SOCKET, unsigned long *);
 
 extern char *         pan_net_get_range_image_TX(SOCKET, float, float);
+extern void           pan_net_get_range_image_request(SOCKET, float, float);
 extern unsigned char *pan_net_get_range_image_RX(SOCKET, unsigned long *);
 
 extern char *         pan_net_get_range_texture_TX(SOCKET);
+extern void           pan_net_get_range_texture_request(SOCKET);
 extern unsigned char *pan_net_get_range_texture_RX(SOCKET, unsigned long *);
 
 extern char *         pan_net_get_viewpoint_by_degrees_s_TX(SOCKET, float, float, float, float, float, float);
+extern void           pan_net_get_viewpoint_by_degrees_s_request(SOCKET, float, float, float, float, float, float);
 extern unsigned char *pan_net_get_viewpoint_by_degrees_s_RX(SOCKET, unsigned long *);
 
 extern char *         pan_net_get_viewpoint_by_quaternion_s_TX(SOCKET, float, float, float, float, float, float, float);
+extern void           pan_net_get_viewpoint_by_quaternion_s_request(SOCKET, float, float, float, float, float, float, float);
 extern unsigned char *pan_net_get_viewpoint_by_quaternion_s_RX(SOCKET, unsigned long *);
 
 extern char *pan_net_get_lidar_pulse_result_TX(SOCKET, float, float, float, float, float, float);
+extern void  pan_net_get_lidar_pulse_result_request(SOCKET, float, float, float, float, float, float);
 extern void  pan_net_get_lidar_pulse_result_RX(SOCKET, float *, float *);
 
 extern char * pan_net_get_lidar_measurement_TX(SOCKET, float,float,float, float,float,float,float, float,float,float, float,float,float, float,float,float, float,float,float, float,float,float, float,float,float);
+extern void   pan_net_get_lidar_measurement_request(SOCKET, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float);
 extern float *pan_net_get_lidar_measurement_RX(SOCKET, float *,float *, unsigned long *,unsigned long *, float *,float *, unsigned long *,unsigned long *, unsigned long *, unsigned long *, float *,float *, float *, float *, float *, float *, float *, float *);
 
 extern char * pan_net_get_radar_response_TX(SOCKET, unsigned long, unsigned long, unsigned long, unsigned long, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float);
+extern void   pan_net_get_radar_response_request(SOCKET, unsigned long, unsigned long, unsigned long, unsigned long, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float);
 extern float *pan_net_get_radar_response_RX(SOCKET, unsigned long *, float *, float *, float *, float *, float *, float *, float *, float *, float *, float *, unsigned long *, unsigned long *, unsigned long *);
 
 extern char *         pan_net_get_viewpoint_by_degrees_d_TX(SOCKET, double, double, double, double, double, double);
 extern unsigned char *pan_net_get_viewpoint_by_degrees_d_RX(SOCKET, unsigned long *);
+extern void           pan_net_get_viewpoint_by_degrees_d_request(SOCKET, double, double, double, double, double, double);
+extern void           pan_net_get_viewpoint_by_degrees_d_queue(struct pan_socket_msg *, double, double, double, double, double, double);
 
 extern char *         pan_net_get_viewpoint_by_quaternion_d_TX(SOCKET, double, double, double, double, double, double, double);
+extern void           pan_net_get_viewpoint_by_quaternion_d_request(SOCKET, double, double, double, double, double, double, double);
 extern unsigned char *pan_net_get_viewpoint_by_quaternion_d_RX(SOCKET, unsigned long *);
 
 extern char *      pan_net_get_joints_TX(SOCKET, unsigned long);
+extern void        pan_net_get_joints_request(SOCKET, unsigned long);
 extern joint_data* pan_net_get_joints_RX(SOCKET, unsigned long*);
 
 extern char *pan_net_get_joint_config_TX(SOCKET, unsigned long, unsigned long);
+extern void  pan_net_get_joint_config_request(SOCKET, unsigned long, unsigned long);
 extern void  pan_net_get_joint_config_RX(SOCKET, double*);
 
 extern char*       pan_net_get_frames_TX(SOCKET, unsigned long);
+extern void        pan_net_get_frames_request(SOCKET, unsigned long);
 extern frame_data* pan_net_get_frames_RX(SOCKET, unsigned long *);
 
 extern char *pan_net_get_frame_TX(SOCKET, unsigned long, unsigned long);
+extern void  pan_net_get_frame_request(SOCKET, unsigned long, unsigned long);
 extern void  pan_net_get_frame_RX(SOCKET, double*);
 
 extern char *pan_net_get_frame_as_radians_TX(SOCKET, unsigned long, unsigned long);
+extern void  pan_net_get_frame_as_radians_request(SOCKET, unsigned long, unsigned long);
 extern void  pan_net_get_frame_as_radians_RX(SOCKET, double*);
 
 extern char *pan_net_get_surface_elevation_TX(SOCKET, unsigned char, float, float);
+extern void  pan_net_get_surface_elevation_request(SOCKET, unsigned char, float, float);
 extern float pan_net_get_surface_elevation_RX(SOCKET, char*);
 
 extern char *pan_net_get_surface_elevations_TX(SOCKET, unsigned char, unsigned long, float *);
+extern void  pan_net_get_surface_elevations_request(SOCKET, unsigned char, unsigned long, float *);
 extern void  pan_net_get_surface_elevations_RX(SOCKET, float*, char*);
 
 extern char *pan_net_get_surface_patch_TX(SOCKET, unsigned char, float, float, unsigned long, unsigned long, float, float);
+extern void  pan_net_get_surface_patch_request(SOCKET, unsigned char, float, float, unsigned long, unsigned long, float, float);
 extern void  pan_net_get_surface_patch_RX(SOCKET, float*, char*);
 
 extern char *         pan_net_get_viewpoint_by_radians_TX(SOCKET, double, double, double, double, double, double);
+extern void           pan_net_get_viewpoint_by_radians_request(SOCKET, double, double, double, double, double, double);
 extern unsigned char *pan_net_get_viewpoint_by_radians_RX(SOCKET, unsigned long *);
 
 extern char * pan_net_quit_TX(SOCKET);
+extern void   pan_net_quit_request(SOCKET);
 /*            pan_net_quit_RX() is not required.  */
 
 extern char *         pan_net_get_viewpoint_by_frame_TX(SOCKET, unsigned long, unsigned long);
+extern void           pan_net_get_viewpoint_by_frame_request(SOCKET, unsigned long, unsigned long);
 extern unsigned char *pan_net_get_viewpoint_by_frame_RX(SOCKET, unsigned long *);
 
 extern char *pan_net_get_camera_properties_TX(SOCKET, unsigned long);
+extern void  pan_net_get_camera_properties_request(SOCKET, unsigned long);
 extern int   pan_net_get_camera_properties_RX(SOCKET, unsigned long *, unsigned long *, double *, double *, double *, double *, double *, double *, double *, double *, double *);
 
 extern char *         pan_net_get_viewpoint_by_camera_TX(SOCKET, unsigned long);
+extern void           pan_net_get_viewpoint_by_camera_request(SOCKET, unsigned long);
 extern unsigned char *pan_net_get_viewpoint_by_camera_RX(SOCKET, unsigned long *);
 
 extern char *pan_net_get_view_as_dem_TX(SOCKET, unsigned long, unsigned char, unsigned long, unsigned long, float, float, float);
+extern void  pan_net_get_view_as_dem_request(SOCKET, unsigned long, unsigned char, unsigned long, unsigned long, float, float, float);
 extern void  pan_net_get_view_as_dem_RX(SOCKET, float*, char*);
 
 extern char  *pan_net_get_lidar_measurement_d_TX(SOCKET, double,double,double, double,double,double,double, double,double,double, double,double,double, double,double,double, double,double,double, double,double,double, double,double,double);
+extern void   pan_net_get_lidar_measurement_d_request(SOCKET, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double);
 extern float *pan_net_get_lidar_measurement_d_RX(SOCKET, float *,float *, unsigned long *,unsigned long *, float *,float *, unsigned long *,unsigned long *, unsigned long *, unsigned long *, float *,float *, float *, float *, float *, float *, float *, float *);
 
 extern char * pan_net_get_time_tag_TX(SOCKET);
+extern void   pan_net_get_time_tag_request(SOCKET);
 extern double pan_net_get_time_tag_RX(SOCKET, char *);
 
 extern char  *pan_net_get_lidar_measurement_s_TX(SOCKET, float,float,float, float,float,float,float, float,float,float, float,float,float, float,float,float, float,float,float, float,float,float, float,float,float);
+extern void   pan_net_get_lidar_measurement_s_request(SOCKET, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float, float);
 extern float *pan_net_get_lidar_measurement_s_RX(SOCKET, float *,float *, unsigned long *,unsigned long *, float *,float *, unsigned long *,unsigned long *, unsigned long *, unsigned long *, float *,float *, float *, float *, float *, float *, float *, float *);
 
 extern char  *pan_net_get_lidar_snapshot_TX(SOCKET, unsigned long, double, double, double, double, double, double, double);
+extern void   pan_net_get_lidar_snapshot_request(SOCKET, unsigned long, double, double, double, double, double, double, double);
 extern float *pan_net_get_lidar_snapshot_RX(SOCKET, unsigned long *, unsigned long *);
 
 extern char *pan_net_set_viewpoint_by_degrees_s_TX(SOCKET, float, float, float, float, float, float);
+extern void  pan_net_set_viewpoint_by_degrees_s_request(SOCKET, float, float, float, float, float, float);
 /*           pan_net_set_viewpoint_by_degrees_s_RX() is not required.  */
 
 extern char *pan_net_set_viewpoint_by_quaternion_s_TX(SOCKET, float, float, float, float, float, float, float);
+extern void  pan_net_set_viewpoint_by_quaternion_s_request(SOCKET, float, float, float, float, float, float, float);
 /*           pan_net_set_viewpoint_by_quaternion_s_RX() is not required.  */
 
 extern char *pan_net_set_ambient_light_TX(SOCKET, float, float, float);
+extern void  pan_net_set_ambient_light_request(SOCKET, float, float, float);
 /*           pan_net_set_ambient_light_RX() is not required.  */
 
 extern char *pan_net_set_sun_colour_TX(SOCKET, float, float, float);
+extern void  pan_net_set_sun_colour_request(SOCKET, float, float, float);
 /*           pan_net_set_sun_colour_RX() is not required.  */
 
 extern char *pan_net_set_sky_type_TX(SOCKET, unsigned long);
+extern void  pan_net_set_sky_type_request(SOCKET, unsigned long);
 /*           pan_net_set_sky_type_RX() is not required.  */
 
 extern char *pan_net_set_field_of_view_by_degrees_TX(SOCKET, float);
+extern void  pan_net_set_field_of_view_by_degrees_request(SOCKET, float);
 /*           pan_net_set_field_of_view_by_degrees_RX() is not required.  */
 
 extern char *pan_net_set_field_of_view_TX(SOCKET, float);
 /*           pan_net_set_field_of_view_RX() is not required.  */
 
 extern char *pan_net_set_aspect_ratio_TX(SOCKET, float);
+extern void  pan_net_set_aspect_ratio_request(SOCKET, float);
 /*           pan_net_set_aspect_ratio_RX() is not required.  */
 
 extern char *pan_net_set_boulder_view_TX(SOCKET, unsigned long, int);
+extern void  pan_net_set_boulder_view_request(SOCKET, unsigned long, int);
 /*           pan_net_set_boulder_view_RX() is not required.  */
 
 extern char *pan_net_set_surface_view_TX(SOCKET, unsigned long, int, int);
+extern void  pan_net_set_surface_view_request(SOCKET, unsigned long, int, int);
 /*           pan_net_set_surface_view_RX() is not required.  */
 
 extern char *pan_net_set_lidar_parameters_TX(SOCKET, float, float, unsigned long, unsigned long, float, float, unsigned long, unsigned long, unsigned long, unsigned long, float, float, float, float, float, float, float, float, float, float);
+extern void  pan_net_set_lidar_parameters_request(SOCKET, float, float, unsigned long, unsigned long, float, float, unsigned long, unsigned long, unsigned long, unsigned long, float, float, float, float, float, float, float, float, float, float);
 /*           pan_net_set_lidar_parameters_RX() is not required.  */
 
 extern char *pan_net_set_corner_cubes_s_TX(SOCKET, unsigned long, unsigned long, float *);
+extern void  pan_net_set_corner_cubes_s_request(SOCKET, unsigned long, unsigned long, float *);
 /*           pan_net_set_corner_cubes_s_RX() is not required.  */
 
 extern char *pan_net_set_corner_cubes_TX(SOCKET, unsigned long, unsigned long, float *);
 /*           pan_net_set_corner_cubes_RX() is not required.  */
 
 extern char *pan_net_set_corner_cube_attitude_TX(SOCKET, float, float, float, float, float, float, float, float, float, float, float, float, float);
+extern void  pan_net_set_corner_cube_attitude_request(SOCKET, float, float, float, float, float, float, float, float, float, float, float, float, float);
 /*           pan_net_set_corner_cube_attitude_RX() is not required.  */
 
 extern char *pan_net_set_viewpoint_by_degrees_d_TX(SOCKET, double, double, double, double, double, double);
+extern void  pan_net_set_viewpoint_by_degrees_d_request(SOCKET, double, double, double, double, double, double);
 /*           pan_net_set_viewpoint_by_degrees_d_RX() is not required.  */
 
 extern char *pan_net_set_viewpoint_by_angle_d_TX(SOCKET, double, double, double, double, double, double);
 /*           pan_net_set_viewpoint_by_angle_d_RX() is not required.  */
 
 extern char *pan_net_set_viewpoint_by_quaternion_d_TX(SOCKET, double, double, double, double, double, double, double);
+extern void  pan_net_set_viewpoint_by_quaternion_d_request(SOCKET, double, double, double, double, double, double, double);
 /*           pan_net_set_viewpoint_by_quaternion_d_RX() is not required.  */
 
 extern char *pan_net_set_object_position_attitude_TX(SOCKET, unsigned long, double, double, double, double, double, double, double);
+extern void  pan_net_set_object_position_attitude_request(SOCKET, unsigned long, double, double, double, double, double, double, double);
 /*           pan_net_set_object_position_attitude_RX() is not required.  */
 
 extern char *pan_net_set_object_position_TX(SOCKET, unsigned long, double, double, double, double, double, double, double);
 /*           pan_net_set_object_position_RX() is not required.  */
 
 extern char *pan_net_set_sun_by_degrees_TX(SOCKET, double, double, double);
+extern void  pan_net_set_sun_by_degrees_request(SOCKET, double, double, double);
 /*           pan_net_set_sun_by_degrees_RX() is not required.  */
 
 extern char *pan_net_set_sun_position_TX(SOCKET, double, double, double);
 /*           pan_net_set_sun_position_RX() is not required.  */
 
 extern char *pan_net_set_joint_config_TX(SOCKET, unsigned long, unsigned long, double[9]);
+extern void  pan_net_set_joint_config_request(SOCKET, unsigned long, unsigned long, double *);
 /*           pan_net_set_joint_config_RX() is not required.  */
 
 extern char *pan_net_set_star_quaternion_TX(SOCKET, double, double, double, double);
+extern void  pan_net_set_star_quaternion_request(SOCKET, double, double, double, double);
 /*           pan_net_set_star_quaternion_RX() is not required.  */
 
 extern char *pan_net_set_star_magnitudes_TX(SOCKET, double);
+extern void  pan_net_set_star_magnitudes_request(SOCKET, double);
 /*           pan_net_set_star_magnitudes_RX() is not required.  */
 
 extern char *pan_net_set_secondary_by_degrees_TX(SOCKET, double, double, double);
+extern void  pan_net_set_secondary_by_degrees_request(SOCKET, double, double, double);
 /*           pan_net_set_lidar_scan_RX() is not required.  */
 
 extern char *pan_net_set_global_time_TX(SOCKET s, double t);
+extern void  pan_net_set_global_time_request(SOCKET, double);
 /*           pan_net_set_global_time_RX() is not required.  */
 
 extern char *pan_net_set_object_view_TX(SOCKET, unsigned long, unsigned long);
+extern void  pan_net_set_object_view_request(SOCKET, unsigned long, unsigned long);
 /*           pan_net_set_object_view_RX() is not required.  */
 
 extern char *pan_net_set_viewpoint_by_radians_TX(SOCKET, double, double, double, double, double, double);
+extern void  pan_net_set_viewpoint_by_radians_request(SOCKET, double, double, double, double, double, double);
 /*           pan_net_set_viewpoint_by_radians_RX() is not required.  */
 
 extern char *pan_net_set_field_of_view_by_radians_TX(SOCKET, float);
+extern void  pan_net_set_field_of_view_by_radians_request(SOCKET, float);
 /*           pan_net_set_field_of_view_by_radians_RX() is not required.  */
 
 extern char *pan_net_set_sun_by_radians_TX(SOCKET, double, double, double);
+extern void  pan_net_set_sun_by_radians_request(SOCKET, double, double, double);
 /*           pan_net_set_sun_by_radians_RX() is not required.  */
 
 extern char *pan_net_set_secondary_by_radians_TX(SOCKET, double, double, double);
+extern void  pan_net_set_secondary_by_radians_request(SOCKET, double, double, double);
 /*           pan_net_set_secondary_by_radians_RX() is not required.  */
 
 extern char *pan_net_set_sky_rgb_TX(SOCKET, float, float, float);
+extern void  pan_net_set_sky_rgb_request(SOCKET, float, float, float);
 /*           pan_net_set_sky_rgb_RX() is not required.  */
 
 extern char *pan_net_set_sky_cie_TX(SOCKET, float, float, float);
+extern void  pan_net_set_sky_cie_request(SOCKET, float, float, float);
 /*           pan_net_set_sky_cie_RX() is not required.  */
 
 extern char *pan_net_set_atmosphere_tau_TX(SOCKET, float, float, float, float, float, float);
+extern void  pan_net_set_atmosphere_tau_request(SOCKET, float, float, float, float, float, float);
 /*           pan_net_set_atmosphere_tau_RX() is not required.  */
 
 extern char *pan_net_set_global_fog_mode_TX(SOCKET, unsigned long);
+extern void  pan_net_set_global_fog_mode_request(SOCKET, unsigned long);
 /*           pan_net_set_global_fog_mode_RX() is not required.  */
 
 extern char *pan_net_set_global_fog_properties_TX(SOCKET, double, double, double, double);
+extern void  pan_net_set_global_fog_properties_request(SOCKET, double, double, double, double);
 /*           pan_net_set_global_fog_properties_RX() is not required.  */
 
 extern char *pan_net_set_atmosphere_mode_TX(SOCKET, unsigned long, unsigned long, unsigned long);
+extern void  pan_net_set_atmosphere_mode_request(SOCKET, unsigned long, unsigned long, unsigned long);
 /*           pan_net_set_atmosphere_mode_RX() is not required.  */
 
 extern char *pan_net_select_camera_TX(SOCKET, unsigned long);
+extern void  pan_net_select_camera_request(SOCKET, unsigned long);
 /*           pan_net_select_camera_RX() is not required.  */
 
 extern char *pan_net_bind_light_to_camera_TX(SOCKET, unsigned long, unsigned long, unsigned char);
+extern void  pan_net_bind_light_to_camera_request(SOCKET, unsigned long, unsigned long, unsigned char);
 /*           pan_net_bind_light_to_camera_RX() is not required.  */
 
 extern char *pan_net_configure_light_by_degrees_TX(SOCKET, unsigned long, double, double, double, double, double);
+extern void  pan_net_configure_light_by_degrees_request(SOCKET, unsigned long, double, double, double, double, double);
 /*           pan_net_configure_light_by_degrees_RX() is not required.  */
 
 extern char *pan_net_configure_light_by_radians_TX(SOCKET, unsigned long, double, double, double, double, double);
+extern void  pan_net_configure_light_by_radians_request(SOCKET, unsigned long, double, double, double, double, double);
 /*           pan_net_configure_light_by_radians_RX() is not required.  */
 
 extern char *pan_net_set_light_position_direction_TX(SOCKET, unsigned long, double, double, double, double, double, double);
+extern void  pan_net_set_light_position_direction_request(SOCKET, unsigned long, double, double, double, double, double, double);
 /*           pan_net_set_light_position_direction_RX() is not required.  */
 
 extern char *pan_net_render_to_hold_buffer_TX(SOCKET, unsigned long, unsigned long);
+extern void  pan_net_render_to_hold_buffer_request(SOCKET, unsigned long, unsigned long);
 /*           pan_net_render_to_hold_buffer_RX() is not required.  */
 
 extern char *pan_net_display_hold_buffer_TX(SOCKET, unsigned long);
+extern void  pan_net_display_hold_buffer_request(SOCKET, unsigned long);
 /*           pan_net_display_hold_buffer_RX() is not required.  */
 
 extern char *pan_net_set_corner_cubes_d_TX(SOCKET, unsigned long, unsigned long, double *);
+extern void  pan_net_set_corner_cubes_d_request(SOCKET, unsigned long, unsigned long, double *);
 /*           pan_net_set_corner_cubes_d_RX() is not required.  */
 
 extern char *pan_net_set_projection_mode_TX(SOCKET, unsigned long, unsigned long);
+extern void  pan_net_set_projection_mode_request(SOCKET, unsigned long, unsigned long);
 /*           pan_net_set_projection_mode_RX() is not required.  */
 
 extern char *pan_net_set_ortho_field_of_view_TX(SOCKET, unsigned long, double, double);
+extern void  pan_net_set_ortho_field_of_view_request(SOCKET, unsigned long, double, double);
 /*           pan_net_set_ortho_field_of_view_RX() is not required.  */
 
 extern char *pan_net_set_lidar_scan_TX(SOCKET, unsigned long, unsigned long, double *);
+extern void  pan_net_set_lidar_scan_request(SOCKET, unsigned long, unsigned long, double *);
 /*           pan_net_set_lidar_scan_RX() is not required.  */
 
 extern char *pan_net_set_camera_motion_TX(SOCKET, unsigned long, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double);
+extern void  pan_net_set_camera_motion_request(SOCKET, unsigned long, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double);
 /*           pan_net_set_camera_motion_RX() is not required.  */
 
 #endif
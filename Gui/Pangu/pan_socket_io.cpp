@@ -61,10 +61,15 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <assert.h>
 
 // For uint32_t (don't use cstdint which is different)
 #include <stdint.h>
 
+#ifndef _WIN32
+#include <netinet/tcp.h>
+#endif
+
 #include "pan_socket_io.h"
 #include "pangu_endian.h"
 #include "floating_point_structs.h"
@@ -466,19 +471,19 @@ pan_socket_write_string(SOCKET s, char *v)
 
 	/* We pad to even. */
 	unsigned short xlen = slen + (slen & 1);
-	unsigned char pad = 0;
 
-	/* Write the length. */
-	status = pan_socket_write_ushort(s, xlen);
-	if (status < 0) return status;
-
-	/* Write the string and its terminator */
-	status = pan_socket_write(s, v, slen);
+	/*
+	 * Poke the length, string and pad into one buffer so they go out
+	 * in a single write. Short strings avoid the heap.
+	 */
+	char local[256];
+	char *buf = (xlen + 2 <= (int)sizeof(local)) ? local : (char *)malloc(xlen + 2);
+	if (!buf) return -1;
+	char *p = pan_socket_poke_string(buf, v);
+	status = pan_socket_write(s, buf, p - buf);
+	if (buf != local) (void)free(buf);
 	if (status < 0) return status;
 
-	/* Write the pad byte if required. */
-	if (xlen != slen) pan_socket_write_uchar(s, pad);
-
 	/* Return the number of bytes written. */
 	return slen + sizeof(slen);
 }
@@ -588,6 +593,99 @@ pan_socket_poke(char *dst, void *src, unsigned long n)
 }
 
 
+/*
+ * pan_socket_set_nodelay(s) disables Nagle's algorithm on socket "s" so
+ * small messages are sent straight away. Returns zero on success.
+ */
+int
+pan_socket_set_nodelay(SOCKET s)
+{
+	int on = 1;
+	return setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (const char *)&on, sizeof(on));
+}
+
+
+  //=====================================================================//
+ //                           message builder                           //
+//=====================================================================//
+
+/*
+ * pan_socket_msg_init(m, s) prepares the empty builder "m" for socket "s".
+ */
+void
+pan_socket_msg_init(struct pan_socket_msg *m, SOCKET s)
+{
+	m->s = s;
+	m->buf = NULL;
+	m->size = 0;
+	m->capacity = 0;
+}
+
+
+/*
+ * pan_socket_msg_free(m) releases the buffer of "m", discarding anything
+ * that has not been flushed.
+ */
+void
+pan_socket_msg_free(struct pan_socket_msg *m)
+{
+	(void)free(m->buf);
+	m->buf = NULL;
+	m->size = 0;
+	m->capacity = 0;
+}
+
+
+/*
+ * pan_socket_msg_reserve(m, n) returns a pointer to the first free byte
+ * of "m" with room for at least "n" bytes after it, growing the buffer
+ * when needed. The buffer never shrinks so a builder that is reused for
+ * the same messages stops allocating after the first few.
+ */
+char *
+pan_socket_msg_reserve(struct pan_socket_msg *m, unsigned long n)
+{
+	if (m->size + n > m->capacity)
+	{
+		unsigned long capacity = m->capacity ? m->capacity : 256;
+		while (capacity < m->size + n) capacity *= 2;
+
+		char *buf = (char *)realloc(m->buf, capacity);
+		if (!buf) return NULL;
+		m->buf = buf;
+		m->capacity = capacity;
+	}
+	return m->buf + m->size;
+}
+
+
+/*
+ * pan_socket_msg_commit(m, p) queues everything poked into "m" before "p",
+ * which must lie within the space handed out by pan_socket_msg_reserve().
+ */
+void
+pan_socket_msg_commit(struct pan_socket_msg *m, char *p)
+{
+	assert(p >= m->buf + m->size && p <= m->buf + m->capacity);
+	m->size = p - m->buf;
+}
+
+
+/*
+ * pan_socket_msg_flush(m) writes all queued bytes of "m" to its socket in
+ * one call and empties the builder. Returns the number of bytes written.
+ */
+int
+pan_socket_msg_flush(struct pan_socket_msg *m)
+{
+	if (m->size == 0) return 0;
+
+	int status = pan_socket_write(m->s, m->buf, m->size);
+	m->size = 0;
+	return status;
+}
+
+
   //=====================================================================//
  //                PANGU floating point encoding/decoding               //
 //=====================================================================//
@@ -160,6 +160,68 @@ extern char *pan_socket_poke(char *, void *, unsigned long);
 	 * returns a pointer to the location after the last byte written.
 	 */
 
+extern int pan_socket_set_nodelay(SOCKET);
+	/*
+	 * pan_socket_set_nodelay(s) disables Nagle's algorithm on socket "s"
+	 * so that each message is sent as soon as it is written rather than
+	 * held back waiting for the reply to the previous one. Returns zero
+	 * on success.
+	 */
+
+
+/*
+ * Message builder. Fields are poked into a buffer owned by the builder
+ * and every message queued since the last flush goes out in a single
+ * pan_socket_write(). Keep one builder per connection and reuse it: the
+ * buffer only grows so steady state messages need no allocation.
+ *
+ *     char *p = pan_socket_msg_reserve(&m, 1*4 + 2*8);
+ *     p = pan_socket_poke_ulong(p, code);
+ *     p = pan_socket_poke_double(p, x);
+ *     p = pan_socket_poke_double(p, y);
+ *     pan_socket_msg_commit(&m, p);
+ *     pan_socket_msg_flush(&m);
+ */
+struct pan_socket_msg
+{
+	SOCKET s;
+	char *buf;
+	unsigned long size;
+	unsigned long capacity;
+};
+
+extern void pan_socket_msg_init(struct pan_socket_msg *, SOCKET);
+	/*
+	 * pan_socket_msg_init(m, s) prepares the empty builder "m" to send
+	 * messages to the socket "s".
+	 */
+
+extern void pan_socket_msg_free(struct pan_socket_msg *);
+	/*
+	 * pan_socket_msg_free(m) releases the buffer of builder "m" without
+	 * sending anything still queued in it.
+	 */
+
+extern char *pan_socket_msg_reserve(struct pan_socket_msg *, unsigned long);
+	/*
+	 * pan_socket_msg_reserve(m, n) makes room for at least "n" more bytes
+	 * in builder "m" and returns a pointer to the first free byte, ready
+	 * for pan_socket_poke_*(). Returns NULL if the buffer cannot grow.
+	 */
+
+extern void pan_socket_msg_commit(struct pan_socket_msg *, char *);
+	/*
+	 * pan_socket_msg_commit(m, p) queues the bytes poked into builder "m"
+	 * up to, but not including, "p".
+	 */
+
+extern int pan_socket_msg_flush(struct pan_socket_msg *);
+	/*
+	 * pan_socket_msg_flush(m) writes every queued byte of builder "m"
+	 * in one pan_socket_write() and empties it. Returns the number of
+	 * bytes written.
+	 */
+
 extern unsigned long float2ulong(float);
 	/*
 	 * Convert a normalised single-precision float into our own
@@ -0,0 +1,815 @@
+#include <stdexcept>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pangu_connection.hpp"
+
+bool parse_pangu_endpoints(const std::string &list, std::vector<PanguEndpoint> &endpoints) {
+	std::vector<PanguEndpoint> parsed;
+	size_t begin = 0;
+	while(begin <= list.size()) {
+		size_t end = list.find(',', begin);
+		if(end == std::string::npos) {
+			end = list.size();
+		}
+
+		const std::string entry = list.substr(begin, end - begin);
+		const size_t colon = entry.rfind(':');
+		const std::string host = entry.substr(0, colon);
+		if(host.empty()) {
+			return false;
+		}
+
+		ulong port = 10363;
+		if(colon != std::string::npos) {
+			const std::string port_str = entry.substr(colon + 1);
+			char *port_end = nullptr;
+			port = strtoul(port_str.c_str(), &port_end, 10);
+			if(port_str.empty() || *port_end != '\0' || port == 0 || port > 65535) {
+				return false;
+			}
+		}
+
+		parsed.push_back(PanguEndpoint(host, (ushort)port));
+		begin = end + 1;
+	}
+
+	endpoints = parsed;
+	return true;
+}
+
+/* Winsock is reference counted, every connection starts it and cleans it up
+once. Other platforms need no set up */
+static bool socket_startup() {
+#ifdef _WIN32
+	WSAData wsaData;
+	return WSAStartup(MAKEWORD(1, 1), &wsaData) == 0;
+#else
+	return true;
+#endif
+}
+
+static void socket_cleanup() {
+#ifdef _WIN32
+	WSACleanup();
+#endif
+}
+
+PanguConnection::PanguConnection(const PanguEndpoint &endpoint) {
+	error[0] = '\0';
+
+	if(!socket_startup()) {
+		throw std::runtime_error("Failed to initialise winsock 1.1");
+	}
+
+	/* Get IP address of the server */
+	long ip_addr = host_id_to_address(endpoint.host.c_str());
+
+	/* Create a TCP/IP socket */
+	sock = ::socket(AF_INET, SOCK_STREAM, 0);
+	if(sock == -1) {
+		socket_cleanup();
+		throw std::runtime_error("Failed to create socket");
+	}
+
+	/* Connect the socket to the remote server */
+	struct sockaddr_in sock_addr;
+	sock_addr.sin_family = AF_INET;
+	sock_addr.sin_addr.s_addr = ip_addr;
+	sock_addr.sin_port = htons(endpoint.port);
+	ulong sock_addr_len = sizeof(struct sockaddr_in);
+	if(connect(sock, (struct sockaddr *)&sock_addr, sock_addr_len) == -1) {
+		SOCKET_CLOSE(sock);
+		socket_cleanup();
+		throw std::runtime_error("Failed to connect to server");
+	}
+
+	/* Requests are small and each is followed by a wait for its reply, so
+	send them without waiting on Nagle's algorithm */
+	pan_socket_set_nodelay(sock);
+	pan_socket_msg_init(&message, sock);
+
+	/* Start the PANGU network communications protocol */
+	try {
+		start();
+	} catch(...) {
+		pan_socket_msg_free(&message);
+		SOCKET_CLOSE(sock);
+		socket_cleanup();
+		throw;
+	}
+}
+
+PanguConnection::~PanguConnection() {
+	finish();
+	pan_socket_msg_free(&message);
+	SOCKET_CLOSE(sock);
+	socket_cleanup();
+}
+
+void PanguConnection::expect(unsigned long want) {
+	if(pan_net_want_r(sock, want, error, sizeof(error))) {
+		throw std::runtime_error(error);
+	}
+}
+
+void PanguConnection::queue_viewpoint_by_degrees_d(double x, double y, double z, double yw, double pi, double rl) {
+	pan_net_get_viewpoint_by_degrees_d_queue(&message, x, y, z, yw, pi, rl);
+}
+
+void PanguConnection::flush() {
+	pan_socket_msg_flush(&message);
+}
+
+bool PanguConnection::receive_image_into(uchar *buffer, size_t capacity, size_t &size) {
+	expect(MSG_IMAGE);
+
+	ulong received_size;
+	const bool received = pan_net_get_image_RX_into(sock, buffer, (ulong)capacity, &received_size) != 0;
+	size = received_size;
+	return received;
+}
+
+const uchar * PanguConnection::render_image(size_t &size) {
+	pan_net_get_image_request(sock);
+	expect(MSG_IMAGE);
+
+	/* Size the buffer from the reply then read the image into it */
+	long image_size;
+	pan_socket_read_long(sock, &image_size);
+	image.resize(image_size + 1);
+	pan_socket_read(sock, image.data(), image_size);
+	size = image_size;
+	return image.data();
+}
+
+unsigned char * PanguConnection::get_image(unsigned long *psize) {
+	pan_net_get_image_request(sock);
+	expect(MSG_IMAGE);
+	return pan_net_get_image_RX(sock, psize);
+}
+
+float PanguConnection::get_elevation(char *perr) {
+	pan_net_get_elevation_request(sock);
+	expect(MSG_FLOAT);
+	return pan_net_get_elevation_RX(sock, perr);
+}
+
+void PanguConnection::get_elevations(unsigned long n, float *posv, float *resultv, char *errorv) {
+	pan_net_get_elevations_request(sock, n, posv);
+	expect(MSG_FLOAT_ARRAY);
+	pan_net_get_elevations_RX(sock, resultv, errorv);
+}
+
+void PanguConnection::lookup_point(float x, float y, float *px, float *py, float *pz, char *perr) {
+	pan_net_lookup_point_request(sock, x, y);
+	expect(MSG_3D_POINT);
+	pan_net_lookup_point_RX(sock, px, py, pz, perr);
+}
+
+void PanguConnection::lookup_points(unsigned long n, float *posv, float *resultv, char *errorv) {
+	pan_net_lookup_points_request(sock, n, posv);
+	expect(MSG_3D_POINT_ARRAY);
+	pan_net_lookup_points_RX(sock, resultv, errorv);
+}
+
+void PanguConnection::get_point(float dx, float dy, float dz, float *px, float *py, float *pz, char *perr) {
+	pan_net_get_point_request(sock, dx, dy, dz);
+	expect(MSG_3D_POINT);
+	pan_net_get_point_RX(sock, px, py, pz, perr);
+}
+
+void PanguConnection::get_points(unsigned long n, float *posv, float *resultv, char *errorv) {
+	pan_net_get_points_request(sock, n, posv);
+	expect(MSG_3D_POINT_ARRAY);
+	pan_net_get_points_RX(sock, resultv, errorv);
+}
+
+void * PanguConnection::echo(void *src, unsigned long n, unsigned long *psize) {
+	pan_net_echo_request(sock, src, n);
+	expect(MSG_ECHO_REPLY);
+	return pan_net_echo_RX(sock, psize);
+}
+
+unsigned char * PanguConnection::get_range_image(unsigned long *psize, float offset, float scale) {
+	pan_net_get_range_image_request(sock, offset, scale);
+	expect(MSG_IMAGE);
+	return pan_net_get_range_image_RX(sock, psize);
+}
+
+unsigned char * PanguConnection::get_range_texture(unsigned long *psize) {
+	pan_net_get_range_texture_request(sock);
+	expect(MSG_IMAGE);
+	return pan_net_get_range_texture_RX(sock, psize);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_degrees_s(float x, float y, float z, float yw, float pi, float rl, unsigned long *psize) {
+	pan_net_get_viewpoint_by_degrees_s_request(sock, x, y, z, yw, pi, rl);
+	expect(MSG_IMAGE);
+	return pan_net_get_viewpoint_by_degrees_s_RX(sock, psize);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_angle(float x, float y, float z, float yw, float pi, float rl, unsigned long *psize) {
+	return get_viewpoint_by_degrees_s(x, y, z, yw, pi, rl, psize);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_angle_s(float x, float y, float z, float yw, float pi, float rl, unsigned long *sz) {
+	return get_viewpoint_by_degrees_s(x, y, z, yw, pi, rl, sz);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_quaternion_s(float x, float y, float z, float q0, float q1, float q2, float q3, unsigned long *psize) {
+	pan_net_get_viewpoint_by_quaternion_s_request(sock, x, y, z, q0, q1, q2, q3);
+	expect(MSG_IMAGE);
+	return pan_net_get_viewpoint_by_quaternion_s_RX(sock, psize);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_quaternion(float x, float y, float z, float q0, float q1, float q2, float q3, unsigned long *psize) {
+	return get_viewpoint_by_quaternion_s(x, y, z, q0, q1, q2, q3, psize);
+}
+
+void PanguConnection::get_lidar_pulse_result(float x, float y, float z, float dx, float dy, float dz, float *pr, float *pa) {
+	pan_net_get_lidar_pulse_result_request(sock, x, y, z, dx, dy, dz);
+	expect(MSG_LIDAR_PULSE_RESULT);
+	pan_net_get_lidar_pulse_result_RX(sock, pr, pa);
+}
+
+float * PanguConnection::get_lidar_measurement(
+	float px, float py, float pz,
+	float q0, float q1, float q2, float q3,
+	float vx, float vy, float vz,
+	float rx, float ry, float rz,
+	float ax, float ay, float az,
+	float sx, float sy, float sz,
+	float jx, float jy, float jz,
+	float tx, float ty, float tz,
+	float *pfx, float *pfy,
+	unsigned long *pnx, unsigned long *pny,
+	float *ptx, float *pty,
+	unsigned long *pn, unsigned long *pm,
+	unsigned long *pt, unsigned long *pfl,
+	float *paz, float *pel, float *pth,
+	float *pfaz, float *pfel,
+	float *ptoff, float *ptaz0, float *ptel0)
+{
+	pan_net_get_lidar_measurement_request(
+		sock, px, py, pz, q0, q1, q2, q3, vx, vy, vz, rx, ry, rz, ax, ay, az, sx, sy, sz,
+		jx, jy, jz, tx, ty, tz
+	);
+	expect(MSG_LIDAR_MEASUREMENT);
+	return pan_net_get_lidar_measurement_RX(
+		sock, pfx, pfy, pnx, pny, ptx, pty, pn, pm, pt, pfl, paz, pel, pth, pfaz, pfel,
+		ptoff, ptaz0, ptel0
+	);
+}
+
+float * PanguConnection::get_radar_response(
+	unsigned long flags,
+	unsigned long n,
+	unsigned long nr, unsigned long ns,
+	float ox, float oy, float oz,
+	float vx, float vy, float vz,
+	float q0, float q1, float q2, float q3,
+	float bwidth,
+	float rmid, float smid,
+	float rbs, float sbs,
+	unsigned long *pstat,
+	float *pmaxv, float *ptotv,
+	float *poffr, float *poffs,
+	float *prbsize, float *psbsize,
+	float *pminr, float *pmaxr,
+	float *pmins, float *pmaxs,
+	unsigned long *pnrelts, unsigned long *pnselts,
+	unsigned long *pnused)
+{
+	pan_net_get_radar_response_request(
+		sock, flags, n, nr, ns, ox, oy, oz, vx, vy, vz, q0, q1, q2, q3, bwidth, rmid, smid,
+		rbs, sbs
+	);
+	expect(MSG_RADAR_RESPONSE);
+	return pan_net_get_radar_response_RX(
+		sock, pstat, pmaxv, ptotv, poffr, poffs, prbsize, psbsize, pminr, pmaxr, pmins,
+		pmaxs, pnrelts, pnselts, pnused
+	);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_degrees_d(double x, double y, double z, double yw, double pi, double rl, unsigned long *psize) {
+	pan_net_get_viewpoint_by_degrees_d_request(sock, x, y, z, yw, pi, rl);
+	expect(MSG_IMAGE);
+	return pan_net_get_viewpoint_by_degrees_d_RX(sock, psize);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_angle_d(double x, double y, double z, double yw, double pi, double rl, unsigned long *sz) {
+	return get_viewpoint_by_degrees_d(x, y, z, yw, pi, rl, sz);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_quaternion_d(double x, double y, double z, double q0, double q1, double q2, double q3, unsigned long *psize) {
+	pan_net_get_viewpoint_by_quaternion_d_request(sock, x, y, z, q0, q1, q2, q3);
+	expect(MSG_IMAGE);
+	return pan_net_get_viewpoint_by_quaternion_d_RX(sock, psize);
+}
+
+joint_data * PanguConnection::get_joints(unsigned long o, unsigned long *n) {
+	pan_net_get_joints_request(sock, o);
+	expect(MSG_JOINT_LIST);
+	return pan_net_get_joints_RX(sock, n);
+}
+
+void PanguConnection::get_joint_config(unsigned long obj, unsigned long joint, double *config) {
+	pan_net_get_joint_config_request(sock, obj, joint);
+	expect(MSG_DOUBLE_ARRAY);
+	pan_net_get_joint_config_RX(sock, config);
+}
+
+frame_data * PanguConnection::get_frames(unsigned long obj, unsigned long *n) {
+	pan_net_get_frames_request(sock, obj);
+	expect(MSG_FRAME_LIST);
+	return pan_net_get_frames_RX(sock, n);
+}
+
+void PanguConnection::get_frame(unsigned long obj, unsigned long id, double *data) {
+	pan_net_get_frame_request(sock, obj, id);
+	expect(MSG_DOUBLE_ARRAY);
+	pan_net_get_frame_RX(sock, data);
+}
+
+void PanguConnection::get_frame_as_radians(unsigned long obj, unsigned long id, double *data) {
+	pan_net_get_frame_as_radians_request(sock, obj, id);
+	expect(MSG_DOUBLE_ARRAY);
+	pan_net_get_frame_as_radians_RX(sock, data);
+}
+
+void PanguConnection::get_frame_viewpoint_by_angle(unsigned long o, unsigned long i, double* v) {
+	get_frame_as_radians(o, i, v);
+}
+
+float PanguConnection::get_surface_elevation(unsigned char boulders, float x, float y, char *err) {
+	pan_net_get_surface_elevation_request(sock, boulders, x, y);
+	expect(MSG_FLOAT);
+	return pan_net_get_surface_elevation_RX(sock, err);
+}
+
+void PanguConnection::get_surface_elevations(
+	unsigned char boulders,
+	unsigned long n,
+	float *posv,
+	float *resultv,
+	char *errorv)
+{
+	pan_net_get_surface_elevations_request(sock, boulders, n, posv);
+	expect(MSG_FLOAT_ARRAY);
+	pan_net_get_surface_elevations_RX(sock, resultv, errorv);
+}
+
+void PanguConnection::get_surface_patch(
+	unsigned char boulders,
+	float cx, float cy,
+	unsigned long nx, unsigned long ny,
+	float d,
+	float theta,
+	float *rv,
+	char *ev)
+{
+	pan_net_get_surface_patch_request(sock, boulders, cx, cy, nx, ny, d, theta);
+	expect(MSG_FLOAT_ARRAY);
+	pan_net_get_surface_patch_RX(sock, rv, ev);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_radians(double x, double y, double z, double yw, double pi, double rl, unsigned long *psize) {
+	pan_net_get_viewpoint_by_radians_request(sock, x, y, z, yw, pi, rl);
+	expect(MSG_IMAGE);
+	return pan_net_get_viewpoint_by_radians_RX(sock, psize);
+}
+
+void PanguConnection::quit() {
+	pan_net_quit_request(sock);
+	expect(MSG_OKAY);
+}
+
+unsigned char * PanguConnection::get_viewpoint_by_frame(
+	unsigned long oid,
+	unsigned long fid,
+	unsigned long *psize)
+{
+	pan_net_get_viewpoint_by_frame_request(sock, oid, fid);
+	expect(MSG_IMAGE);
+	return pan_net_get_viewpoint_by_frame_RX(sock, psize);
+}
+
+int PanguConnection::get_camera_properties(
+	unsigned long cid,
+	unsigned long *pwidth,
+	unsigned long *pheight,
+	double *phfov,
+	double *pvfov,
+	double *px,
+	double *py,
+	double *pz,
+	double *pq0,
+	double *pq1,
+	double *pq2,
+	double *pq3)
+{
+	pan_net_get_camera_properties_request(sock, cid);
+	expect(MSG_CAMERA_PROPERTIES);
+	return pan_net_get_camera_properties_RX(
+		sock, pwidth, pheight, phfov, pvfov, px, py, pz, pq0, pq1, pq2, pq3
+	);
+}
+
+void PanguConnection::get_view_as_dem(
+	unsigned long cid,
+	unsigned char boulders,
+	unsigned long nx, unsigned long ny,
+	float dx, float dy,
+	float rd,
+	float *rv,
+	char *ev)
+{
+	pan_net_get_view_as_dem_request(sock, cid, boulders, nx, ny, dx, dy, rd);
+	expect(MSG_FLOAT_ARRAY);
+	pan_net_get_view_as_dem_RX(sock, rv, ev);
+}
+
+float * PanguConnection::get_lidar_measurement_d(
+	double px, double py, double pz,
+	double q0, double q1, double q2, double q3,
+	double vx, double vy, double vz,
+	double rx, double ry, double rz,
+	double ax, double ay, double az,
+	double sx, double sy, double sz,
+	double jx, double jy, double jz,
+	double tx, double ty, double tz,
+	float *pfx, float *pfy,
+	unsigned long *pnx, unsigned long *pny,
+	float *ptx, float *pty,
+	unsigned long *pn, unsigned long *pm,
+	unsigned long *pt, unsigned long *pfl,
+	float *paz, float *pel, float *pth,
+	float *pfaz, float *pfel,
+	float *ptoff, float *ptaz0, float *ptel0)
+{
+	pan_net_get_lidar_measurement_d_request(
+		sock, px, py, pz, q0, q1, q2, q3, vx, vy, vz, rx, ry, rz, ax, ay, az, sx, sy, sz,
+		jx, jy, jz, tx, ty, tz
+	);
+	expect(MSG_LIDAR_MEASUREMENT);
+	return pan_net_get_lidar_measurement_d_RX(
+		sock, pfx, pfy, pnx, pny, ptx, pty, pn, pm, pt, pfl, paz, pel, pth, pfaz, pfel,
+		ptoff, ptaz0, ptel0
+	);
+}
+
+double PanguConnection::get_time_tag(char *perr) {
+	pan_net_get_time_tag_request(sock);
+	expect(MSG_DOUBLE);
+	return pan_net_get_time_tag_RX(sock, perr);
+}
+
+float * PanguConnection::get_lidar_measurement_s(
+	float px, float py, float pz,
+	float q0, float q1, float q2, float q3,
+	float vx, float vy, float vz,
+	float rx, float ry, float rz,
+	float ax, float ay, float az,
+	float sx, float sy, float sz,
+	float jx, float jy, float jz,
+	float tx, float ty, float tz,
+	float *pfx, float *pfy,
+	unsigned long *pnx, unsigned long *pny,
+	float *ptx, float *pty,
+	unsigned long *pn, unsigned long *pm,
+	unsigned long *pt, unsigned long *pfl,
+	float *paz, float *pel, float *pth,
+	float *pfaz, float *pfel,
+	float *ptoff, float *ptaz0, float *ptel0)
+{
+	pan_net_get_lidar_measurement_s_request(
+		sock, px, py, pz, q0, q1, q2, q3, vx, vy, vz, rx, ry, rz, ax, ay, az, sx, sy, sz,
+		jx, jy, jz, tx, ty, tz
+	);
+	expect(MSG_LIDAR_MEASUREMENT);
+	return pan_net_get_lidar_measurement_s_RX(
+		sock, pfx, pfy, pnx, pny, ptx, pty, pn, pm, pt, pfl, paz, pel, pth, pfaz, pfel,
+		ptoff, ptaz0, ptel0
+	);
+}
+
+float * PanguConnection::get_lidar_snapshot(
+	unsigned long cid,
+	double px, double py, double pz,
+	double q0, double q1, double q2, double q3,
+	unsigned long * width, unsigned long * height)
+{
+	pan_net_get_lidar_snapshot_request(sock, cid, px, py, pz, q0, q1, q2, q3);
+	expect(MSG_RAW_IMAGE);
+	return pan_net_get_lidar_snapshot_RX(sock, width, height);
+}
+
+void PanguConnection::set_viewpoint_by_degrees_s(float x, float y, float z, float yw, float pi, float rl) {
+	pan_net_set_viewpoint_by_degrees_s_request(sock, x, y, z, yw, pi, rl);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_viewpoint_by_angle(float x, float y, float z, float yw, float pi, float rl) {
+	set_viewpoint_by_degrees_s(x, y, z, yw, pi, rl);
+}
+
+void PanguConnection::set_viewpoint_by_angle_s(float x , float y, float z, float yw, float pi, float rl) {
+	set_viewpoint_by_degrees_s(x, y, z, yw, pi, rl);
+}
+
+void PanguConnection::set_viewpoint_by_quaternion_s(float x, float y, float z, float q0, float q1, float q2, float q3) {
+	pan_net_set_viewpoint_by_quaternion_s_request(sock, x, y, z, q0, q1, q2, q3);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_viewpoint_by_quaternion(float x, float y, float z, float q0, float q1, float q2, float q3) {
+	set_viewpoint_by_quaternion_s(x, y, z, q0, q1, q2, q3);
+}
+
+void PanguConnection::set_ambient_light(float r, float g, float b) {
+	pan_net_set_ambient_light_request(sock, r, g, b);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_sun_colour(float r, float g, float b) {
+	pan_net_set_sun_colour_request(sock, r, g, b);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_sky_type(unsigned long t) {
+	pan_net_set_sky_type_request(sock, t);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_field_of_view_by_degrees(float f) {
+	pan_net_set_field_of_view_by_degrees_request(sock, f);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_field_of_view(float f) {
+	set_field_of_view_by_degrees(f);
+}
+
+void PanguConnection::set_aspect_ratio(float r) {
+	pan_net_set_aspect_ratio_request(sock, r);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_boulder_view(unsigned long type, int texture) {
+	pan_net_set_boulder_view_request(sock, type, texture);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_surface_view(unsigned long type, int tex, int det) {
+	pan_net_set_surface_view_request(sock, type, tex, det);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_lidar_parameters(
+	float fx, float fy,
+	unsigned long nx, unsigned long ny,
+	float tx, float ty,
+	unsigned long n, unsigned long m,
+	unsigned long t, unsigned long fl,
+	float az, float el, float th,
+	float wx, float wy,
+	float faz, float fel,
+	float toff, float taz0, float tel0)
+{
+	pan_net_set_lidar_parameters_request(
+		sock, fx, fy, nx, ny, tx, ty, n, m, t, fl, az, el, th, wx, wy, faz, fel, toff, taz0,
+		tel0
+	);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_corner_cubes_s(unsigned long n, unsigned long fmt, float *pcc) {
+	pan_net_set_corner_cubes_s_request(sock, n, fmt, pcc);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_corner_cubes(unsigned long n, unsigned long fmt, float *pcc) {
+	set_corner_cubes_s(n, fmt, pcc);
+}
+
+void PanguConnection::set_corner_cube_attitude(
+	float q0, float q1, float q2, float q3,
+	float rx, float ry, float rz,
+	float ax, float ay, float az,
+	float jx, float jy, float jz)
+{
+	pan_net_set_corner_cube_attitude_request(
+		sock, q0, q1, q2, q3, rx, ry, rz, ax, ay, az, jx, jy, jz
+	);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_viewpoint_by_degrees_d(double x, double y, double z, double yw, double pi, double rl) {
+	pan_net_set_viewpoint_by_degrees_d_request(sock, x, y, z, yw, pi, rl);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_viewpoint_by_angle_d(double x, double y, double z, double yw, double pi, double rl) {
+	set_viewpoint_by_degrees_d(x, y, z, yw, pi, rl);
+}
+
+void PanguConnection::set_viewpoint_by_quaternion_d(double x, double y, double z, double q0, double q1, double q2, double q3) {
+	pan_net_set_viewpoint_by_quaternion_d_request(sock, x, y, z, q0, q1, q2, q3);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_object_position_attitude(
+	unsigned long id,
+	double x, double y, double z,
+	double q0, double q1, double q2, double q3)
+{
+	pan_net_set_object_position_attitude_request(sock, id, x, y, z, q0, q1, q2, q3);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_object_position(unsigned long id, double x, double y, double z, double q0, double q1, double q2, double q3) {
+	set_object_position_attitude(id, x, y, z, q0, q1, q2, q3);
+}
+
+void PanguConnection::set_sun_by_degrees(double r, double a, double e) {
+	pan_net_set_sun_by_degrees_request(sock, r, a, e);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_sun_position(double r, double a, double e) {
+	set_sun_by_degrees(r, a, e);
+}
+
+void PanguConnection::set_joint_config(unsigned long obj, unsigned long joint, double config[9]) {
+	pan_net_set_joint_config_request(sock, obj, joint, config);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_star_quaternion(double q0, double q1, double q2, double q3) {
+	pan_net_set_star_quaternion_request(sock, q0, q1, q2, q3);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_star_magnitudes(double m) {
+	pan_net_set_star_magnitudes_request(sock, m);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_secondary_by_degrees(double r, double a, double e) {
+	pan_net_set_secondary_by_degrees_request(sock, r, a, e);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_global_time(double t) {
+	pan_net_set_global_time_request(sock, t);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_object_view(unsigned long id, unsigned long type) {
+	pan_net_set_object_view_request(sock, id, type);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_viewpoint_by_radians(double x, double y, double z, double yw, double pi, double rl) {
+	pan_net_set_viewpoint_by_radians_request(sock, x, y, z, yw, pi, rl);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_field_of_view_by_radians(float f) {
+	pan_net_set_field_of_view_by_radians_request(sock, f);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_sun_by_radians(double r, double a, double e) {
+	pan_net_set_sun_by_radians_request(sock, r, a, e);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_secondary_by_radians(double r, double a, double e) {
+	pan_net_set_secondary_by_radians_request(sock, r, a, e);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_sky_rgb(float r, float g, float b) {
+	pan_net_set_sky_rgb_request(sock, r, g, b);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_sky_cie(float x, float y, float Y) {
+	pan_net_set_sky_cie_request(sock, x, y, Y);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_atmosphere_tau(float mr, float mg, float mb, float rr, float rg, float rb) {
+	pan_net_set_atmosphere_tau_request(sock, mr, mg, mb, rr, rg, rb);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_global_fog_mode(unsigned long mode) {
+	pan_net_set_global_fog_mode_request(sock, mode);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_global_fog_properties(double radius, double density, double lin0, double lin1) {
+	pan_net_set_global_fog_properties_request(sock, radius, density, lin0, lin1);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_atmosphere_mode(unsigned long smode, unsigned long gmode, unsigned long amode) {
+	pan_net_set_atmosphere_mode_request(sock, smode, gmode, amode);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::select_camera(unsigned long cid) {
+	pan_net_select_camera_request(sock, cid);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::bind_light_to_camera(unsigned long lid, unsigned long cid, unsigned char en) {
+	pan_net_bind_light_to_camera_request(sock, lid, cid, en);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::configure_light_by_degrees(unsigned long lid, double r, double g, double b, double h, double e) {
+	pan_net_configure_light_by_degrees_request(sock, lid, r, g, b, h, e);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::configure_light_by_radians(unsigned long lid, double r, double g, double b, double h, double e) {
+	pan_net_configure_light_by_radians_request(sock, lid, r, g, b, h, e);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_light_position_direction(unsigned long lid, double ox, double oy, double oz, double dx, double dy, double dz) {
+	pan_net_set_light_position_direction_request(sock, lid, ox, oy, oz, dx, dy, dz);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::render_to_hold_buffer(unsigned long cid, unsigned long bid) {
+	pan_net_render_to_hold_buffer_request(sock, cid, bid);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::display_hold_buffer(unsigned long bid) {
+	pan_net_display_hold_buffer_request(sock, bid);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_corner_cubes_d(unsigned long n, unsigned long fmt, double *pcc) {
+	pan_net_set_corner_cubes_d_request(sock, n, fmt, pcc);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_projection_mode(unsigned long cid, unsigned long mode) {
+	pan_net_set_projection_mode_request(sock, cid, mode);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_ortho_field_of_view(unsigned long cid, double width, double height) {
+	pan_net_set_ortho_field_of_view_request(sock, cid, width, height);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_lidar_scan(unsigned long n, unsigned long fmt, double *pls) {
+	pan_net_set_lidar_scan_request(sock, n, fmt, pls);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::set_camera_motion(
+	unsigned long cid,
+	double vx, double vy, double vz,
+	double rx, double ry, double rz,
+	double ax, double ay, double az,
+	double sx, double sy, double sz,
+	double jx, double jy, double jz,
+	double tx, double ty, double tz)
+{
+	pan_net_set_camera_motion_request(
+		sock, cid, vx, vy, vz, rx, ry, rz, ax, ay, az, sx, sy, sz, jx, jy, jz, tx, ty, tz
+	);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::start() {
+	pan_net_start_request(sock);
+	expect(MSG_OKAY);
+}
+
+void PanguConnection::finish() {
+	pan_net_finish_TX(sock);
+}
+
+ulong PanguConnection::host_id_to_address(const char *s) {
+	struct hostent *host;
+
+	/* Assume we have a dotted IP address ... */
+	long result = inet_addr(s);
+	if(result != INADDR_NONE) {
+		return result;
+	}
+
+	/* That failed so assume DNS will resolve it. */
+	host = gethostbyname(s);
+	return host ? *((long *)host->h_addr_list[0]) : INADDR_NONE;
+}
@@ -0,0 +1,292 @@
+#pragma once
+#ifndef PANGU_CONNECTION_HPP
+#define PANGU_CONNECTION_HPP
+
+#include "Pangu/socket_stuff.h"
+
+#include <string>
+#include <vector>
+
+#include "Pangu/pan_protocol_lib.h"
+#include "Utils/types.hpp"
+
+struct PanguEndpoint {
+	std::string host;
+	ushort port;
+
+	PanguEndpoint(const std::string &host, ushort port) {
+		this->host = host;
+		this->port = port;
+	}
+};
+
+/* Parse a comma separated list of host:port or host entries, a missing port
+is PANGU's default 10363. Returns false and leaves endpoints unchanged if
+any entry is malformed or the list is empty */
+bool parse_pangu_endpoints(const std::string &list, std::vector<PanguEndpoint> &endpoints);
+
+/* One session with a PANGU server. The connection owns its socket, the
+buffer requests are built in, the buffer images are received into and the
+last error, and keeps nothing in function or global statics, so threads
+may each drive their own connection at the same time. A single connection
+must only be used by one thread at a time.
+
+The pan_protocol_* calls are available as methods of the same name, see
+pan_protocol_lib.h for what each does. Rather than ending the program an
+error from the server throws std::runtime_error, the message is kept in
+last_error() */
+class PanguConnection {
+public:
+	/* Connect and start a session, throws std::runtime_error on failure */
+	PanguConnection(const PanguEndpoint &endpoint);
+	/* Ends the session and closes the socket */
+	~PanguConnection();
+	PanguConnection(const PanguConnection &) = delete;
+	PanguConnection & operator=(const PanguConnection &) = delete;
+
+	SOCKET socket() const { return sock; }
+	const char * last_error() const { return error; }
+
+	/* Read the next reply code, throwing if it is not want */
+	void expect(unsigned long want);
+
+	/* Queue a GetViewpointByDegreesD request without sending it. Every
+	request queued since the last flush is sent in one write by flush, the
+	replies are then read in order with receive_image_into */
+	void queue_viewpoint_by_degrees_d(double x, double y, double z, double yw, double pi, double rl);
+	void flush();
+	/* Read the next image reply into buffer, returns false if it is larger
+	than capacity in which case it is skipped */
+	bool receive_image_into(uchar *buffer, size_t capacity, size_t &size);
+	/* GetImage into the connection's receive buffer. The image stays valid
+	until the next call */
+	const uchar * render_image(size_t &size);
+
+	/* pan_protocol_* calls in message number order */
+	unsigned char * get_image(unsigned long *psize);
+	float get_elevation(char *perr);
+	void get_elevations(unsigned long n, float *posv, float *resultv, char *errorv);
+	void lookup_point(float x, float y, float *px, float *py, float *pz, char *perr);
+	void lookup_points(unsigned long n, float *posv, float *resultv, char *errorv);
+	void get_point(float dx, float dy, float dz, float *px, float *py, float *pz, char *perr);
+	void get_points(unsigned long n, float *posv, float *resultv, char *errorv);
+	void * echo(void *src, unsigned long n, unsigned long *psize);
+	unsigned char * get_range_image(unsigned long *psize, float offset, float scale);
+	unsigned char * get_range_texture(unsigned long *psize);
+	unsigned char * get_viewpoint_by_degrees_s(float x, float y, float z, float yw, float pi, float rl, unsigned long *psize);
+	unsigned char * get_viewpoint_by_angle(float x, float y, float z, float yw, float pi, float rl, unsigned long *psize);
+	unsigned char * get_viewpoint_by_angle_s(float x, float y, float z, float yw, float pi, float rl, unsigned long *sz);
+	unsigned char * get_viewpoint_by_quaternion_s(float x, float y, float z, float q0, float q1, float q2, float q3, unsigned long *psize);
+	unsigned char * get_viewpoint_by_quaternion(float x, float y, float z, float q0, float q1, float q2, float q3, unsigned long *psize);
+	void get_lidar_pulse_result(float x, float y, float z, float dx, float dy, float dz, float *pr, float *pa);
+	float * get_lidar_measurement(
+		float px, float py, float pz,
+		float q0, float q1, float q2, float q3,
+		float vx, float vy, float vz,
+		float rx, float ry, float rz,
+		float ax, float ay, float az,
+		float sx, float sy, float sz,
+		float jx, float jy, float jz,
+		float tx, float ty, float tz,
+		float *pfx, float *pfy,
+		unsigned long *pnx, unsigned long *pny,
+		float *ptx, float *pty,
+		unsigned long *pn, unsigned long *pm,
+		unsigned long *pt, unsigned long *pfl,
+		float *paz, float *pel, float *pth,
+		float *pfaz, float *pfel,
+		float *ptoff, float *ptaz0, float *ptel0);
+	float * get_radar_response(
+		unsigned long flags,
+		unsigned long n,
+		unsigned long nr, unsigned long ns,
+		float ox, float oy, float oz,
+		float vx, float vy, float vz,
+		float q0, float q1, float q2, float q3,
+		float bwidth,
+		float rmid, float smid,
+		float rbs, float sbs,
+		unsigned long *pstat,
+		float *pmaxv, float *ptotv,
+		float *poffr, float *poffs,
+		float *prbsize, float *psbsize,
+		float *pminr, float *pmaxr,
+		float *pmins, float *pmaxs,
+		unsigned long *pnrelts, unsigned long *pnselts,
+		unsigned long *pnused);
+	unsigned char * get_viewpoint_by_degrees_d(double x, double y, double z, double yw, double pi, double rl, unsigned long *psize);
+	unsigned char * get_viewpoint_by_angle_d(double x, double y, double z, double yw, double pi, double rl, unsigned long *sz);
+	unsigned char * get_viewpoint_by_quaternion_d(double x, double y, double z, double q0, double q1, double q2, double q3, unsigned long *psize);
+	joint_data * get_joints(unsigned long o, unsigned long *n);
+	void get_joint_config(unsigned long obj, unsigned long joint, double *config);
+	frame_data * get_frames(unsigned long obj, unsigned long *n);
+	void get_frame(unsigned long obj, unsigned long id, double *data);
+	void get_frame_as_radians(unsigned long obj, unsigned long id, double *data);
+	void get_frame_viewpoint_by_angle(unsigned long o, unsigned long i, double* v);
+	float get_surface_elevation(unsigned char boulders, float x, float y, char *err);
+	void get_surface_elevations(
+		unsigned char boulders,
+		unsigned long n,
+		float *posv,
+		float *resultv,
+		char *errorv);
+	void get_surface_patch(
+		unsigned char boulders,
+		float cx, float cy,
+		unsigned long nx, unsigned long ny,
+		float d,
+		float theta,
+		float *rv,
+		char *ev);
+	unsigned char * get_viewpoint_by_radians(double x, double y, double z, double yw, double pi, double rl, unsigned long *psize);
+	void quit();
+	unsigned char * get_viewpoint_by_frame(unsigned long oid, unsigned long fid, unsigned long *psize);
+	int get_camera_properties(
+		unsigned long cid,
+		unsigned long *pwidth,
+		unsigned long *pheight,
+		double *phfov,
+		double *pvfov,
+		double *px,
+		double *py,
+		double *pz,
+		double *pq0,
+		double *pq1,
+		double *pq2,
+		double *pq3);
+	void get_view_as_dem(
+		unsigned long cid,
+		unsigned char boulders,
+		unsigned long nx, unsigned long ny,
+		float dx, float dy,
+		float rd,
+		float *rv,
+		char *ev);
+	float * get_lidar_measurement_d(
+		double px, double py, double pz,
+		double q0, double q1, double q2, double q3,
+		double vx, double vy, double vz,
+		double rx, double ry, double rz,
+		double ax, double ay, double az,
+		double sx, double sy, double sz,
+		double jx, double jy, double jz,
+		double tx, double ty, double tz,
+		float *pfx, float *pfy,
+		unsigned long *pnx, unsigned long *pny,
+		float *ptx, float *pty,
+		unsigned long *pn, unsigned long *pm,
+		unsigned long *pt, unsigned long *pfl,
+		float *paz, float *pel, float *pth,
+		float *pfaz, float *pfel,
+		float *ptoff, float *ptaz0, float *ptel0);
+	double get_time_tag(char *perr);
+	float * get_lidar_measurement_s(
+		float px, float py, float pz,
+		float q0, float q1, float q2, float q3,
+		float vx, float vy, float vz,
+		float rx, float ry, float rz,
+		float ax, float ay, float az,
+		float sx, float sy, float sz,
+		float jx, float jy, float jz,
+		float tx, float ty, float tz,
+		float *pfx, float *pfy,
+		unsigned long *pnx, unsigned long *pny,
+		float *ptx, float *pty,
+		unsigned long *pn, unsigned long *pm,
+		unsigned long *pt, unsigned long *pfl,
+		float *paz, float *pel, float *pth,
+		float *pfaz, float *pfel,
+		float *ptoff, float *ptaz0, float *ptel0);
+	float * get_lidar_snapshot(
+		unsigned long cid,
+		double px, double py, double pz,
+		double q0, double q1, double q2, double q3,
+		unsigned long * width, unsigned long * height);
+	void set_viewpoint_by_degrees_s(float x, float y, float z, float yw, float pi, float rl);
+	void set_viewpoint_by_angle(float x, float y, float z, float yw, float pi, float rl);
+	void set_viewpoint_by_angle_s(float x , float y, float z, float yw, float pi, float rl);
+	void set_viewpoint_by_quaternion_s(float x, float y, float z, float q0, float q1, float q2, float q3);
+	void set_viewpoint_by_quaternion(float x, float y, float z, float q0, float q1, float q2, float q3);
+	void set_ambient_light(float r, float g, float b);
+	void set_sun_colour(float r, float g, float b);
+	void set_sky_type(unsigned long t);
+	void set_field_of_view_by_degrees(float f);
+	void set_field_of_view(float f);
+	void set_aspect_ratio(float r);
+	void set_boulder_view(unsigned long type, int texture);
+	void set_surface_view(unsigned long type, int tex, int det);
+	void set_lidar_parameters(
+		float fx, float fy,
+		unsigned long nx, unsigned long ny,
+		float tx, float ty,
+		unsigned long n, unsigned long m,
+		unsigned long t, unsigned long fl,
+		float az, float el, float th,
+		float wx, float wy,
+		float faz, float fel,
+		float toff, float taz0, float tel0);
+	void set_corner_cubes_s(unsigned long n, unsigned long fmt, float *pcc);
+	void set_corner_cubes(unsigned long n, unsigned long fmt, float *pcc);
+	void set_corner_cube_attitude(
+		float q0, float q1, float q2, float q3,
+		float rx, float ry, float rz,
+		float ax, float ay, float az,
+		float jx, float jy, float jz);
+	void set_viewpoint_by_degrees_d(double x, double y, double z, double yw, double pi, double rl);
+	void set_viewpoint_by_angle_d(double x, double y, double z, double yw, double pi, double rl);
+	void set_viewpoint_by_quaternion_d(double x, double y, double z, double q0, double q1, double q2, double q3);
+	void set_object_position_attitude(
+		unsigned long id,
+		double x, double y, double z,
+		double q0, double q1, double q2, double q3);
+	void set_object_position(unsigned long id, double x, double y, double z, double q0, double q1, double q2, double q3);
+	void set_sun_by_degrees(double r, double a, double e);
+	void set_sun_position(double r, double a, double e);
+	void set_joint_config(unsigned long obj, unsigned long joint, double config[9]);
+	void set_star_quaternion(double q0, double q1, double q2, double q3);
+	void set_star_magnitudes(double m);
+	void set_secondary_by_degrees(double r, double a, double e);
+	void set_global_time(double t);
+	void set_object_view(unsigned long id, unsigned long type);
+	void set_viewpoint_by_radians(double x, double y, double z, double yw, double pi, double rl);
+	void set_field_of_view_by_radians(float f);
+	void set_sun_by_radians(double r, double a, double e);
+	void set_secondary_by_radians(double r, double a, double e);
+	void set_sky_rgb(float r, float g, float b);
+	void set_sky_cie(float x, float y, float Y);
+	void set_atmosphere_tau(float mr, float mg, float mb, float rr, float rg, float rb);
+	void set_global_fog_mode(unsigned long mode);
+	void set_global_fog_properties(double radius, double density, double lin0, double lin1);
+	void set_atmosphere_mode(unsigned long smode, unsigned long gmode, unsigned long amode);
+	void select_camera(unsigned long cid);
+	void bind_light_to_camera(unsigned long lid, unsigned long cid, unsigned char en);
+	void configure_light_by_degrees(unsigned long lid, double r, double g, double b, double h, double e);
+	void configure_light_by_radians(unsigned long lid, double r, double g, double b, double h, double e);
+	void set_light_position_direction(unsigned long lid, double ox, double oy, double oz, double dx, double dy, double dz);
+	void render_to_hold_buffer(unsigned long cid, unsigned long bid);
+	void display_hold_buffer(unsigned long bid);
+	void set_corner_cubes_d(unsigned long n, unsigned long fmt, double *pcc);
+	void set_projection_mode(unsigned long cid, unsigned long mode);
+	void set_ortho_field_of_view(unsigned long cid, double width, double height);
+	void set_lidar_scan(unsigned long n, unsigned long fmt, double *pls);
+	void set_camera_motion(
+		unsigned long cid,
+		double vx, double vy, double vz,
+		double rx, double ry, double rz,
+		double ax, double ay, double az,
+		double sx, double sy, double sz,
+		double jx, double jy, double jz,
+		double tx, double ty, double tz);
+
+private:
+	SOCKET sock;
+	pan_socket_msg message;
+	std::vector<uchar> image;
+	char error[1024];
+
+	void start();
+	void finish();
+	static ulong host_id_to_address(const char *s);
+};
+
+#endif /* PANGU_CONNECTION_HPP */
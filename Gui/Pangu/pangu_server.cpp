@@ -1,19 +1,18 @@
 #include <stdexcept>
 #include <algorithm>
-#include <fstream>
-#include <sstream>
+#include <deque>
 #include <vector>
 #include <stdio.h>
+#include <string.h>
 
 #include "pangu_server.hpp"
-#include "pan_protocol_lib.h"
 
 PanguServer::PanguServer(std::vector<PanguStep> *steps) :
-	steps(steps),
-	image_queue(max(max_image_queue_size, 1)),
-	exit(true)
+	image_channel(max_image_queue_bytes, 1),
+	exit(true),
+	steps(steps)
 {
-	/* Empty */
+	endpoints.push_back(PanguEndpoint("localhost", 10363));
 }
 
 PanguServer::~PanguServer() {
@@ -21,173 +20,311 @@ PanguServer::~PanguServer() {
 }
 
 void PanguServer::start(uint max_frames) {
-	_connect();
-
-	pan_protocol_get_camera_properties(
-		sock, 0,
+	/* The camera size and field of view are part of every cache key, so the
+	first connection is needed even when the whole flight is cached */
+	connections.push_back(new PanguConnection(endpoints[0]));
+	connections[0]->get_camera_properties(
+		0,
 		&image_width,
 		&image_height,
+		&horizontal_fov,
+		&vertical_fov,
 		NULL, NULL, NULL,
-		NULL, NULL, NULL,
-		NULL, NULL, NULL
+		NULL, NULL, NULL, NULL
 	);
 
-	ulong image_size_bytes;
-	uchar *image = pan_protocol_get_image(sock, &image_size_bytes);
-	single_img_size_bytes = image_size_bytes;
-	image_offset = image_start_offset(image);
-	free(image);
-
 	this->max_frames = max_frames;
-	step_idx = 0;
+	max_step_idx = ((long long)std::min((uint)steps->size(), max_frames)) - 1;
+
+	/* The other connections only render, they are not opened when every step is cached */
+	const bool flight_cached = find_cached_images();
+	const uint num_socks = flight_cached ? 1 : std::max(num_connections, 1u);
+	for(uint i=1; i<num_socks; ++i) {
+		connections.push_back(new PanguConnection(endpoints[i % endpoints.size()]));
+	}
+
+	/* Take the image size from the cached first step when there is one rather than rendering a frame */
+	if(!cached_images.empty() && cached_images[0].image) {
+		single_img_size_bytes = cached_images[0].size;
+		image_offset = image_start_offset(cached_images[0].image);
+	} else {
+		const uchar *image = connections[0]->render_image(single_img_size_bytes);
+		image_offset = image_start_offset(image);
+	}
+
+	/* Room for every connection to keep its pipeline full while it waits on a slower one */
+	reorder_buffer.assign(num_socks * std::max(pipeline_depth, 1u) * 2, nullptr);
+	frame_pool.reset(single_img_size_bytes, image_pool_size());
+	release_idx = 0;
+	image_channel.reset(max_image_queue_bytes, image_channel_size());
+	next_step_idx = 0;
+
 	exit = false;
-	gen_thread = std::thread(&PanguServer::generate_images, this);
+	for(uint i=0; i<num_socks; ++i) {
+		gen_threads.push_back(std::thread(&PanguServer::generate_images, this, i));
+	}
+	release_thread = std::thread(&PanguServer::release_images, this);
 }
 
 void PanguServer::stop() {
-	exit = true;
+	{
+		/* Set under the lock so no thread misses the wake up between checking exit and waiting */
+		std::lock_guard<std::mutex> lock(reorder_lock);
+		exit = true;
+		reorder_filled.notify_all();
+		reorder_released.notify_all();
+	}
+	image_channel.close();
+	frame_pool.close();
 
-	if(gen_thread.joinable()) {
-		gen_thread.join();
+	for(size_t i=0; i<gen_threads.size(); ++i) {
+		gen_threads[i].join();
 	}
+	gen_threads.clear();
+	if(release_thread.joinable()) {
+		release_thread.join();
+	}
+
+	/* The cached images point into the pack's mapping */
+	cached_images.clear();
+	frame_cache.close();
 
-	uchar *image = nullptr;
-	while(image_queue.try_dequeue(image)) {
-		free(image);
+	PanguFrame frame;
+	while(image_channel.try_pop(frame)) {
+		release_image(frame.image);
+	}
+	for(size_t i=0; i<reorder_buffer.size(); ++i) {
+		release_image(reorder_buffer[i]);
+		reorder_buffer[i] = nullptr;
 	}
 
-	_disconnect();
+	for(size_t i=0; i<connections.size(); ++i) {
+		delete connections[i];
+	}
+	connections.clear();
 }
 
-unsigned char * PanguServer::get_image(uint ms) {
-	uchar *image = 0;
-	image_queue.wait_dequeue_timed(image, std::chrono::milliseconds(ms));
-	return image;
+void PanguServer::release_image(uchar *image) {
+	frame_pool.release(image);
 }
 
-ulong PanguServer::host_id_to_address(char *s) {
-	struct hostent *host;
-
-	/* Assume we have a dotted IP address ... */
-	long result = inet_addr(s);
-	if(result != INADDR_NONE) {
-		return result;
+PanguFrame PanguServer::get_image(uint ms) {
+	PanguFrame frame;
+	if(image_channel.pop(frame, ms)) {
+		frame.dropped = frame.step_idx - next_step_idx;
+		next_step_idx = frame.step_idx + 1;
 	}
+	return frame;
+}
 
-	/* That failed so assume DNS will resolve it. */
-	host = gethostbyname(s);
-	return host ? *((long *)host->h_addr_list[0]) : INADDR_NONE;
+FrameChannelStats PanguServer::image_channel_stats() const {
+	return image_channel.statistics();
 }
 
-void PanguServer::_connect() {
-	WSAData wsaData;
-	if(WSAStartup(MAKEWORD(1, 1), &wsaData)) {
-		throw std::runtime_error("Failed to initialise winsock 1.1");
-	}
+size_t PanguServer::image_start_offset(const uchar *image) {
+	size_t offset = 0;
+	for(char newlines=0; newlines<2; newlines+=image[offset++]=='\n');
+	return offset;
+}
 
-	/* Get IP address of the server */
-	long ip_addr = host_id_to_address(server_name);
+void PanguServer::request_image(PanguConnection &connection, long long request_step_idx) {
+	PanguStep &step = (*steps)[request_step_idx];
+
+	/* Move the camera and request an image in one message, sent with the
+	other queued requests on the next flush */
+	connection.queue_viewpoint_by_degrees_d(
+		step.x, step.y, step.z,
+		step.yaw, step.pitch, step.roll
+	);
+}
 
-	/* Create a TCP/IP socket */
-	sock = socket(AF_INET, SOCK_STREAM, 0);
-	if(sock == -1) {
-		throw std::runtime_error("Failed to create socket");
+uchar * PanguServer::receive_image(PanguConnection &connection, size_t &image_size_bytes) {
+	/* Receive straight into a pooled buffer, there is none once stop() closed the pool */
+	uchar *image = frame_pool.acquire();
+	if(!image) {
+		return nullptr;
 	}
 
-	/* Connect the socket to the remote server */
-	struct sockaddr_in sock_addr;
-	sock_addr.sin_family = AF_INET;
-	sock_addr.sin_addr.s_addr = ip_addr;
-	sock_addr.sin_port = htons(server_port);
-	ulong sock_addr_len = sizeof(struct sockaddr_in);
-	if(connect(sock, (struct sockaddr *)&sock_addr, sock_addr_len) == -1) {
-		throw std::runtime_error("Failed to connect to server");
+	bool received = false;
+	try {
+		received = connection.receive_image_into(image, frame_pool.buffer_size(), image_size_bytes);
+	} catch(const std::runtime_error &error) {
+		frame_pool.release(image);
+		printf("%s", error.what());
+		throw;
 	}
 
-	/* Start the PANGU network communications protocol */
-	pan_protocol_start(sock);
+	if(!received) {
+		frame_pool.release(image);
+		printf("Failed to get an image from pangu");
+		throw std::runtime_error("Failed to get an image from pangu");
+	}
+	return image;
 }
 
-void PanguServer::_disconnect() {
-	pan_protocol_finish(sock);
-	SOCKET_CLOSE(sock);
-	WSACleanup();
+unsigned long long PanguServer::image_key(long long step_idx) const {
+	const PanguStep &step = (*steps)[step_idx];
+	const double viewpoint[6] = {step.x, step.y, step.z, step.yaw, step.pitch, step.roll};
+	return FrameCache::image_key(viewpoint, image_width, image_height, horizontal_fov, vertical_fov, scene_tag);
 }
 
-size_t PanguServer::image_start_offset(uchar *image) {
-	size_t offset = 0;
-	for(char newlines=0; newlines<2; newlines+=image[offset++]=='\n');
-	return offset;
+bool PanguServer::find_cached_images() {
+	cached_images.clear();
+	if(cache_path.empty() || !frame_cache.open(cache_path)) {
+		return false;
+	}
+
+	/* Every step is looked up once here, the render threads read the results */
+	bool flight_cached = true;
+	cached_images.resize((size_t)(max_step_idx + 1));
+	for(long long i=0; i<=max_step_idx; ++i) {
+		CachedImage &cached = cached_images[i];
+		cached.image = frame_cache.find(image_key(i), cached.size);
+		flight_cached = flight_cached && cached.image;
+	}
+	return flight_cached;
 }
 
-void PanguServer::generate_images() {
-	const uint num_steps = steps->size();
-	const long long max_step_idx = ((long long)min(num_steps, max_frames)) - 1;
-	bool image_enqueue_fail = false;
-	uchar *image;
-	while(step_idx <= max_step_idx) {
-		/* Wait until new images are required */
-		while(!exit && image_queue.size_approx() >= max_image_queue_size) {
-			std::this_thread::sleep_for(std::chrono::milliseconds(50));
-		}
+uchar * PanguServer::read_cached_image(long long step_idx) {
+	if(cached_images.empty()) {
+		return nullptr;
+	}
+
+	const CachedImage &cached = cached_images[step_idx];
+	if(!cached.image || cached.size > frame_pool.buffer_size()) {
+		return nullptr;
+	}
+
+	uchar *image = frame_pool.acquire();
+	if(image) {
+		memcpy(image, cached.image, cached.size);
+	}
+	return image;
+}
 
+void PanguServer::release_images() {
+	/* Moves images into image_channel in step order. While the consumer is
+	behind this either waits for it to take an image or, under
+	FRAME_POLICY_LATEST, discards the oldest waiting images */
+	std::vector<PanguFrame> dropped;
+	std::unique_lock<std::mutex> lock(reorder_lock);
+	while(release_idx <= max_step_idx) {
+		uchar *&slot = reorder_buffer[release_idx % reorder_buffer.size()];
+		reorder_filled.wait(lock, [&] { return exit || slot; });
 		if(exit) {
 			return;
 		}
 
-		if(!image_enqueue_fail) {
-			/* Get the current step */
-			PanguStep &step = (*steps)[step_idx];
-
-			/* Update camera position */
-			pan_protocol_set_viewpoint_by_degrees_d(
-				sock, step.x, step.y, step.z,
-				step.yaw, step.pitch, step.roll
-			);
-
-			/* Add new image pointer to the queue */
-			ulong image_size_bytes;
-			image = pan_protocol_get_image(sock, &image_size_bytes);
-			if(!image) {
-				printf("Failed to get an image from pangu");
-				throw std::runtime_error("Failed to get an image from pangu");
-			}
+		PanguFrame frame;
+		frame.image = slot;
+		frame.step_idx = (uint)release_idx;
+		slot = nullptr;
+		lock.unlock();
+		const bool added = image_channel.push(frame_policy, frame, frame_pool.buffer_size(), dropped);
+		for(size_t i=0; i<dropped.size(); ++i) {
+			release_image(dropped[i].image);
 		}
-
-		if(!image_queue.try_enqueue(image)) {
-			image_enqueue_fail = true;
-			continue;
-		} else {
-			image_enqueue_fail = false;
-			++step_idx;
+		dropped.clear();
+		lock.lock();
+		if(!added) {
+			/* Closed by stop() */
+			release_image(frame.image);
+			return;
 		}
+
+		++release_idx;
+		reorder_released.notify_all();
 	}
+
+	/* Consumers see the end of the flight once they have taken every image */
+	image_channel.close();
 }
 
-std::vector<PanguStep> PanguServer::read_pangu_steps(std::string flight_file_path) {
-	std::vector<PanguStep> steps;
+bool PanguServer::wait_for_reorder_slot(long long request_step_idx, bool block) {
+	std::unique_lock<std::mutex> lock(reorder_lock);
+	if(block) {
+		reorder_released.wait(lock, [&] {
+			return exit || request_step_idx < release_idx + (long long)reorder_buffer.size();
+		});
+	}
 
-	std::ifstream flight_file_stream(flight_file_path);
+	return !exit && request_step_idx < release_idx + (long long)reorder_buffer.size();
+}
 
-	std::string line;
-	while(std::getline(flight_file_stream, line)) {
-		std::istringstream iss(line);
+void PanguServer::store_image(long long image_step_idx, uchar *image) {
+	std::lock_guard<std::mutex> lock(reorder_lock);
+	reorder_buffer[image_step_idx % reorder_buffer.size()] = image;
+	reorder_filled.notify_one();
+}
+
+void PanguServer::generate_images(uint connection_idx) {
+	PanguConnection &connection = *connections[connection_idx];
+	const long long stride = connections.size();
+	const size_t depth = std::max(pipeline_depth, 1u);
+
+	/* This connection produces steps connection_idx, connection_idx + stride, ...
+	Cached steps are stored straight away, the rest are requested keeping up
+	to depth of them in flight. The server answers in order so replies are
+	matched to the steps in in_flight */
+	std::deque<long long> in_flight;
+	long long step_idx = connection_idx;
+	while(!exit && (step_idx <= max_step_idx || !in_flight.empty())) {
+		while(step_idx <= max_step_idx && in_flight.size() < depth) {
+			/* Only wait for the reorder buffer to drain when nothing is in flight */
+			if(!wait_for_reorder_slot(step_idx, in_flight.empty())) {
+				break;
+			}
+
+			uchar *image = read_cached_image(step_idx);
+			if(image) {
+				store_image(step_idx, image);
+			} else {
+				request_image(connection, step_idx);
+				in_flight.push_back(step_idx);
+			}
+			step_idx += stride;
+		}
+		/* Requests which fill the pipeline together go out in one write */
+		connection.flush();
 
-		std::string start_token;
-		if(!(iss >> start_token) || start_token != "start") {
+		if(in_flight.empty()) {
 			continue;
 		}
 
-		PanguStep step;
-		iss >> step.x;
-		iss >> step.y;
-		iss >> step.z;
-		iss >> step.yaw;
-		iss >> step.pitch;
-		iss >> step.roll;
+		size_t image_size_bytes;
+		uchar *image = receive_image(connection, image_size_bytes);
+		if(!image) {
+			return;
+		}
+		if(frame_cache.is_open()) {
+			frame_cache.write(image_key(in_flight.front()), image, image_size_bytes);
+		}
+		store_image(in_flight.front(), image);
+		in_flight.pop_front();
+	}
 
-		steps.push_back(step);
+	/* Read the replies to any requests still in flight so the
+	connection is left ready for the next message */
+	for(; !in_flight.empty(); in_flight.pop_front()) {
+		size_t image_size_bytes;
+		uchar *image = receive_image(connection, image_size_bytes);
+		if(!image) {
+			return;
+		}
+		release_image(image);
 	}
+}
+
+uint PanguServer::image_channel_size() const {
+	/* Every image costs a full buffer and the channel always takes one */
+	return (uint)std::max(max_image_queue_bytes / std::max(single_img_size_bytes, (size_t)1), (size_t)1);
+}
 
-	return steps;
-}
\ No newline at end of file
+uint PanguServer::image_pool_size() const {
+	/* Images can be waiting in image_channel, in the reorder buffer, being
+	received or read from the cache by each connection, being moved by the
+	release thread and held by the consumer. No more than the flight's images
+	are ever needed */
+	const size_t num_images = image_channel_size() + reorder_buffer.size() + connections.size() + 1 + max_consumer_images;
+	return (uint)std::max(std::min(num_images, (size_t)(max_step_idx + 1)), (size_t)1);
+}
@@ -2,33 +2,34 @@
 #ifndef PANGU_SERVER_HPP
 #define PANGU_SERVER_HPP
 
-#include <WinSock2.h>
+#include "Pangu/socket_stuff.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
 #include <thread>
 #include <vector>
 
-#include "queue/atomicops.h"
-#include "queue/readerwriterqueue.h"
-
+#include "Pangu/frame_cache.hpp"
+#include "Pangu/frame_channel.hpp"
+#include "Pangu/frame_pool.hpp"
+#include "Pangu/pangu_connection.hpp"
+#include "Pangu/pangu_step.hpp"
 #include "Utils/types.hpp"
 
-/* For BlockingReaderWriterQueue */
-using namespace moodycamel;
-
-struct PanguStep {
-	double x, y, z, yaw, pitch, roll;
-
-	PanguStep() {
-		/* Empty */
-	}
+/* An image from the server and the flight step it shows. dropped counts the
+images discarded under FRAME_POLICY_LATEST since the previous frame handed
+to the consumer */
+struct PanguFrame {
+	uchar *image;
+	uint step_idx;
+	uint dropped;
 
-	PanguStep(double x, double y, double z, double yaw, double pitch, double roll) {
-		this->x = x;
-		this->y = y;
-		this->z = z;
-		this->yaw = yaw;
-		this->pitch = pitch;
-		this->roll = roll;
+	PanguFrame() {
+		image = nullptr;
+		step_idx = 0;
+		dropped = 0;
 	}
 };
 
@@ -37,33 +38,96 @@ public:
 	size_t image_offset;
 	ulong image_width;
 	ulong image_height;
-	BlockingReaderWriterQueue<uchar *> image_queue;
-	uint max_image_queue_size = 200;
+	/* Bytes of image buffers waiting for the consumer before frame_policy applies */
+	size_t max_image_queue_bytes = 64 * 1024 * 1024;
+	/* FRAME_POLICY_LATEST keeps rendering when the consumer falls behind and
+	discards the oldest waiting images, so the consumer always gets the newest */
+	FramePolicy frame_policy = FRAME_POLICY_BLOCK;
+	/* Images the consumer may hold at once before handing them back with
+	release_image, the image pool is sized for it */
+	uint max_consumer_images = 1;
+	/* Viewpoint-image requests kept in flight on each connection, 1 waits for
+	each image before requesting the next */
+	uint pipeline_depth = 4;
+	/* Servers to render on and the number of connections to open, connection
+	i uses endpoints[i % endpoints.size()] and renders every
+	num_connections'th step starting at step i */
+	std::vector<PanguEndpoint> endpoints;
+	uint num_connections = 1;
+	/* Pack file of rendered images reused across runs, empty to always
+	render. Images are keyed by the step, the camera and scene_tag, so the
+	tag must change whenever the scene loaded in the server changes. The
+	camera comes from the server, so one connection is still opened when
+	every step is cached, the others are only opened to render */
+	std::string cache_path;
+	std::string scene_tag;
 
 	PanguServer(std::vector<PanguStep> *steps);
 	~PanguServer();
 	void start(uint max_frames);
 	void stop();
-	uchar * get_image(uint ms);
-	static std::vector<PanguStep> read_pangu_steps(std::string flight_file_path);
+	/* Next frame in step order, the image is nullptr once the flight has
+	ended or nothing arrived within ms. Images come from a fixed pool of
+	reusable buffers, consumers hand each one back with release_image rather
+	than freeing it. Rendering waits while the consumer holds more than
+	max_consumer_images */
+	PanguFrame get_image(uint ms);
+	void release_image(uchar *image);
+	/* Time spent with image_channel full and with it empty during the last
+	flight, kept after stop() until the next start() */
+	FrameChannelStats image_channel_stats() const;
 private:
-	char server_name[11] { "localhost" };
-	ushort server_port = 10363;
+	/* Cached image of a step in the pack's mapping, image is nullptr when the step has to be rendered */
+	struct CachedImage {
+		const uchar *image;
+		size_t size;
+
+		CachedImage() {
+			image = nullptr;
+			size = 0;
+		}
+	};
 
-	SOCKET sock;
+	std::vector<PanguConnection *> connections;
 	size_t single_img_size_bytes;
-	std::thread gen_thread;
+	FramePool frame_pool;
+	FrameCache frame_cache;
+	std::vector<CachedImage> cached_images;
+	double horizontal_fov = 0;
+	double vertical_fov = 0;
+	std::vector<std::thread> gen_threads;
+	std::thread release_thread;
+	FrameChannel<PanguFrame> image_channel;
+	/* Step the consumer expects next, any steps before the next frame were dropped */
+	uint next_step_idx = 0;
 	std::atomic<bool> exit = false;
 
 	uint max_frames = 0;
-	long long step_idx = 0;
+	long long max_step_idx = -1;
 	std::vector<PanguStep> *steps;
 
-	void _connect();
-	void _disconnect();
-	void generate_images();
-	static ulong host_id_to_address(char *s);
-	static size_t image_start_offset(uchar *image);
+	/* Images rendered out of order wait here until every earlier step has
+	been added to image_channel, slot step % reorder_buffer.size() */
+	std::mutex reorder_lock;
+	std::condition_variable reorder_filled;
+	std::condition_variable reorder_released;
+	std::vector<uchar *> reorder_buffer;
+	long long release_idx = 0;
+
+	void generate_images(uint connection_idx);
+	void request_image(PanguConnection &connection, long long request_step_idx);
+	uchar * receive_image(PanguConnection &connection, size_t &image_size_bytes);
+	unsigned long long image_key(long long step_idx) const;
+	/* Look up every step of the flight in the pack at cache_path, returns true if all are cached */
+	bool find_cached_images();
+	uchar * read_cached_image(long long step_idx);
+	bool wait_for_reorder_slot(long long request_step_idx, bool block);
+	void store_image(long long image_step_idx, uchar *image);
+	void release_images();
+	/* Most images image_channel holds within max_image_queue_bytes */
+	uint image_channel_size() const;
+	uint image_pool_size() const;
+	static size_t image_start_offset(const uchar *image);
 };
 
 #endif /* PANGU_SERVER_HPP */
@@ -0,0 +1,32 @@
+#include <fstream>
+#include <sstream>
+
+#include "pangu_step.hpp"
+
+std::vector<PanguStep> read_pangu_steps(const std::string &flight_file_path) {
+	std::vector<PanguStep> steps;
+
+	std::ifstream flight_file_stream(flight_file_path);
+
+	std::string line;
+	while(std::getline(flight_file_stream, line)) {
+		std::istringstream iss(line);
+
+		std::string start_token;
+		if(!(iss >> start_token) || start_token != "start") {
+			continue;
+		}
+
+		PanguStep step;
+		iss >> step.x;
+		iss >> step.y;
+		iss >> step.z;
+		iss >> step.yaw;
+		iss >> step.pitch;
+		iss >> step.roll;
+
+		steps.push_back(step);
+	}
+
+	return steps;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#ifndef PANGU_STEP_HPP
+#define PANGU_STEP_HPP
+
+#include <string>
+#include <vector>
+
+/* A camera viewpoint of a flight, position then yaw, pitch and roll in
+degrees as PANGU's SetViewpointByDegreesD takes them */
+struct PanguStep {
+	double x, y, z, yaw, pitch, roll;
+
+	PanguStep() {
+		/* Empty */
+	}
+
+	PanguStep(double x, double y, double z, double yaw, double pitch, double roll) {
+		this->x = x;
+		this->y = y;
+		this->z = z;
+		this->yaw = yaw;
+		this->pitch = pitch;
+		this->roll = roll;
+	}
+};
+
+/* Steps of a PANGU flight file, one per "start x y z yaw pitch roll" line,
+other lines are skipped */
+std::vector<PanguStep> read_pangu_steps(const std::string &flight_file_path);
+
+#endif /* PANGU_STEP_HPP */
@@ -0,0 +1,345 @@
+#define _USE_MATH_DEFINES
+#include <algorithm>
+#include <math.h>
+
+#include "synthetic_scene.hpp"
+
+/* Terrain texture octaves, each half the size of the one before. Octaves
+fade out once they are under a few pixels across so far terrain does not
+alias, and octaves beyond that are skipped */
+static const uint noise_octaves = 8;
+static const double noise_base_wavelength = 2048.0;
+static const uint crater_octaves = 10;
+static const double crater_base_cell = 4096.0;
+static const double crater_probability = 0.6;
+
+/* Direction of the light shaded into the crater texture, fixed to the
+terrain so the shading moves with it */
+static const double sun_x = 0.766;
+static const double sun_y = 0.643;
+
+/* Gaussian point spread of stars in pixels */
+static const float star_sigma = 0.8f;
+static const int star_radius = 3;
+
+static unsigned long long mix(unsigned long long x) {
+	x ^= x >> 33;
+	x *= 0xFF51AFD7ED558CCDULL;
+	x ^= x >> 33;
+	x *= 0xC4CEB9FE1A85EC53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+/* Cheaper than mix, good enough for texture lattices which are hashed tens
+of times per pixel */
+static unsigned long long hash_cell(long long i, long long j, unsigned long long salt) {
+	unsigned long long h = ((unsigned long long)i * 0x9E3779B97F4A7C15ULL) + ((unsigned long long)j * 0xC2B2AE3D27D4EB4FULL) + salt;
+	h ^= h >> 32;
+	h *= 0xD6E8FEB86659FD93ULL;
+	h ^= h >> 29;
+	return h;
+}
+
+/* Field of 16 bits of a hash in [0, 1) */
+static double hash_field(unsigned long long h, uint field) {
+	return ((h >> (field * 16)) & 0xFFFF) * (1.0 / 65536.0);
+}
+
+/* Uniform in [0, 1) from the top 53 bits of a hash */
+static double uniform(unsigned long long h) {
+	return (h >> 11) * (1.0 / 9007199254740992.0);
+}
+
+/* Weight of a texture detail size units across where a pixel covers
+footprint units, 0 below 1.5 pixels rising to 1 at 3 pixels */
+static double detail_weight(double size, double footprint) {
+	const double pixels = size / footprint;
+	return std::min(std::max((pixels - 1.5) / 1.5, 0.0), 1.0);
+}
+
+static double dot(const double *a, const double *b) {
+	return (a[0] * b[0]) + (a[1] * b[1]) + (a[2] * b[2]);
+}
+
+std::vector<PanguStep> synthetic_flight(SceneType type, uint num_steps) {
+	std::vector<PanguStep> steps;
+	steps.reserve(num_steps);
+	for(uint i=0; i<num_steps; ++i) {
+		if(type == SCENE_STARS) {
+			/* A slow tumble, around two pixels of motion per step */
+			steps.push_back(PanguStep(0, 0, 0, 0.06 * i, 10 + (5 * sin(i * 0.01)), 0.03 * i));
+		} else {
+			/* Drifting across the terrain while yawing and slowly changing
+			altitude, around two pixels of motion per step so features stay
+			inside the trackers' search area */
+			steps.push_back(PanguStep(1.5 * i, 0.5 * i, 1500 + (500 * cos(i * 0.002)), 0.03 * i, -90 + (2 * sin(i * 0.01)), 0));
+		}
+	}
+	return steps;
+}
+
+SyntheticScene::SyntheticScene(SceneType type, const SceneCamera &camera, uint num_threads, unsigned long long seed) :
+	type(type),
+	camera(camera),
+	seed(seed),
+	thread_pool(num_threads)
+{
+	focal_x = (camera.cols / 2.0) / tan(camera.horizontal_fov / 2);
+	focal_y = (camera.rows / 2.0) / tan(camera.vertical_fov / 2);
+	centre_x = (camera.cols - 1) / 2.0;
+	centre_y = (camera.rows - 1) / 2.0;
+
+	if(type == SCENE_STARS) {
+		/* Uniform over the sphere, with many faint stars and few bright ones */
+		stars.resize(num_stars);
+		for(uint i=0; i<num_stars; ++i) {
+			const unsigned long long h = hash_cell(i, 0, seed);
+			const double z = (uniform(h) * 2) - 1;
+			const double angle = uniform(mix(h)) * 2 * M_PI;
+			const double radius = sqrt(1 - (z * z));
+			stars[i].direction[0] = radius * cos(angle);
+			stars[i].direction[1] = radius * sin(angle);
+			stars[i].direction[2] = z;
+			stars[i].flux = (float)(10 * exp(-7 * uniform(mix(h ^ 0x5851F42D4C957F2DULL))));
+		}
+	}
+}
+
+void SyntheticScene::render(const PanguStep &step, uchar *pixels) {
+	const Pose camera_pose = pose(step);
+	if(type == SCENE_STARS) {
+		render_stars(camera_pose, pixels);
+	} else {
+		render_craters(camera_pose, pixels);
+	}
+}
+
+bool SyntheticScene::displace(const PanguStep &from, const PanguStep &to, double x, double y, double &to_x, double &to_y) const {
+	const Pose from_pose = pose(from);
+	const Pose to_pose = pose(to);
+
+	double direction[3];
+	ray(from_pose, x, y, direction);
+	if(type == SCENE_STARS) {
+		/* Stars are at infinity, so only the direction matters */
+		return project(to_pose, direction, to_x, to_y);
+	}
+
+	double point[3];
+	if(!ground_point(from_pose, direction, point)) {
+		return false;
+	}
+	const double relative[3] = {
+		point[0] - to_pose.position[0],
+		point[1] - to_pose.position[1],
+		point[2] - to_pose.position[2]
+	};
+	return project(to_pose, relative, to_x, to_y);
+}
+
+SyntheticScene::Pose SyntheticScene::pose(const PanguStep &step) const {
+	const double yaw = step.yaw * M_PI / 180;
+	const double pitch = step.pitch * M_PI / 180;
+	const double roll = step.roll * M_PI / 180;
+
+	/* Axes before roll, up is right x forward */
+	const double forward[3] = {-sin(yaw) * cos(pitch), cos(yaw) * cos(pitch), sin(pitch)};
+	const double right[3] = {cos(yaw), sin(yaw), 0};
+	const double up[3] = {sin(yaw) * sin(pitch), -cos(yaw) * sin(pitch), cos(pitch)};
+
+	Pose camera_pose;
+	camera_pose.position[0] = step.x;
+	camera_pose.position[1] = step.y;
+	camera_pose.position[2] = step.z;
+	for(uint i=0; i<3; ++i) {
+		camera_pose.forward[i] = forward[i];
+		camera_pose.right[i] = (right[i] * cos(roll)) + (up[i] * sin(roll));
+		camera_pose.up[i] = (up[i] * cos(roll)) - (right[i] * sin(roll));
+	}
+	return camera_pose;
+}
+
+void SyntheticScene::ray(const Pose &pose, double x, double y, double *direction) const {
+	const double camera_x = (x - centre_x) / focal_x;
+	const double camera_y = (centre_y - y) / focal_y;
+	double length = 0;
+	for(uint i=0; i<3; ++i) {
+		direction[i] = (pose.right[i] * camera_x) + (pose.up[i] * camera_y) + pose.forward[i];
+		length += direction[i] * direction[i];
+	}
+
+	length = sqrt(length);
+	for(uint i=0; i<3; ++i) {
+		direction[i] /= length;
+	}
+}
+
+bool SyntheticScene::project(const Pose &pose, const double *relative, double &x, double &y) const {
+	const double depth = dot(relative, pose.forward);
+	if(depth <= 0) {
+		return false;
+	}
+
+	x = centre_x + (focal_x * dot(relative, pose.right) / depth);
+	y = centre_y - (focal_y * dot(relative, pose.up) / depth);
+	return x >= -0.5 && y >= -0.5 && x < camera.cols - 0.5 && y < camera.rows - 0.5;
+}
+
+bool SyntheticScene::ground_point(const Pose &pose, const double *direction, double *point) const {
+	/* The terrain is only seen from above */
+	if(pose.position[2] <= 0 || direction[2] >= 0) {
+		return false;
+	}
+
+	const double distance = -pose.position[2] / direction[2];
+	for(uint i=0; i<3; ++i) {
+		point[i] = pose.position[i] + (direction[i] * distance);
+	}
+	return true;
+}
+
+void SyntheticScene::render_craters(const Pose &pose, uchar *pixels) {
+	thread_pool.parallel_for(0, camera.rows, tile_rows, [this, &pose, pixels](uint begin, uint end) {
+		for(uint y=begin; y<end; ++y) {
+			for(uint x=0; x<camera.cols; ++x) {
+				double direction[3];
+				double point[3];
+				ray(pose, x, y, direction);
+				if(!ground_point(pose, direction, point)) {
+					pixels[idx_1d(x, y, camera.cols)] = 0;
+					continue;
+				}
+
+				/* Ground covered by the pixel, stretched where the ray grazes the terrain */
+				const double distance = -pose.position[2] / direction[2];
+				const double footprint = distance / (focal_x * std::max(-direction[2], 0.05));
+				const float brightness = terrain_brightness(point[0], point[1], footprint);
+				pixels[idx_1d(x, y, camera.cols)] = (uchar)std::min(std::max(brightness * 255.0f, 0.0f), 255.0f);
+			}
+		}
+	});
+}
+
+void SyntheticScene::render_stars(const Pose &pose, uchar *pixels) {
+	projected_stars.clear();
+	for(size_t i=0; i<stars.size(); ++i) {
+		double x, y;
+		const double depth = dot(stars[i].direction, pose.forward);
+		if(depth <= 0) {
+			continue;
+		}
+		x = centre_x + (focal_x * dot(stars[i].direction, pose.right) / depth);
+		y = centre_y - (focal_y * dot(stars[i].direction, pose.up) / depth);
+		if(x > -star_radius && y > -star_radius && x < camera.cols + star_radius && y < camera.rows + star_radius) {
+			ProjectedStar star;
+			star.x = (float)x;
+			star.y = (float)y;
+			star.flux = stars[i].flux;
+			projected_stars.push_back(star);
+		}
+	}
+	std::sort(projected_stars.begin(), projected_stars.end(), [](const ProjectedStar &a, const ProjectedStar &b) {
+		return a.y < b.y;
+	});
+
+	thread_pool.parallel_for(0, camera.rows, tile_rows, [this, pixels](uint begin, uint end) {
+		std::vector<float> tile(camera.cols * (end - begin), 0.0f);
+
+		/* Only stars within star_radius of the tile's rows reach it */
+		ProjectedStar first;
+		first.y = (float)begin - star_radius;
+		std::vector<ProjectedStar>::const_iterator star = std::lower_bound(
+			projected_stars.begin(), projected_stars.end(), first,
+			[](const ProjectedStar &a, const ProjectedStar &b) { return a.y < b.y; }
+		);
+		for(; star != projected_stars.end() && star->y < (float)end + star_radius; ++star) {
+			const int star_x = (int)floorf(star->x + 0.5f);
+			const int star_y = (int)floorf(star->y + 0.5f);
+			const float peak = star->flux / (2 * (float)M_PI * star_sigma * star_sigma);
+			for(int y=std::max(star_y - star_radius, (int)begin); y<=std::min(star_y + star_radius, (int)end - 1); ++y) {
+				for(int x=std::max(star_x - star_radius, 0); x<=std::min(star_x + star_radius, (int)camera.cols - 1); ++x) {
+					const float dx = x - star->x;
+					const float dy = y - star->y;
+					tile[idx_1d(x, y - begin, camera.cols)] += peak * expf(-((dx * dx) + (dy * dy)) / (2 * star_sigma * star_sigma));
+				}
+			}
+		}
+
+		for(size_t i=0; i<tile.size(); ++i) {
+			pixels[idx_1d(0, begin, camera.cols) + i] = (uchar)std::min(tile[i] * 255.0f, 255.0f);
+		}
+	});
+}
+
+float SyntheticScene::terrain_brightness(double x, double y, double footprint) const {
+	double brightness = 0.45;
+
+	double wavelength = noise_base_wavelength;
+	double amplitude = 0.25;
+	for(uint k=0; k<noise_octaves; ++k, wavelength/=2, amplitude*=0.7) {
+		const double weight = detail_weight(wavelength, footprint);
+		if(weight == 0) {
+			break;
+		}
+		brightness += amplitude * weight * (value_noise(x / wavelength, y / wavelength, mix(seed + k)) - 0.5);
+	}
+
+	/* One crater at most per cell of each octave, kept inside its cell with
+	its rim so a point only has to look at the cell it falls in */
+	double cell = crater_base_cell;
+	for(uint k=0; k<crater_octaves; ++k, cell/=2) {
+		const double weight = detail_weight(cell * 0.2, footprint);
+		if(weight == 0) {
+			break;
+		}
+
+		const long long cell_x = (long long)floor(x / cell);
+		const long long cell_y = (long long)floor(y / cell);
+		const unsigned long long h = hash_cell(cell_x, cell_y, mix(seed ^ (0xA24BAED4963EE407ULL * (k + 1))));
+		if(hash_field(h, 0) >= crater_probability) {
+			continue;
+		}
+
+		const double radius = cell * (0.08 + (0.22 * hash_field(h, 1)));
+		const double margin = (cell / 2) - (radius * 1.5);
+		const double crater_x = ((cell_x + 0.5) * cell) + (margin * ((hash_field(h, 2) * 2) - 1));
+		const double crater_y = ((cell_y + 0.5) * cell) + (margin * ((hash_field(h, 3) * 2) - 1));
+		const double dx = x - crater_x;
+		const double dy = y - crater_y;
+		const double distance = sqrt((dx * dx) + (dy * dy));
+		const double d = distance / radius;
+		if(d >= 1.5 || distance == 0) {
+			continue;
+		}
+
+		/* Slope of a bowl rising to a sharp rim at d = 1 and falling away
+		outside it, lit along the terrain's sun direction */
+		const double slope = d < 1 ? 2 * d : -1.4 * (1 - ((d - 1) / 0.5));
+		const double lighting = slope * ((dx * sun_x) + (dy * sun_y)) / distance;
+		brightness += weight * ((0.3 * lighting) - (d < 1 ? 0.08 : 0));
+	}
+
+	return (float)brightness;
+}
+
+float SyntheticScene::value_noise(double x, double y, unsigned long long salt) const {
+	const double cell_x = floor(x);
+	const double cell_y = floor(y);
+	const long long i = (long long)cell_x;
+	const long long j = (long long)cell_y;
+
+	/* Smoothstep between the lattice values so the noise has no creases */
+	double fx = x - cell_x;
+	double fy = y - cell_y;
+	fx = fx * fx * (3 - (2 * fx));
+	fy = fy * fy * (3 - (2 * fy));
+
+	const double v00 = uniform(hash_cell(i, j, salt));
+	const double v10 = uniform(hash_cell(i + 1, j, salt));
+	const double v01 = uniform(hash_cell(i, j + 1, salt));
+	const double v11 = uniform(hash_cell(i + 1, j + 1, salt));
+	const double top = v00 + ((v10 - v00) * fx);
+	const double bottom = v01 + ((v11 - v01) * fx);
+	return (float)(top + ((bottom - top) * fy));
+}
@@ -0,0 +1,118 @@
+#pragma once
+#ifndef SYNTHETIC_SCENE_HPP
+#define SYNTHETIC_SCENE_HPP
+
+#include <vector>
+
+#include "Pangu/pangu_step.hpp"
+#include "Utils/thread_pool.hpp"
+#include "Utils/types.hpp"
+#include "Utils/utils.hpp"
+
+/* CRATERS is a flat plane at z = 0 seen from above, textured with noise
+and craters whose relief is shaded into the texture rather than modelled,
+so the ground truth stays exact. STARS is a field of point sources at
+infinity, so only the camera's rotation moves them */
+enum SceneType {
+	SCENE_CRATERS,
+	SCENE_STARS
+};
+
+inline const char *scene_type_name(SceneType type) {
+	switch(type) {
+		case SCENE_CRATERS: return "craters";
+		default: return "stars";
+	}
+}
+
+/* Camera the scene is rendered by, fields of view in radians as PANGU reports them */
+struct SceneCamera {
+	uint cols;
+	uint rows;
+	double horizontal_fov;
+	double vertical_fov;
+
+	SceneCamera() {
+		cols = 1024;
+		rows = 768;
+		horizontal_fov = 0.5235987756;
+		vertical_fov = 0.5235987756;
+	}
+};
+
+/* A flight through the scene for when no flight file is given, moving a
+few pixels per step so the trackers can follow it */
+std::vector<PanguStep> synthetic_flight(SceneType type, uint num_steps);
+
+/* Procedural stand-in for PANGU, rendering the view from a flight step on
+every build host and knowing exactly where each image point moves between
+steps. Steps follow the flight files: yaw 0 looks along +y and positive yaw
+turns towards -x, pitch -90 looks straight down and roll turns the camera
+about its view axis. Image coordinates put pixel centres on whole numbers,
+as the trackers report feature locations */
+class SyntheticScene {
+public:
+	/* The same type, camera and seed always render the same images. num_threads
+	of 0 uses one thread per hardware thread */
+	SyntheticScene(SceneType type, const SceneCamera &camera, uint num_threads, unsigned long long seed);
+
+	/* Render the view from step into cols x rows pixels */
+	void render(const PanguStep &step, uchar *pixels);
+
+	/* Where the scene point at image point (x, y) seen from step from appears
+	from step to. Returns false when no scene point is seen there or it is
+	out of view from to */
+	bool displace(const PanguStep &from, const PanguStep &to, double x, double y, double &to_x, double &to_y) const;
+
+	SceneType scene_type() const { return type; }
+	const SceneCamera &scene_camera() const { return camera; }
+
+private:
+	/* Camera position and axes in world coordinates */
+	struct Pose {
+		double position[3];
+		double right[3];
+		double up[3];
+		double forward[3];
+	};
+
+	struct Star {
+		double direction[3];
+		float flux;
+	};
+
+	struct ProjectedStar {
+		float x;
+		float y;
+		float flux;
+	};
+
+	/* Rows rendered per thread pool task */
+	const static uint tile_rows = 8;
+	const static uint num_stars = 60000;
+
+	SceneType type;
+	SceneCamera camera;
+	unsigned long long seed;
+	double focal_x;
+	double focal_y;
+	double centre_x;
+	double centre_y;
+	ThreadPool thread_pool;
+
+	std::vector<Star> stars;
+	/* Stars in view of the frame being rendered, ordered by row */
+	std::vector<ProjectedStar> projected_stars;
+
+	Pose pose(const PanguStep &step) const;
+	void ray(const Pose &pose, double x, double y, double *direction) const;
+	bool project(const Pose &pose, const double *relative, double &x, double &y) const;
+	bool ground_point(const Pose &pose, const double *direction, double *point) const;
+
+	void render_craters(const Pose &pose, uchar *pixels);
+	void render_stars(const Pose &pose, uchar *pixels);
+	float terrain_brightness(double x, double y, double footprint) const;
+	float value_noise(double x, double y, unsigned long long salt) const;
+};
+
+#endif /* SYNTHETIC_SCENE_HPP */
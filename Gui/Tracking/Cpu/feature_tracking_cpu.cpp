@@ -1,24 +1,33 @@
 #include <cmath>
 #include <cstdlib>
-#include <limits>
 #include <algorithm>
+#include <string.h>
 
 #include "feature_tracking_cpu.hpp"
 
-struct TempPointData {
-	Point location;
-	float corner_response;
-};
-
-struct sort_by_corner_response {
-	bool operator()(TempPointData const &left, TempPointData const &right) {
-		return left.corner_response > right.corner_response;
-	}
-};
+FeatureTrackingCpu::FeatureTrackingCpu(const TrackingSettings &tracking_settings) :
+	FeatureTrackingCpu(tracking_settings, true)
+{
+	/* Empty */
+}
 
-FeatureTrackingCpu::FeatureTrackingCpu(const TrackingSettings tracking_settings) :
+FeatureTrackingCpu::FeatureTrackingCpu(const TrackingSettings &tracking_settings, bool allocate_intermediate_images) :
 	FeatureTracking(),
-	settings(tracking_settings)
+	settings(tracking_settings),
+	thread_pool(tracking_settings.num_threads),
+	sobel_row(sobel_row_function(detect_simd_level())),
+	gradient_x2(nullptr),
+	gradient_y2(nullptr),
+	gradient_xy(nullptr),
+	horizontal_blur_x2(nullptr),
+	horizontal_blur_y2(nullptr),
+	horizontal_blur_xy(nullptr),
+	blur_gradient_x2(nullptr),
+	blur_gradient_y2(nullptr),
+	blur_gradient_xy(nullptr),
+	harris_response(nullptr),
+	horizontal_max_response(nullptr),
+	max_response(nullptr)
 {
 	gradient_cols = image_width - 2;
 	gradient_rows = image_height - 2;
@@ -29,346 +38,374 @@ FeatureTrackingCpu::FeatureTrackingCpu(const TrackingSettings tracking_settings)
 	harris_response_cols = blur_gradient_cols;
 	harris_response_rows = blur_gradient_rows;
 
-	normalized_input_image = (float *)malloc(image_width * image_height * sizeof(float));
 	tracked_feature_map = (bool *)malloc(image_width * image_height * sizeof(bool));
 	memset(tracked_feature_map, false, image_width * image_height * sizeof(bool));
+	maxima_suppression.resize(harris_response_cols * harris_response_rows);
+
+	/* Without the summed area tables the correlation search sums each window itself */
+	integral_image = nullptr;
+	integral_image_sq = nullptr;
+	if(!allocate_intermediate_images) {
+		return;
+	}
+
+	integral_image = (uint *)calloc((image_width + 1) * (image_height + 1), sizeof(uint));
+	integral_image_sq = (unsigned long long *)calloc((image_width + 1) * (image_height + 1), sizeof(unsigned long long));
+
 	gradient_x2 = (short *)malloc(gradient_cols * gradient_rows * sizeof(float));
 	gradient_y2 = (short *)malloc(gradient_cols * gradient_rows * sizeof(float));
 	gradient_xy = (short *)malloc(gradient_cols * gradient_rows * sizeof(float));
+	horizontal_blur_x2 = (float *)malloc(blur_gradient_cols * gradient_rows * sizeof(float));
+	horizontal_blur_y2 = (float *)malloc(blur_gradient_cols * gradient_rows * sizeof(float));
+	horizontal_blur_xy = (float *)malloc(blur_gradient_cols * gradient_rows * sizeof(float));
 	blur_gradient_x2 = (float *)malloc(blur_gradient_cols * blur_gradient_rows * sizeof(float));
 	blur_gradient_y2 = (float *)malloc(blur_gradient_cols * blur_gradient_rows * sizeof(float));
 	blur_gradient_xy = (float *)malloc(blur_gradient_cols * blur_gradient_rows * sizeof(float));
 	harris_response = (float *)malloc(harris_response_cols * harris_response_rows * sizeof(float));
-	maxima_suppression = (bool *)malloc(harris_response_cols * harris_response_rows * sizeof(bool));
+
+	if(settings.suppression_mode == SUPPRESSION_DENSE) {
+		horizontal_max_response = (float *)malloc(harris_response_cols * harris_response_rows * sizeof(float));
+		max_response = (float *)malloc(harris_response_cols * harris_response_rows * sizeof(float));
+	}
 }
 
 FeatureTrackingCpu::~FeatureTrackingCpu() {
-	free(normalized_input_image);
 	free(tracked_feature_map);
+	free(integral_image);
+	free(integral_image_sq);
 	free(gradient_x2);
 	free(gradient_y2);
 	free(gradient_xy);
+	free(horizontal_blur_x2);
+	free(horizontal_blur_y2);
+	free(horizontal_blur_xy);
 	free(blur_gradient_x2);
 	free(blur_gradient_y2);
 	free(blur_gradient_xy);
 	free(harris_response);
-	free(maxima_suppression);
+	free(horizontal_max_response);
+	free(max_response);
 }
 
-void __inline FeatureTrackingCpu::create_normalized_input_image() {
-#pragma loop(hint_parallel(MAX_AP_THREADS))
-	for(uint y=0; y<image_height; ++y) {
-		for(uint x=0; x<image_width; ++x) {
-			const uint idx = idx_1d(x, y, image_width);
-			normalized_input_image[idx] = uchar_normalize_table[input_image[idx]];
-		}
-	}
+uint FeatureTrackingCpu::tile_rows(size_t row_bytes) const {
+	return (uint)std::max<size_t>(tile_size_bytes / row_bytes, 1);
 }
 
 void FeatureTrackingCpu::calc_gradients() {
-#pragma loop(hint_parallel(MAX_AP_THREADS))
-	for(uint y=1; y<gradient_rows; ++y) {
-		for(uint x=1; x<gradient_cols; ++x) {
-			const uint gradient_idx = (gradient_cols * (y-1)) + (x-1);
-
-			const short gradient_x = (
-				(sobel_x[0] * input_image[idx_1d(x-1, y-1, image_width)]) +
-				(sobel_x[1] * input_image[idx_1d(x+0, y-1, image_width)]) +
-				(sobel_x[2] * input_image[idx_1d(x+1, y-1, image_width)]) +
-				(sobel_x[3] * input_image[idx_1d(x-1, y+0, image_width)]) +
-				(sobel_x[4] * input_image[idx_1d(x+0, y+0, image_width)]) +
-				(sobel_x[5] * input_image[idx_1d(x+1, y+0, image_width)]) +
-				(sobel_x[6] * input_image[idx_1d(x-1, y+1, image_width)]) +
-				(sobel_x[7] * input_image[idx_1d(x+0, y+1, image_width)]) +
-				(sobel_x[8] * input_image[idx_1d(x+1, y+1, image_width)])
-			);
-
-			const short gradient_y = (
-				(sobel_y[0] * input_image[idx_1d(x-1, y-1, image_width)]) +
-				(sobel_y[1] * input_image[idx_1d(x+0, y-1, image_width)]) +
-				(sobel_y[2] * input_image[idx_1d(x+1, y-1, image_width)]) +
-				(sobel_y[3] * input_image[idx_1d(x-1, y+0, image_width)]) +
-				(sobel_y[4] * input_image[idx_1d(x+0, y+0, image_width)]) +
-				(sobel_y[5] * input_image[idx_1d(x+1, y+0, image_width)]) +
-				(sobel_y[6] * input_image[idx_1d(x-1, y+1, image_width)]) +
-				(sobel_y[7] * input_image[idx_1d(x+0, y+1, image_width)]) +
-				(sobel_y[8] * input_image[idx_1d(x+1, y+1, image_width)])
+	/* Tiles are bands of gradient rows, each reading a one pixel halo of input rows */
+	const uint rows = tile_rows((image_width * sizeof(uchar)) + (gradient_cols * sizeof(short) * 3));
+	thread_pool.parallel_for(0, gradient_rows, rows, [this](uint begin, uint end) {
+		for(uint y=begin; y<end; ++y) {
+			const uint gradient_idx = idx_1d(0, y, gradient_cols);
+			sobel_row(
+				&input_image[idx_1d(0, y+0, image_width)],
+				&input_image[idx_1d(0, y+1, image_width)],
+				&input_image[idx_1d(0, y+2, image_width)],
+				gradient_cols,
+				&gradient_x2[gradient_idx],
+				&gradient_y2[gradient_idx],
+				&gradient_xy[gradient_idx]
 			);
+		}
+	});
+}
 
-			gradient_x2[gradient_idx] = gradient_x * gradient_x;
-			gradient_y2[gradient_idx] = gradient_y * gradient_y;
-			gradient_xy[gradient_idx] = gradient_x  * gradient_y;
+void FeatureTrackingCpu::calc_harris_response() {
+	const uint rows = tile_rows(blur_gradient_cols * sizeof(float) * 4);
+	thread_pool.parallel_for(0, blur_gradient_rows, rows, [this](uint begin, uint end) {
+		for(uint y=begin; y<end; ++y) {
+			const uint idx = idx_1d(0, y, blur_gradient_cols);
+			harris_response_row(&blur_gradient_x2[idx], &blur_gradient_y2[idx], &blur_gradient_xy[idx], blur_gradient_cols, settings.sensitivity, &harris_response[idx]);
 		}
+	});
+
+	if(capture) {
+		capture->response_cols = harris_response_cols;
+		capture->response_rows = harris_response_rows;
+		capture->response.assign(harris_response, harris_response + (harris_response_cols * harris_response_rows));
 	}
 }
 
-void FeatureTrackingCpu::blur_gradient(short *gradient_img, float *blur_gradient_img) {
-#pragma loop(hint_parallel(MAX_AP_THREADS))
-	for(uint y=filter_range; y<gradient_rows-filter_range; ++y) {
-		for(uint x=filter_range; x<gradient_cols-filter_range; ++x) {
-			float total = 0.0;
-
-			for(uint y2=y-filter_range, gauss_y=0; y2<y+filter_range; ++y2, ++gauss_y) {
-				for(uint x2=x-filter_range, gauss_x=0; x2<x+filter_range; ++x2, ++gauss_x) {
-					total += gaussian_matrix[idx_1d(gauss_x, gauss_y, filter_width)] * gradient_img[idx_1d(x2, y2, gradient_cols)];
-				}
+void FeatureTrackingCpu::blur_gradients() {
+	/* gaussian_matrix is separable, so blur with a horizontal 7-tap pass followed
+	by a vertical 7-tap pass, handling all three gradient images in the same sweep */
+	const uint horizontal_rows = tile_rows((gradient_cols * sizeof(short) * 3) + (blur_gradient_cols * sizeof(float) * 3));
+	thread_pool.parallel_for(0, gradient_rows, horizontal_rows, [this](uint begin, uint end) {
+		for(uint y=begin; y<end; ++y) {
+			const uint gradient_idx = idx_1d(0, y, gradient_cols);
+			const uint blur_idx = idx_1d(0, y, blur_gradient_cols);
+			horizontal_blur_row(
+				&gradient_x2[gradient_idx], &gradient_y2[gradient_idx], &gradient_xy[gradient_idx], blur_gradient_cols,
+				gaussian_kernel, filter_width,
+				&horizontal_blur_x2[blur_idx], &horizontal_blur_y2[blur_idx], &horizontal_blur_xy[blur_idx]
+			);
+		}
+	});
+
+	/* Each band of output rows reads a halo of filter_width-1 rows below it */
+	const uint vertical_rows = tile_rows(blur_gradient_cols * sizeof(float) * 6);
+	thread_pool.parallel_for(0, blur_gradient_rows, vertical_rows, [this](uint begin, uint end) {
+		const float *rows_x2[filter_width];
+		const float *rows_y2[filter_width];
+		const float *rows_xy[filter_width];
+		for(uint y=begin; y<end; ++y) {
+			for(uint k=0; k<filter_width; ++k) {
+				const uint idx = idx_1d(0, y+k, blur_gradient_cols);
+				rows_x2[k] = &horizontal_blur_x2[idx];
+				rows_y2[k] = &horizontal_blur_y2[idx];
+				rows_xy[k] = &horizontal_blur_xy[idx];
 			}
 
-			blur_gradient_img[idx_1d(x-filter_range, y-filter_range, blur_gradient_cols)] = total;
+			const uint idx = idx_1d(0, y, blur_gradient_cols);
+			vertical_blur_row(
+				rows_x2, rows_y2, rows_xy, blur_gradient_cols,
+				gaussian_kernel, filter_width,
+				&blur_gradient_x2[idx], &blur_gradient_y2[idx], &blur_gradient_xy[idx]
+			);
 		}
-	}
+	});
 }
 
-void FeatureTrackingCpu::calc_harris_response() {
-#pragma loop(hint_parallel(MAX_AP_THREADS))
-	for(uint y=0; y<blur_gradient_rows; ++y) {
-		for(uint x=0; x<blur_gradient_cols; ++x) {
-			const uint idx = idx_1d(x, y, blur_gradient_cols);
+void FeatureTrackingCpu::calc_max_response() {
+	const uint range = settings.suppression_range;
+
+	/* Rows are filtered one at a time, then columns are filtered a strip
+	of columns wide so every read is a contiguous run of a row */
+	const uint rows = tile_rows(harris_response_cols * sizeof(float) * 2);
+	thread_pool.parallel_for(0, harris_response_rows, rows, [this, range](uint begin, uint end) {
+		std::vector<float> forward(harris_response_cols + (range * 2));
+		std::vector<float> backward(harris_response_cols + (range * 2));
+		for(uint y=begin; y<end; ++y) {
+			const uint row = idx_1d(0, y, harris_response_cols);
+			max_filter_line(&harris_response[row], &horizontal_max_response[row], harris_response_cols, 1, 1, range, forward.data(), backward.data());
+		}
+	});
 
-			const float gx2 = blur_gradient_x2[idx];
-			const float gy2 = blur_gradient_y2[idx];
-			const float gxy = blur_gradient_xy[idx];
+	thread_pool.parallel_for(0, harris_response_cols, max_filter_strip_cols, [this, range](uint begin, uint end) {
+		std::vector<float> forward((harris_response_rows + (range * 2)) * (end - begin));
+		std::vector<float> backward((harris_response_rows + (range * 2)) * (end - begin));
+		max_filter_line(&horizontal_max_response[begin], &max_response[begin], harris_response_rows, harris_response_cols, end - begin, range, forward.data(), backward.data());
+	});
+}
 
-			const float det = (gx2 * gy2) - (gxy * gxy);
-			const float trace = gx2 + gy2;
+void FeatureTrackingCpu::get_maxima_points() {
+	const bool dense = settings.suppression_mode == SUPPRESSION_DENSE;
+	if(dense) {
+		calc_max_response();
+	}
 
-			harris_response[idx] = det - (settings.sensitivity * (trace * trace));
+	/* Each tile collects its candidates separately, they are joined
+	in tile order so the result does not depend on scheduling */
+	const uint rows = tile_rows(harris_response_cols * sizeof(float));
+	tile_candidates.resize(ThreadPool::tile_count(0, harris_response_rows, rows));
+	thread_pool.parallel_for(0, harris_response_rows, rows, [this, rows, dense](uint begin, uint end) {
+		std::vector<TempPointData> &points = tile_candidates[begin / rows];
+		points.clear();
+
+		/* In dense mode only the maximum of each window is a candidate */
+		for(uint y=begin; y<end; ++y) {
+			const uint idx = idx_1d(0, y, harris_response_cols);
+			collect_candidates_row(&harris_response[idx], dense ? &max_response[idx] : nullptr, harris_response_cols, y, settings.harris_response_threshhold, points);
 		}
-	}
-}
+	});
 
-void __inline FeatureTrackingCpu::blur_gradients() {
-	blur_gradient(gradient_x2, blur_gradient_x2);
-	blur_gradient(gradient_y2, blur_gradient_y2);
-	blur_gradient(gradient_xy, blur_gradient_xy);
+	merge_tile_candidates();
+	select_maxima_points();
 }
 
-void FeatureTrackingCpu::get_maxima_points() {
-	memset(maxima_suppression, 1, harris_response_cols * harris_response_rows * sizeof(bool));
-
-	std::vector<TempPointData> points;
-#pragma loop(hint_parallel(MAX_AP_THREADS))
-	for(uint y=0; y<harris_response_rows; ++y) {
-		for(uint x=0; x<harris_response_cols; ++x) {
-			TempPointData d;
-			d.corner_response = harris_response[idx_1d(x, y, harris_response_cols)];
-			d.location.x = x;
-			d.location.y = y;
-
-			if(d.corner_response > settings.harris_response_threshhold) {
-				points.push_back(d);
-			}
-		}
+void FeatureTrackingCpu::merge_tile_candidates() {
+	size_t num_candidates = 0;
+	for(size_t i=0; i<tile_candidates.size(); ++i) {
+		num_candidates += tile_candidates[i].size();
 	}
 
-	sort(points.begin(), points.end(), sort_by_corner_response());
+	maxima_candidates.clear();
+	maxima_candidates.reserve(num_candidates);
+	for(size_t i=0; i<tile_candidates.size(); ++i) {
+		maxima_candidates.insert(maxima_candidates.end(), tile_candidates[i].begin(), tile_candidates[i].end());
+	}
+}
+
+void FeatureTrackingCpu::select_maxima_points() {
+	const uint suppressed = select_maxima(
+		maxima_candidates, harris_response_cols, harris_response_rows, settings.suppression_range,
+		settings.max_tracked_features, candidate_batch_factor,
+		maxima_suppression, selected_candidates
+	);
 
 	harris_points.clear();
+	harris_points.reserve(settings.max_tracked_features);
+	for(size_t i=0; i<selected_candidates.size(); ++i) {
+		const TempPointData &point = selected_candidates[i];
 
-	for(size_t i=0; harris_points.size()<settings.max_tracked_features && i<points.size(); ++i) {
-		if(maxima_suppression[idx_1d(points[i].location.x, points[i].location.y, harris_response_cols)] == true) {
-			for(char y=-maxima_suppression_range; y<=maxima_suppression_range; ++y) {
-				for(char x=-maxima_suppression_range; x<=maxima_suppression_range; ++x) {
-					int sx = points[i].location.x + x;
-					int sy = points[i].location.y + y;
-					sx = sx >= harris_response_cols ? harris_response_cols-1 : sx < 0 ? 0 : sx;
-					sy = sy >= harris_response_rows ? harris_response_rows-1 : sy < 0 ? 0 : sy;
-
-					const uint idx = idx_1d(sx, sy, harris_response_cols);
-					maxima_suppression[idx] = false;
-				}
-			}
+		PointData harris_point;
+		harris_point.location.x = point.location.x + 1 + filter_range;
+		harris_point.location.y = point.location.y + 1 + filter_range;
+		harris_point.corner_response = point.corner_response;
 
-			HarrisPoint harris_point;
-			harris_point.locations[0].x = points[i].location.x + 1 + filter_range;
-			harris_point.locations[0].y = points[i].location.y + 1 + filter_range;
-
-			for(char window_offset_y=-3, template_y=0; window_offset_y<=3; ++window_offset_y, ++template_y) {
-				for(char window_offset_x=-3, template_x=0; window_offset_x<=3; ++window_offset_x, ++template_x) {
-					int window_x = harris_point.locations[0].x + window_offset_x;
-					int window_y = harris_point.locations[0].y + window_offset_y;
-					window_x = window_x >= image_width ? image_width-1 : window_x < 0 ? 0 : window_x;
-					window_y = window_y >= image_height ? image_height-1 : window_y < 0 ? 0 : window_y;
-					harris_point.signature[(template_y * 7) + template_x] = normalized_input_image[idx_1d(window_x, window_y, image_width)];
-				}
-			}
+		cut_signature(input_image, image_width, image_height, harris_point.location, uchar_normalize_table, harris_point.signature);
 
-			harris_points.push_back(harris_point);
-		}
+		harris_points.push_back(harris_point);
 	}
-}
 
-float __inline FeatureTrackingCpu::get_template_average(float *signature) {
-	float template_average = 0.0f;
-	for(uchar i=0; i<49; ++i) {
-		template_average += signature[i];
+	if(capture) {
+		capture->harris_points.clear();
+		for(size_t i=0; i<harris_points.size(); ++i) {
+			capture->harris_points.push_back(harris_points[i].location);
+		}
 	}
-	return template_average /= 49.0f;
+
+	TRACKING_STATS_SET(candidates, (uint)maxima_candidates.size());
+	TRACKING_STATS_SET(suppressed, suppressed);
 }
 
-float FeatureTrackingCpu::get_window_average(uint x, uint y) {
-	float window_average = 0.0f;
-	for(char window_offset_y=-3; window_offset_y<=3; ++window_offset_y) {
-		for(char window_offset_x=-3; window_offset_x<=3; ++window_offset_x) {
-			int window_x = x + window_offset_x;
-			int window_y = y + window_offset_y;
-			window_x = window_x >= image_width ? image_width-1 : window_x < 0 ? 0 : window_y;
-			window_y = window_y >= image_height ? image_height-1 : window_y < 0 ? 0 : window_y;
-			window_average += normalized_input_image[idx_1d(window_x, window_y, image_width)];
+void FeatureTrackingCpu::build_integral_images() {
+	const uint integral_cols = image_width + 1;
+
+	/* Row prefix sums, row 0 of the integral images stays zero */
+	const uint rows = tile_rows(image_width * (sizeof(uchar) + sizeof(uint) + sizeof(unsigned long long)));
+	thread_pool.parallel_for(0, image_height, rows, [this, integral_cols](uint begin, uint end) {
+		for(uint y=begin; y<end; ++y) {
+			integral_row(
+				&input_image[idx_1d(0, y, image_width)], image_width,
+				&integral_image[idx_1d(0, y+1, integral_cols)], &integral_image_sq[idx_1d(0, y+1, integral_cols)]
+			);
 		}
-	}
-	return window_average /= 49.0f;
+	});
+
+	/* Accumulate down the columns, split into strips of columns */
+	const uint strip_cols = 64;
+	thread_pool.parallel_for(1, integral_cols, strip_cols, [this, integral_cols](uint begin, uint end) {
+		for(uint y=2; y<=image_height; ++y) {
+			integral_accumulate_row(
+				&integral_image[idx_1d(0, y-1, integral_cols)], &integral_image_sq[idx_1d(0, y-1, integral_cols)], begin, end,
+				&integral_image[idx_1d(0, y, integral_cols)], &integral_image_sq[idx_1d(0, y, integral_cols)]
+			);
+		}
+	});
 }
 
 bool FeatureTrackingCpu::track_point(Point old_location, float *signature, Point &new_location) {
-	/* Calculate average for the point's 7x7 template window */
-	const float template_average = get_template_average(signature);
+	TrackingFrame frame;
+	frame.input = input_image;
+	frame.integral = integral_image;
+	frame.integral_sq = integral_image_sq;
+	frame.cols = image_width;
+	frame.rows = image_height;
+	return track_template(frame, old_location, signature, new_location) >= settings.correlation_threshhold;
+}
+
+void FeatureTrackingCpu::track_feature(uint idx, TrackResult &result) {
+	const Point location = tracked_features.location(idx);
+	const uint track_frames = tracked_features.track_frames(idx);
 
-	/* Track maximum correlation value and its location */
-	float max_correlation_value = std::numeric_limits<float>::min();
 	Point max_correlation_point;
-	max_correlation_point.x = 0;
-	max_correlation_point.y = 0;
-
-	/* Evaluate correlation value of each pixel in an area around the current tracked feature */
-	for(char search_area_offset_y=-3; search_area_offset_y<=3; ++search_area_offset_y) {
-		for(char search_area_offset_x=-3; search_area_offset_x<=3; ++search_area_offset_x) {
-			/* Add offset to current tracked feature to get X and Y coordinates of point
-			in the search area currently being evaluated for correlation */
-			const int search_area_x = old_location.x + search_area_offset_x;
-			const int search_area_y = old_location.y + search_area_offset_y;
-
-			/* Return if this point in the window is outside the image */
-			if(search_area_x>=image_width || search_area_x<0 || search_area_y>=image_height || search_area_y<0) {
-				break;
-			}
+	bool over_threshhold = track_point(location, tracked_features.signature(idx), max_correlation_point);
+
+	result.template_replaced = false;
+	if((track_frames + 1) % (settings.template_update_frames * 2) == 0) {
+		Point max_correlation_point_new_template;
+		bool over_threshhold_new_template = track_point(location, tracked_features.new_signature(idx), max_correlation_point_new_template);
+		if(over_threshhold_new_template && distance(max_correlation_point, max_correlation_point_new_template) < settings.template_update_distance_threshhold) {
+			result.location = max_correlation_point_new_template;
+			result.success = true;
+			result.template_replaced = true;
+		} else {
+			result.success = false;
+		}
+	} else {
+		result.location = max_correlation_point;
+		result.success = over_threshhold;
+	}
+}
 
-			/* Sum up intermediary values in a window around the current search area pixel
-			for calculating the correlation value for that pixel */
-			float ixy = 0.0f;
-			float ix2 = 0.0f;
-			float iy2 = 0.0f;
-			for(char window_offset_y=-3, template_y=0; window_offset_y<=3; ++window_offset_y, ++template_y) {
-				for(char window_offset_x=-3, template_x=0; window_offset_x<=3; ++window_offset_x, ++template_x) {
-					int window_x = search_area_x + window_offset_x;
-					int window_y = search_area_y + window_offset_y;
-					window_x = window_x >= image_width ? image_width-1 : window_x < 0 ? 0 : window_x;
-					window_y = window_y >= image_height ? image_height-1 : window_y < 0 ? 0 : window_y;
-
-					float window_average = get_window_average(window_x, window_y);
-
-					float pixel_value = normalized_input_image[idx_1d(window_x, window_y, image_width)];
-					float template_value = signature[(template_y * 7) + template_x];
-
-					float ix = pixel_value - window_average;
-					float iy = template_value - template_average;
-
-					ixy += ix * iy;
-					ix2 += ix * ix;
-					iy2 += iy * iy;
-				}
-			}
+void FeatureTrackingCpu::merge_track_results() {
+	/* Apply results in feature order so the map and feature store are the
+	same for any thread count. That order is the store's, which remove()
+	changes, and it matters: a feature clearing its old location can clear
+	the spot an earlier feature just moved to, and the map decides which new
+	corners are added. So the features tracked can differ from those of an
+	order preserving store, not only their order */
+	const uint num_tracked = tracked_features.size();
+	uint lost = 0;
+	for(uint i=0; i<num_tracked; ++i) {
+		const TrackResult &result = track_results[i];
+
+		/* Remove old tracked point from map */
+		const Point old_location = tracked_features.location(i);
+		tracked_feature_map[idx_1d(old_location.x, old_location.y, image_width)] = false;
+
+		if(!result.success) {
+			++lost;
+			continue;
+		}
 
-			/* Calculate correlation value for the current search area pixel */
-			float correlation = ixy / sqrt(ix2 * iy2);
+		const Point new_location = result.location;
+		if(result.template_replaced) {
+			memcpy(tracked_features.new_signature(i), tracked_features.signature(i), 49 * sizeof(float));
+		}
 
-			/* If this correlation value is the new highest */
-			/* Update the current highest correlation value and location */
-			if(correlation > max_correlation_value) {
-				max_correlation_value = correlation;
-				max_correlation_point.x = search_area_x;
-				max_correlation_point.y = search_area_y;
-			}
+		const uint track_frames = ++tracked_features.track_frames(i);
+
+		/* Add new tracked point to map and the feature's location history */
+		tracked_feature_map[idx_1d(new_location.x, new_location.y, image_width)] = true;
+		tracked_features.move(i, new_location);
+
+		/* If we have tracked this point for enough frames to trigger template updating */
+		if(track_frames % settings.template_update_frames == 0 && (track_frames + 1) % (settings.template_update_frames * 2) != 0) {
+			/* Update the tracked feature's 7x7 template to that of its current location in the image */
+			cut_signature(input_image, image_width, image_height, new_location, uchar_normalize_table, tracked_features.new_signature(i));
 		}
 	}
 
-	new_location = max_correlation_point;
-	return max_correlation_value >= settings.correlation_threshhold;
+	/* Correlation value was not above threshhold, these features have been
+	lost. Walking backwards means the feature moved into a hole has already
+	been checked */
+	for(uint i=num_tracked; i-->0;) {
+		if(!track_results[i].success) {
+			tracked_features.remove(i);
+		}
+	}
+
+	TRACKING_STATS_SET(tracked, num_tracked - lost);
+	TRACKING_STATS_SET(lost, lost);
 }
 
 void FeatureTrackingCpu::update_tracked_features() {
 	if(image_count == 0) {
 		/* If this is the first image, just use the harris corners detected */
-		tracked_features = harris_points;
-		for(int i=tracked_features.size()-1; i>=0; --i) {
-			const uint idx = tracked_features[i].location_idx;
-			const uint x = tracked_features[i].locations[idx].x;
-			const uint y = tracked_features[i].locations[idx].y;
-			tracked_feature_map[idx_1d(x, y, image_width)] = true;
+		tracked_features.clear();
+		tracked_features.reserve(settings.max_tracked_features);
+		for(size_t i=0; i<harris_points.size(); ++i) {
+			const Point location = harris_points[i].location;
+			tracked_features.add(location, harris_points[i].signature);
+			tracked_feature_map[idx_1d(location.x, location.y, image_width)] = true;
 		}
+		TRACKING_STATS_SET(added, (uint)harris_points.size());
 		return;
 	}
 
-	/* For each previously tracked feature */
-	for(uint i=0; i<tracked_features.size(); ++i) {
-		HarrisPoint *feature = &tracked_features[i];
-
-		Point new_location;
-
-		Point max_correlation_point;
-		bool over_threshhold = track_point(feature->locations[feature->location_idx], feature->signature, max_correlation_point);
-		bool track_success;
-
-		if((tracked_features[i].track_frames + 1) % (settings.template_update_frames * 2) == 0) {
-			Point max_correlation_point_new_template;
-			bool over_threshhold_new_template = track_point(feature->locations[feature->location_idx], feature->new_signature, max_correlation_point_new_template);
-			if(over_threshhold_new_template && distance(max_correlation_point, max_correlation_point_new_template) < settings.template_update_distance_threshhold) {
-				memcpy(feature->new_signature, feature->signature, 49 * sizeof(float));
-				new_location = max_correlation_point_new_template;
-				track_success = true;
-			} else {
-				track_success = false;
-			}
-		} else {
-			new_location = max_correlation_point;
-			track_success = over_threshhold;
-		}
-
-		if(track_success) {
-			++tracked_features[i].track_frames;
-
-			/* Remove old tracked point from map */
-			const uint x = tracked_features[i].locations[tracked_features[i].location_idx].x;
-			const uint y = tracked_features[i].locations[tracked_features[i].location_idx].y;
-			tracked_feature_map[idx_1d(x, y, image_width)] = false;
-
-			/* Add new tracked point to map */
-			tracked_feature_map[idx_1d(new_location.x, new_location.y, image_width)] = true;
-
-			/* Add the new location to the tracked feature's location history */
-			tracked_features[i].location_idx = (tracked_features[i].location_idx + 1) % MAX_TRACKED_POINT_LOCATIONS;
-			tracked_features[i].locations[tracked_features[i].location_idx] = new_location;
-
-			/* If we have tracked this point for enough frames to trigger template updating */
-			if(tracked_features[i].track_frames % settings.template_update_frames == 0 && (tracked_features[i].track_frames + 1) % (settings.template_update_frames * 2) != 0) {
-				/* Update the tracked feature's 7x7 template to that of its current location in the image */
-				for(char window_offset_y=-3, template_y=0; window_offset_y<=3; ++window_offset_y, ++template_y) {
-					for(char window_offset_x=-3, template_x=0; window_offset_x<=3; ++window_offset_x, ++template_x) {
-						int window_x = new_location.x + window_offset_x;
-						int window_y = new_location.y + window_offset_y;
-						window_x = window_x >= image_width ? image_width-1 : window_x < 0 ? 0 : window_x;
-						window_y = window_y >= image_height ? image_height-1 : window_y < 0 ? 0 : window_y;
-
-						feature->new_signature[(template_y * 7) + template_x] = normalized_input_image[idx_1d(window_x, window_y, image_width)];
-					}
-				}
-			}
-		} else {
-			/* Correlation value was not above threshhold feature has been lost, 
-			remove it from the vector and tracked feature map */
-			const uint x = tracked_features[i].locations[tracked_features[i].location_idx].x;
-			const uint y = tracked_features[i].locations[tracked_features[i].location_idx].y;
-			tracked_feature_map[idx_1d(x, y, image_width)] = false;
+	if(!tracked_features.empty() && integral_image) {
+		build_integral_images();
+	}
 
-			tracked_features.erase(tracked_features.begin() + i);
+	/* Search for every tracked feature in parallel, the searches only read the
+	current frame and the feature's own templates */
+	track_results.resize(tracked_features.size());
+	thread_pool.parallel_for(0, tracked_features.size(), track_tile_features, [this](uint begin, uint end) {
+		for(uint i=begin; i<end; ++i) {
+			track_feature(i, track_results[i]);
 		}
-	}
+	});
+
+	merge_track_results();
+	const uint num_kept = tracked_features.size();
 
 	/* Add harris points to the tracked features list if they
 	are far enough away from existing tracked features */
 	for(int i=harris_points.size()-1; i>=0; --i) {
-		const uint x = harris_points[i].locations[0].x;
-		const uint y = harris_points[i].locations[0].y;
+		const uint x = harris_points[i].location.x;
+		const uint y = harris_points[i].location.y;
 		for(char window_offset_y=-3; window_offset_y<=3; ++window_offset_y) {
 			for(char window_offset_x=-3; window_offset_x<=3; ++window_offset_x) {
 				int window_x = x + window_offset_x;
@@ -381,24 +418,32 @@ void FeatureTrackingCpu::update_tracked_features() {
 				}
 			}
 		}
-		tracked_features.push_back(harris_points[i]);
+		tracked_features.add(harris_points[i].location, harris_points[i].signature);
 		tracked_feature_map[idx_1d(x, y, image_width)] = true;
 		if(tracked_features.size() >= settings.max_tracked_features) {
 			break;
 		}
 NEXT_POINT:;
 	}
+
+	TRACKING_STATS_SET(added, tracked_features.size() - num_kept);
 }
 
-std::vector<HarrisPoint> FeatureTrackingCpu::feature_points(uchar *input) {
+const FeatureStore &FeatureTrackingCpu::feature_points(uchar *input) {
 	input_image = input;
+	TRACKING_STATS_BEGIN();
 
-	create_normalized_input_image();
+	/* Templates are normalized as they are cut, so no normalized image is made */
 	calc_gradients();
+	TRACKING_STATS_MARK(STAGE_GRADIENTS);
 	blur_gradients();
+	TRACKING_STATS_MARK(STAGE_BLUR);
 	calc_harris_response();
+	TRACKING_STATS_MARK(STAGE_RESPONSE);
 	get_maxima_points();
+	TRACKING_STATS_MARK(STAGE_MAXIMA);
 	update_tracked_features();
+	TRACKING_STATS_MARK(STAGE_TRACKING);
 
 	++image_count;
 
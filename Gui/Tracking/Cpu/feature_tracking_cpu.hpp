@@ -5,16 +5,46 @@
 #include <vector>
 
 #include "Utils/utils.hpp"
+#include "Utils/thread_pool.hpp"
 #include "Tracking/feature_tracking.hpp"
+#include "Tracking/feature_store.hpp"
+#include "Tracking/Cpu/sobel_simd.hpp"
+#include "Tracking/Cpu/tracking_kernels.hpp"
+
+/* Outcome of the correlation search for one tracked feature, produced in
+parallel and applied to the tracked feature list in a serial merge */
+struct TrackResult {
+	Point location;
+	bool success;
+	bool template_replaced;
+};
 
 class FeatureTrackingCpu : public FeatureTracking {
 public:
-	FeatureTrackingCpu(const TrackingSettings tracking_settings);
+	FeatureTrackingCpu(const TrackingSettings &tracking_settings);
 	~FeatureTrackingCpu();
-	std::vector<HarrisPoint> feature_points(uchar *input) override;
+	const FeatureStore &feature_points(uchar *input) override;
+
+protected:
+	/* Derived engines which produce their own corner candidates can skip
+	allocating the full frame gradient, blur and response images, and then
+	search without the summed area tables too */
+	FeatureTrackingCpu(const TrackingSettings &tracking_settings, bool allocate_intermediate_images);
+
+	/* Stages are split into bands of rows of roughly this many bytes of input and output */
+	const static uint tile_size_bytes = 128 * 1024;
+	/* Candidates ordered in the first selection batch per feature wanted */
+	const static uint candidate_batch_factor = 4;
+	/* Columns filtered side by side in the dense suppression column pass */
+	const static uint max_filter_strip_cols = 64;
+	/* Tracked features searched per thread pool task */
+	const static uint track_tile_features = 16;
 
-private:
 	const TrackingSettings &settings;
+	ThreadPool thread_pool;
+
+	/* Widest Sobel kernel the processor supports */
+	SobelRowFunction sobel_row;
 
 	uint gradient_cols;
 	uint gradient_rows;
@@ -24,33 +54,52 @@ private:
 	uint harris_response_rows;
 
 	uchar *input_image;
-	float *normalized_input_image;
+	bool *tracked_feature_map;
+
+	/* Summed area tables of the input and its square, (image_width+1) x
+	(image_height+1), nullptr when the intermediate images are skipped */
+	uint *integral_image;
+	unsigned long long *integral_image_sq;
+
+	std::vector<TempPointData> maxima_candidates;
+	std::vector<TempPointData> selected_candidates;
+	std::vector<std::vector<TempPointData>> tile_candidates;
+	std::vector<PointData> harris_points;
+	FeatureStore tracked_features;
+	std::vector<TrackResult> track_results;
+
+	int image_count = 0;
+
+	uint tile_rows(size_t row_bytes) const;
+	void merge_tile_candidates();
+	void select_maxima_points();
+	void update_tracked_features();
+
+private:
 	short *gradient_x2;
 	short *gradient_y2;
 	short *gradient_xy;
+	float *horizontal_blur_x2;
+	float *horizontal_blur_y2;
+	float *horizontal_blur_xy;
 	float *blur_gradient_x2;
 	float *blur_gradient_y2;
 	float *blur_gradient_xy;
 	float *harris_response;
-	bool *maxima_suppression;
-	bool *tracked_feature_map;
-
-	std::vector<HarrisPoint> harris_points;
-	std::vector<HarrisPoint> tracked_features;
+	float *horizontal_max_response;
+	float *max_response;
+	std::vector<bool> maxima_suppression;
 
-	int image_count = 0;
-
-	void __inline create_normalized_input_image();
 	void calc_gradients();
-	void blur_gradient(short *gradient_img, float *blur_gradient_img);
-	void __inline blur_gradients();
+	void blur_gradients();
 	void calc_harris_response();
 	void get_maxima_points();
-	void update_tracked_features();
+	void calc_max_response();
 
-	float __inline get_template_average(float *signature);
-	float __inline get_window_average(uint x, uint y);
+	void build_integral_images();
 	bool track_point(Point old_location, float *signature, Point &new_location);
+	void track_feature(uint idx, TrackResult &result);
+	void merge_track_results();
 };
 
 #endif /* FEATURE_TRACKING_CPU_HPP */
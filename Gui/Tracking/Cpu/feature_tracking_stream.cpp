@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cstdlib>
+
+#include "feature_tracking_stream.hpp"
+
+FeatureTrackingStream::FeatureTrackingStream(const TrackingSettings &tracking_settings) :
+	FeatureTrackingCpu(tracking_settings, false)
+{
+	/* One band of response rows per thread, each band re-reads a halo of
+	filter_width-1 gradient rows above it to prime its ring */
+	const uint num_bands = thread_pool.size();
+	band_rows = (harris_response_rows + num_bands - 1) / num_bands;
+
+	bands.resize(ThreadPool::tile_count(0, harris_response_rows, band_rows));
+	for(size_t i=0; i<bands.size(); ++i) {
+		RowBand &band = bands[i];
+		band.gradient_row_x2.resize(gradient_cols);
+		band.gradient_row_y2.resize(gradient_cols);
+		band.gradient_row_xy.resize(gradient_cols);
+		band.horizontal_blur_ring_x2.resize(blur_gradient_cols * filter_width);
+		band.horizontal_blur_ring_y2.resize(blur_gradient_cols * filter_width);
+		band.horizontal_blur_ring_xy.resize(blur_gradient_cols * filter_width);
+		band.blur_row_x2.resize(blur_gradient_cols);
+		band.blur_row_y2.resize(blur_gradient_cols);
+		band.blur_row_xy.resize(blur_gradient_cols);
+		band.response_row.resize(harris_response_cols);
+	}
+	tile_candidates.resize(bands.size());
+}
+
+FeatureTrackingStream::~FeatureTrackingStream() {
+	/* Empty */
+}
+
+/* Gradient row y is centred on input row y+1 */
+void FeatureTrackingStream::calc_gradient_row(RowBand &band, uint y) {
+	sobel_row(
+		&input_image[idx_1d(0, y+0, image_width)],
+		&input_image[idx_1d(0, y+1, image_width)],
+		&input_image[idx_1d(0, y+2, image_width)],
+		gradient_cols,
+		&band.gradient_row_x2[0],
+		&band.gradient_row_y2[0],
+		&band.gradient_row_xy[0]
+	);
+}
+
+void FeatureTrackingStream::horizontal_blur_ring_row(RowBand &band, uint ring_row) {
+	const uint idx = idx_1d(0, ring_row, blur_gradient_cols);
+	horizontal_blur_row(
+		&band.gradient_row_x2[0], &band.gradient_row_y2[0], &band.gradient_row_xy[0], blur_gradient_cols,
+		gaussian_kernel, filter_width,
+		&band.horizontal_blur_ring_x2[idx], &band.horizontal_blur_ring_y2[idx], &band.horizontal_blur_ring_xy[idx]
+	);
+}
+
+/* first_ring_row is the ring slot holding the oldest of the filter_width rows */
+void FeatureTrackingStream::vertical_blur_ring(RowBand &band, uint first_ring_row) {
+	const float *rows_x2[filter_width];
+	const float *rows_y2[filter_width];
+	const float *rows_xy[filter_width];
+	for(uint k=0; k<filter_width; ++k) {
+		const uint idx = idx_1d(0, (first_ring_row + k) % filter_width, blur_gradient_cols);
+		rows_x2[k] = &band.horizontal_blur_ring_x2[idx];
+		rows_y2[k] = &band.horizontal_blur_ring_y2[idx];
+		rows_xy[k] = &band.horizontal_blur_ring_xy[idx];
+	}
+
+	vertical_blur_row(
+		rows_x2, rows_y2, rows_xy, blur_gradient_cols,
+		gaussian_kernel, filter_width,
+		&band.blur_row_x2[0], &band.blur_row_y2[0], &band.blur_row_xy[0]
+	);
+}
+
+/* Stream response rows [begin, end), which need gradient rows [begin, end+filter_width-1) */
+void FeatureTrackingStream::stream_band(uint band_idx, uint begin, uint end) {
+	RowBand &band = bands[band_idx];
+	std::vector<TempPointData> &points = tile_candidates[band_idx];
+	points.clear();
+
+	const uint gradient_end = end + filter_width - 1;
+	for(uint y=begin; y<gradient_end; ++y) {
+		calc_gradient_row(band, y);
+		horizontal_blur_ring_row(band, (y - begin) % filter_width);
+
+		/* Once the ring holds filter_width rows a blurred row can be emitted */
+		if(y + 1 - begin >= filter_width) {
+			const uint blur_y = y + 1 - filter_width;
+			vertical_blur_ring(band, (blur_y - begin) % filter_width);
+			harris_response_row(&band.blur_row_x2[0], &band.blur_row_y2[0], &band.blur_row_xy[0], harris_response_cols, settings.sensitivity, &band.response_row[0]);
+			if(capture) {
+				std::copy(band.response_row.begin(), band.response_row.end(), capture->response.begin() + idx_1d(0, blur_y, harris_response_cols));
+			}
+			collect_candidates_row(&band.response_row[0], nullptr, harris_response_cols, blur_y, settings.harris_response_threshhold, points);
+		}
+	}
+}
+
+void FeatureTrackingStream::stream_harris_response() {
+	/* Bands write their response rows straight into the capture */
+	if(capture) {
+		capture->response_cols = harris_response_cols;
+		capture->response_rows = harris_response_rows;
+		capture->response.resize(harris_response_cols * harris_response_rows);
+	}
+
+	thread_pool.parallel_for(0, harris_response_rows, band_rows, [this](uint begin, uint end) {
+		stream_band(begin / band_rows, begin, end);
+	});
+
+	merge_tile_candidates();
+}
+
+const FeatureStore &FeatureTrackingStream::feature_points(uchar *input) {
+	input_image = input;
+	TRACKING_STATS_BEGIN();
+
+	/* Gradients and blur are fused into the response pass */
+	stream_harris_response();
+	TRACKING_STATS_MARK(STAGE_RESPONSE);
+	select_maxima_points();
+	TRACKING_STATS_MARK(STAGE_MAXIMA);
+	update_tracked_features();
+	TRACKING_STATS_MARK(STAGE_TRACKING);
+
+	++image_count;
+
+	return tracked_features;
+}
@@ -0,0 +1,57 @@
+#pragma once
+#ifndef FEATURE_TRACKING_STREAM_HPP
+#define FEATURE_TRACKING_STREAM_HPP
+
+#include <vector>
+
+#include "Utils/utils.hpp"
+#include "Tracking/Cpu/feature_tracking_cpu.hpp"
+
+/* Harris corner detection fused into a single pass over the input image.
+Only a ring of horizontally blurred gradient rows is kept between rows,
+so the detection working set stays in cache instead of streaming each
+full frame intermediate image through memory.
+
+Only the tracked feature map (1 byte per pixel) checked around each new
+corner and the suppression bits (1 bit per response pixel) set around each
+selected corner stay full frame. Templates are cut from the input image
+through the normalize table and the correlation search sums its windows
+from the 13x13 input pixels around each feature, so no normalized image or
+summed area table is written */
+class FeatureTrackingStream : public FeatureTrackingCpu {
+public:
+	FeatureTrackingStream(const TrackingSettings &tracking_settings);
+	~FeatureTrackingStream();
+	const FeatureStore &feature_points(uchar *input) override;
+
+private:
+	/* Line buffers for one band of response rows, bands run in parallel */
+	struct RowBand {
+		/* Single rows of Sobel gradient products */
+		std::vector<short> gradient_row_x2;
+		std::vector<short> gradient_row_y2;
+		std::vector<short> gradient_row_xy;
+
+		/* Ring of filter_width horizontally blurred gradient rows per channel */
+		std::vector<float> horizontal_blur_ring_x2;
+		std::vector<float> horizontal_blur_ring_y2;
+		std::vector<float> horizontal_blur_ring_xy;
+
+		/* Single rows of the vertically blurred gradients and their response */
+		std::vector<float> blur_row_x2;
+		std::vector<float> blur_row_y2;
+		std::vector<float> blur_row_xy;
+		std::vector<float> response_row;
+	};
+
+	uint band_rows;
+	std::vector<RowBand> bands;
+
+	void calc_gradient_row(RowBand &band, uint y);
+	void horizontal_blur_ring_row(RowBand &band, uint ring_row);
+	void vertical_blur_ring(RowBand &band, uint first_ring_row);
+	void stream_band(uint band_idx, uint begin, uint end);
+	void stream_harris_response();
+};
+
+#endif /* FEATURE_TRACKING_STREAM_HPP */
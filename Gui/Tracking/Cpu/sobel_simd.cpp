@@ -0,0 +1,151 @@
+#include <immintrin.h>
+
+#include "sobel_simd.hpp"
+
+/* Sobel taps as in FeatureTracking::sobel_x and FeatureTracking::sobel_y */
+static __forceinline void sobel_pixels_scalar(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint begin, uint end,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy)
+{
+	for(uint x=begin; x<end; ++x) {
+		const short gradient_x = (
+			(row_0[x+2] - row_0[x]) +
+			((row_1[x+2] - row_1[x]) * 2) +
+			(row_2[x+2] - row_2[x])
+		);
+
+		const short gradient_y = (
+			(row_2[x] + (row_2[x+1] * 2) + row_2[x+2]) -
+			(row_0[x] + (row_0[x+1] * 2) + row_0[x+2])
+		);
+
+		gradient_x2[x] = gradient_x * gradient_x;
+		gradient_y2[x] = gradient_y * gradient_y;
+		gradient_xy[x] = gradient_x * gradient_y;
+	}
+}
+
+void sobel_row_scalar(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy)
+{
+	sobel_pixels_scalar(row_0, row_1, row_2, 0, cols, gradient_x2, gradient_y2, gradient_xy);
+}
+
+/* Gradients fit in 16 bits (|g| <= 1020) and mullo keeps the low 16 bits
+of each product, which is the same truncation as storing an int in a short */
+
+SIMD_TARGET("sse4.1")
+void sobel_row_sse41(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy)
+{
+	uint x = 0;
+	for(; x+16<=cols; x+=16) {
+		for(uint half=0; half<2; ++half) {
+			const uint offset = x + (half * 8);
+
+			const __m128i l0 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_0[offset+0]));
+			const __m128i c0 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_0[offset+1]));
+			const __m128i r0 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_0[offset+2]));
+			const __m128i l1 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_1[offset+0]));
+			const __m128i r1 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_1[offset+2]));
+			const __m128i l2 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_2[offset+0]));
+			const __m128i c2 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_2[offset+1]));
+			const __m128i r2 = _mm_cvtepu8_epi16(_mm_loadl_epi64((const __m128i *)&row_2[offset+2]));
+
+			const __m128i gradient_x = _mm_add_epi16(
+				_mm_add_epi16(_mm_sub_epi16(r0, l0), _mm_sub_epi16(r2, l2)),
+				_mm_slli_epi16(_mm_sub_epi16(r1, l1), 1)
+			);
+
+			const __m128i gradient_y = _mm_sub_epi16(
+				_mm_add_epi16(_mm_add_epi16(l2, r2), _mm_slli_epi16(c2, 1)),
+				_mm_add_epi16(_mm_add_epi16(l0, r0), _mm_slli_epi16(c0, 1))
+			);
+
+			_mm_storeu_si128((__m128i *)&gradient_x2[offset], _mm_mullo_epi16(gradient_x, gradient_x));
+			_mm_storeu_si128((__m128i *)&gradient_y2[offset], _mm_mullo_epi16(gradient_y, gradient_y));
+			_mm_storeu_si128((__m128i *)&gradient_xy[offset], _mm_mullo_epi16(gradient_x, gradient_y));
+		}
+	}
+
+	sobel_pixels_scalar(row_0, row_1, row_2, x, cols, gradient_x2, gradient_y2, gradient_xy);
+}
+
+SIMD_TARGET("avx2")
+void sobel_row_avx2(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy)
+{
+	uint x = 0;
+	for(; x+16<=cols; x+=16) {
+		const __m256i l0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_0[x+0]));
+		const __m256i c0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_0[x+1]));
+		const __m256i r0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_0[x+2]));
+		const __m256i l1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_1[x+0]));
+		const __m256i r1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_1[x+2]));
+		const __m256i l2 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_2[x+0]));
+		const __m256i c2 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_2[x+1]));
+		const __m256i r2 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&row_2[x+2]));
+
+		const __m256i gradient_x = _mm256_add_epi16(
+			_mm256_add_epi16(_mm256_sub_epi16(r0, l0), _mm256_sub_epi16(r2, l2)),
+			_mm256_slli_epi16(_mm256_sub_epi16(r1, l1), 1)
+		);
+
+		const __m256i gradient_y = _mm256_sub_epi16(
+			_mm256_add_epi16(_mm256_add_epi16(l2, r2), _mm256_slli_epi16(c2, 1)),
+			_mm256_add_epi16(_mm256_add_epi16(l0, r0), _mm256_slli_epi16(c0, 1))
+		);
+
+		_mm256_storeu_si256((__m256i *)&gradient_x2[x], _mm256_mullo_epi16(gradient_x, gradient_x));
+		_mm256_storeu_si256((__m256i *)&gradient_y2[x], _mm256_mullo_epi16(gradient_y, gradient_y));
+		_mm256_storeu_si256((__m256i *)&gradient_xy[x], _mm256_mullo_epi16(gradient_x, gradient_y));
+	}
+
+	sobel_pixels_scalar(row_0, row_1, row_2, x, cols, gradient_x2, gradient_y2, gradient_xy);
+}
+
+SIMD_TARGET("avx512f,avx512bw")
+void sobel_row_avx512(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy)
+{
+	uint x = 0;
+	for(; x+32<=cols; x+=32) {
+		const __m512i l0 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_0[x+0]));
+		const __m512i c0 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_0[x+1]));
+		const __m512i r0 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_0[x+2]));
+		const __m512i l1 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_1[x+0]));
+		const __m512i r1 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_1[x+2]));
+		const __m512i l2 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_2[x+0]));
+		const __m512i c2 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_2[x+1]));
+		const __m512i r2 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&row_2[x+2]));
+
+		const __m512i gradient_x = _mm512_add_epi16(
+			_mm512_add_epi16(_mm512_sub_epi16(r0, l0), _mm512_sub_epi16(r2, l2)),
+			_mm512_slli_epi16(_mm512_sub_epi16(r1, l1), 1)
+		);
+
+		const __m512i gradient_y = _mm512_sub_epi16(
+			_mm512_add_epi16(_mm512_add_epi16(l2, r2), _mm512_slli_epi16(c2, 1)),
+			_mm512_add_epi16(_mm512_add_epi16(l0, r0), _mm512_slli_epi16(c0, 1))
+		);
+
+		_mm512_storeu_si512((void *)&gradient_x2[x], _mm512_mullo_epi16(gradient_x, gradient_x));
+		_mm512_storeu_si512((void *)&gradient_y2[x], _mm512_mullo_epi16(gradient_y, gradient_y));
+		_mm512_storeu_si512((void *)&gradient_xy[x], _mm512_mullo_epi16(gradient_x, gradient_y));
+	}
+
+	sobel_pixels_scalar(row_0, row_1, row_2, x, cols, gradient_x2, gradient_y2, gradient_xy);
+}
+
+SobelRowFunction sobel_row_function(SimdLevel level) {
+	switch(level) {
+		case SIMD_AVX512: return sobel_row_avx512;
+		case SIMD_AVX2: return sobel_row_avx2;
+		case SIMD_SSE41: return sobel_row_sse41;
+		default: return sobel_row_scalar;
+	}
+}
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef SOBEL_SIMD_HPP
+#define SOBEL_SIMD_HPP
+
+#include "Utils/types.hpp"
+#include "Utils/cpu_features.hpp"
+
+/* Computes one row of Sobel gradient products. Output column x is centred
+on column x+1 of row_1, so row_0, row_1 and row_2 must hold cols+2 pixels.
+Products are stored as shorts exactly as the scalar path truncates them */
+typedef void (*SobelRowFunction)(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy);
+
+/* Reference implementation, the vectorized versions match it bit for bit
+as KernelBenchmark --check verifies */
+void sobel_row_scalar(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy);
+
+/* 16 pixels per iteration */
+void sobel_row_sse41(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy);
+
+/* 16 pixels per iteration */
+void sobel_row_avx2(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy);
+
+/* 32 pixels per iteration, requires AVX-512BW */
+void sobel_row_avx512(
+	const uchar *row_0, const uchar *row_1, const uchar *row_2, uint cols,
+	short *gradient_x2, short *gradient_y2, short *gradient_xy);
+
+/* Widest implementation at or below level */
+SobelRowFunction sobel_row_function(SimdLevel level);
+
+#endif /* SOBEL_SIMD_HPP */
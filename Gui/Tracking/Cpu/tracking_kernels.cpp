@@ -0,0 +1,418 @@
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "tracking_kernels.hpp"
+
+/* Strongest response first, equal responses are taken in raster order so
+the order, and the points selected from it, is fully defined */
+struct sort_by_corner_response {
+	bool operator()(TempPointData const &left, TempPointData const &right) const {
+		if(left.corner_response != right.corner_response) {
+			return left.corner_response > right.corner_response;
+		}
+		if(left.location.y != right.location.y) {
+			return left.location.y < right.location.y;
+		}
+		return left.location.x < right.location.x;
+	}
+};
+
+void horizontal_blur_row(
+	const short *row_x2, const short *row_y2, const short *row_xy, uint cols,
+	const float *kernel, uint taps,
+	float *out_x2, float *out_y2, float *out_xy)
+{
+	for(uint x=0; x<cols; ++x) {
+		float total_x2 = 0.0f;
+		float total_y2 = 0.0f;
+		float total_xy = 0.0f;
+
+		for(uint k=0; k<taps; ++k) {
+			total_x2 += kernel[k] * row_x2[x+k];
+			total_y2 += kernel[k] * row_y2[x+k];
+			total_xy += kernel[k] * row_xy[x+k];
+		}
+
+		out_x2[x] = total_x2;
+		out_y2[x] = total_y2;
+		out_xy[x] = total_xy;
+	}
+}
+
+void vertical_blur_row(
+	const float *const *rows_x2, const float *const *rows_y2, const float *const *rows_xy, uint cols,
+	const float *kernel, uint taps,
+	float *out_x2, float *out_y2, float *out_xy)
+{
+	for(uint x=0; x<cols; ++x) {
+		out_x2[x] = 0.0f;
+		out_y2[x] = 0.0f;
+		out_xy[x] = 0.0f;
+	}
+
+	/* Accumulate one source row at a time so the inner loop walks contiguous memory */
+	for(uint k=0; k<taps; ++k) {
+		const float weight = kernel[k];
+		const float *row_x2 = rows_x2[k];
+		const float *row_y2 = rows_y2[k];
+		const float *row_xy = rows_xy[k];
+
+		for(uint x=0; x<cols; ++x) {
+			out_x2[x] += weight * row_x2[x];
+			out_y2[x] += weight * row_y2[x];
+			out_xy[x] += weight * row_xy[x];
+		}
+	}
+}
+
+void harris_response_row(
+	const float *blur_x2, const float *blur_y2, const float *blur_xy, uint cols,
+	float sensitivity, float *response)
+{
+	for(uint x=0; x<cols; ++x) {
+		const float gx2 = blur_x2[x];
+		const float gy2 = blur_y2[x];
+		const float gxy = blur_xy[x];
+
+		const float det = (gx2 * gy2) - (gxy * gxy);
+		const float trace = gx2 + gy2;
+
+		response[x] = det - (sensitivity * (trace * trace));
+	}
+}
+
+void collect_candidates_row(
+	const float *response, const float *max_response, uint cols, uint y,
+	float threshold, std::vector<TempPointData> &points)
+{
+	for(uint x=0; x<cols; ++x) {
+		if(response[x] > threshold && (!max_response || response[x] == max_response[x])) {
+			TempPointData d;
+			d.corner_response = response[x];
+			d.location.x = x;
+			d.location.y = y;
+			points.push_back(d);
+		}
+	}
+}
+
+/* van Herk/Gil-Werman running maximum, values past either end count as the
+lowest float. The line is split into blocks of the window width and a max is
+run forwards and backwards inside each block, so any window is covered by the
+backward max at its first value and the forward max at its last. That is
+three comparisons per value whatever the window size */
+void max_filter_line(
+	const float *input, float *output, uint count, uint stride, uint width, uint range,
+	float *forward, float *backward)
+{
+	const uint window = (range * 2) + 1;
+	const uint padded_count = count + (range * 2);
+	const float lowest = std::numeric_limits<float>::lowest();
+
+	for(uint i=0, block_i=0; i<padded_count; ++i, block_i = block_i == window-1 ? 0 : block_i+1) {
+		float *f = &forward[i * width];
+		float *b = &backward[i * width];
+		if(i < range || i >= count + range) {
+			const float *previous = f - width;
+			for(uint j=0; j<width; ++j) {
+				f[j] = block_i == 0 ? lowest : previous[j];
+				b[j] = lowest;
+			}
+			continue;
+		}
+
+		const float *value = &input[(i - range) * stride];
+		if(block_i == 0) {
+			for(uint j=0; j<width; ++j) {
+				f[j] = value[j];
+				b[j] = value[j];
+			}
+		} else {
+			const float *previous = f - width;
+			for(uint j=0; j<width; ++j) {
+				f[j] = std::max(previous[j], value[j]);
+				b[j] = value[j];
+			}
+		}
+	}
+
+	for(uint i=padded_count-1; i-->0;) {
+		if((i + 1) % window != 0) {
+			float *b = &backward[i * width];
+			const float *next = b + width;
+			for(uint j=0; j<width; ++j) {
+				b[j] = std::max(b[j], next[j]);
+			}
+		}
+	}
+
+	for(uint i=0; i<count; ++i) {
+		const float *b = &backward[i * width];
+		const float *f = &forward[(i + (range * 2)) * width];
+		float *out = &output[i * stride];
+		for(uint j=0; j<width; ++j) {
+			out[j] = std::max(b[j], f[j]);
+		}
+	}
+}
+
+uint select_maxima(
+	std::vector<TempPointData> &points, uint cols, uint rows, uint range,
+	uint max_points, uint batch_factor,
+	std::vector<bool> &suppression, std::vector<TempPointData> &selected)
+{
+	suppression.assign((size_t)cols * rows, true);
+	selected.clear();
+
+	/* Greedy suppression stops once max_points points are accepted, so only
+	a prefix of the candidates needs ordering. Each batch is the next
+	strongest candidates pulled to the front with nth_element and then sorted,
+	doubling in size until enough points survive suppression */
+	size_t sorted_end = 0;
+	size_t batch_size = (size_t)max_points * batch_factor;
+	uint suppressed = 0;
+
+	for(size_t i=0; selected.size()<max_points && i<points.size(); ++i) {
+		if(i == sorted_end) {
+			const size_t batch_end = std::min(points.size(), sorted_end + batch_size);
+			if(batch_end < points.size()) {
+				std::nth_element(points.begin() + sorted_end, points.begin() + batch_end, points.end(), sort_by_corner_response());
+			}
+			std::sort(points.begin() + sorted_end, points.begin() + batch_end, sort_by_corner_response());
+			sorted_end = batch_end;
+			batch_size *= 2;
+		}
+
+		if(suppression[idx_1d(points[i].location.x, points[i].location.y, cols)] == false) {
+			++suppressed;
+			continue;
+		}
+
+		const int signed_range = range;
+		for(int y=-signed_range; y<=signed_range; ++y) {
+			for(int x=-signed_range; x<=signed_range; ++x) {
+				int sx = points[i].location.x + x;
+				int sy = points[i].location.y + y;
+				sx = sx >= cols ? cols-1 : sx < 0 ? 0 : sx;
+				sy = sy >= rows ? rows-1 : sy < 0 ? 0 : sy;
+
+				suppression[idx_1d(sx, sy, cols)] = false;
+			}
+		}
+
+		selected.push_back(points[i]);
+	}
+
+	return suppressed;
+}
+
+void integral_row(const uchar *row, uint cols, uint *out, unsigned long long *out_sq) {
+	uint sum = 0;
+	unsigned long long sum_sq = 0;
+	out[0] = 0;
+	out_sq[0] = 0;
+	for(uint x=0; x<cols; ++x) {
+		sum += row[x];
+		sum_sq += row[x] * row[x];
+		out[x+1] = sum;
+		out_sq[x+1] = sum_sq;
+	}
+}
+
+void integral_accumulate_row(
+	const uint *above, const unsigned long long *above_sq, uint begin, uint end,
+	uint *out, unsigned long long *out_sq)
+{
+	for(uint x=begin; x<end; ++x) {
+		out[x] += above[x];
+		out_sq[x] += above_sq[x];
+	}
+}
+
+void cut_signature(const uchar *input, uint cols, uint rows, Point location, const float *table, float *signature) {
+	for(char window_offset_y=-3, template_y=0; window_offset_y<=3; ++window_offset_y, ++template_y) {
+		for(char window_offset_x=-3, template_x=0; window_offset_x<=3; ++window_offset_x, ++template_x) {
+			int window_x = location.x + window_offset_x;
+			int window_y = location.y + window_offset_y;
+			window_x = window_x >= cols ? cols-1 : window_x < 0 ? 0 : window_x;
+			window_y = window_y >= rows ? rows-1 : window_y < 0 ? 0 : window_y;
+			signature[(template_y * 7) + template_x] = table[input[idx_1d(window_x, window_y, cols)]];
+		}
+	}
+}
+
+/* Summed area tables of the 13x13 input pixels every search window of one
+feature reads, clamped to the image as the windows are, with a zero first
+row and column */
+struct LocalSums {
+	uint sum[14 * 14];
+	uint sum_sq[14 * 14];
+};
+
+static void local_sums(const TrackingFrame &frame, Point location, LocalSums &sums) {
+	for(uint x=0; x<14; ++x) {
+		sums.sum[x] = 0;
+		sums.sum_sq[x] = 0;
+	}
+
+	for(int y=0; y<13; ++y) {
+		int input_y = (int)location.y + y - 6;
+		input_y = input_y >= frame.rows ? frame.rows-1 : input_y < 0 ? 0 : input_y;
+		const uchar *row = &frame.input[idx_1d(0, input_y, frame.cols)];
+
+		const uint above = idx_1d(0, y, 14);
+		const uint idx = idx_1d(0, y+1, 14);
+		sums.sum[idx] = 0;
+		sums.sum_sq[idx] = 0;
+		uint row_sum = 0;
+		uint row_sum_sq = 0;
+		for(int x=0; x<13; ++x) {
+			int input_x = (int)location.x + x - 6;
+			input_x = input_x >= frame.cols ? frame.cols-1 : input_x < 0 ? 0 : input_x;
+			const uint value = row[input_x];
+			row_sum += value;
+			row_sum_sq += value * value;
+			sums.sum[idx + x + 1] = sums.sum[above + x + 1] + row_sum;
+			sums.sum_sq[idx + x + 1] = sums.sum_sq[above + x + 1] + row_sum_sq;
+		}
+	}
+}
+
+/* Sums of the window at offset (x, y) from the feature, offsets are within [-3, 3] */
+static __forceinline void local_window_sums(const LocalSums &sums, int x, int y, unsigned long long &sum, unsigned long long &sum_sq) {
+	const uint top_left = idx_1d(x+3, y+3, 14);
+	const uint top_right = idx_1d(x+10, y+3, 14);
+	const uint bottom_left = idx_1d(x+3, y+10, 14);
+	const uint bottom_right = idx_1d(x+10, y+10, 14);
+
+	sum = sums.sum[bottom_right] - sums.sum[top_right] - sums.sum[bottom_left] + sums.sum[top_left];
+	sum_sq = sums.sum_sq[bottom_right] - sums.sum_sq[top_right] - sums.sum_sq[bottom_left] + sums.sum_sq[top_left];
+}
+
+static __forceinline void window_sums(const TrackingFrame &frame, int x, int y, unsigned long long &sum, unsigned long long &sum_sq) {
+	if(x >= 3 && y >= 3 && x + 3 < (int)frame.cols && y + 3 < (int)frame.rows) {
+		/* Box sum of the 7x7 window from the four corners of the integral images */
+		const uint integral_cols = frame.cols + 1;
+		const uint top_left = idx_1d(x-3, y-3, integral_cols);
+		const uint top_right = idx_1d(x+4, y-3, integral_cols);
+		const uint bottom_left = idx_1d(x-3, y+4, integral_cols);
+		const uint bottom_right = idx_1d(x+4, y+4, integral_cols);
+
+		sum = (unsigned long long)frame.integral[bottom_right] - frame.integral[top_right] - frame.integral[bottom_left] + frame.integral[top_left];
+		sum_sq = frame.integral_sq[bottom_right] - frame.integral_sq[top_right] - frame.integral_sq[bottom_left] + frame.integral_sq[top_left];
+		return;
+	}
+
+	/* Windows overhanging the image repeat the edge pixels, sum them directly */
+	sum = 0;
+	sum_sq = 0;
+	for(char window_offset_y=-3; window_offset_y<=3; ++window_offset_y) {
+		for(char window_offset_x=-3; window_offset_x<=3; ++window_offset_x) {
+			int window_x = x + window_offset_x;
+			int window_y = y + window_offset_y;
+			window_x = window_x >= frame.cols ? frame.cols-1 : window_x < 0 ? 0 : window_x;
+			window_y = window_y >= frame.rows ? frame.rows-1 : window_y < 0 ? 0 : window_y;
+
+			const uint value = frame.input[idx_1d(window_x, window_y, frame.cols)];
+			sum += value;
+			sum_sq += value * value;
+		}
+	}
+}
+
+float track_template(const TrackingFrame &frame, Point location, const float *signature, Point &best_location) {
+	/* Centre the 7x7 template once, it is the same for every search position */
+	float template_average = 0.0f;
+	for(uchar i=0; i<49; ++i) {
+		template_average += signature[i];
+	}
+	template_average /= 49.0f;
+
+	float template_centred[49];
+	float iy2 = 0.0f;
+	for(uchar i=0; i<49; ++i) {
+		template_centred[i] = signature[i] - template_average;
+		iy2 += template_centred[i] * template_centred[i];
+	}
+
+	/* Track maximum correlation value and its location */
+	float max_correlation_value = std::numeric_limits<float>::min();
+	Point max_correlation_point;
+	max_correlation_point.x = 0;
+	max_correlation_point.y = 0;
+
+	/* A flat template correlates with nothing */
+	if(iy2 <= min_correlation_variance) {
+		best_location = max_correlation_point;
+		return max_correlation_value;
+	}
+
+	/* Without full frame tables the windows are summed from the pixels around the feature */
+	LocalSums local;
+	if(!frame.integral) {
+		local_sums(frame, location, local);
+	}
+
+	/* Evaluate correlation value of each pixel in an area around the current tracked feature */
+	for(char search_area_offset_y=-3; search_area_offset_y<=3; ++search_area_offset_y) {
+		for(char search_area_offset_x=-3; search_area_offset_x<=3; ++search_area_offset_x) {
+			/* Add offset to current tracked feature to get X and Y coordinates of point
+			in the search area currently being evaluated for correlation */
+			const int search_area_x = location.x + search_area_offset_x;
+			const int search_area_y = location.y + search_area_offset_y;
+
+			/* Return if this point in the window is outside the image */
+			if(search_area_x>=frame.cols || search_area_x<0 || search_area_y>=frame.rows || search_area_y<0) {
+				break;
+			}
+
+			/* Window variance from the integral images, 49 * sum_sq - sum^2 is exact
+			in integers and is scaled back to normalized intensities. A flat window
+			has no correlation with anything and is skipped */
+			unsigned long long sum, sum_sq;
+			if(frame.integral) {
+				window_sums(frame, search_area_x, search_area_y, sum, sum_sq);
+			} else {
+				local_window_sums(local, search_area_offset_x, search_area_offset_y, sum, sum_sq);
+			}
+			const float ix2 = (float)((49 * sum_sq) - (sum * sum)) / (49.0f * 255.0f * 255.0f);
+			if(ix2 <= min_correlation_variance) {
+				continue;
+			}
+
+			/* Numerator from the same input pixels as the variance, each centred
+			exactly in integers as 49 * pixel - sum, so both agree on which
+			windows are flat */
+			float ixy = 0.0f;
+			for(char window_offset_y=-3, template_y=0; window_offset_y<=3; ++window_offset_y, ++template_y) {
+				int window_y = search_area_y + window_offset_y;
+				window_y = window_y >= frame.rows ? frame.rows-1 : window_y < 0 ? 0 : window_y;
+				const uchar *row = &frame.input[idx_1d(0, window_y, frame.cols)];
+
+				for(char window_offset_x=-3, template_x=0; window_offset_x<=3; ++window_offset_x, ++template_x) {
+					int window_x = search_area_x + window_offset_x;
+					window_x = window_x >= frame.cols ? frame.cols-1 : window_x < 0 ? 0 : window_x;
+					ixy += (float)((49 * (int)row[window_x]) - (int)sum) * template_centred[(template_y * 7) + template_x];
+				}
+			}
+			ixy /= 49.0f * 255.0f;
+
+			/* Calculate correlation value for the current search area pixel,
+			rounding can take it just past 1 */
+			float correlation = ixy / sqrt(ix2 * iy2);
+			correlation = std::min(std::max(correlation, -1.0f), 1.0f);
+
+			/* If this correlation value is the new highest */
+			/* Update the current highest correlation value and location */
+			if(correlation > max_correlation_value) {
+				max_correlation_value = correlation;
+				max_correlation_point.x = search_area_x;
+				max_correlation_point.y = search_area_y;
+			}
+		}
+	}
+
+	best_location = max_correlation_point;
+	return max_correlation_value;
+}
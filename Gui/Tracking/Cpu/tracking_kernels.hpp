@@ -0,0 +1,95 @@
+#pragma once
+#ifndef TRACKING_KERNELS_HPP
+#define TRACKING_KERNELS_HPP
+
+#include <vector>
+
+#include "Utils/types.hpp"
+#include "Tracking/feature_tracking.hpp"
+
+/* The CPU engines' pipeline stages as functions over caller owned buffers of
+any size. The engines split each frame into tiles or bands of rows and call
+these on them, the kernel benchmark calls them on whole synthetic images.
+Gradient rows are computed by the SobelRowFunction variants in sobel_simd.hpp */
+
+struct TempPointData {
+	Point location;
+	float corner_response;
+};
+
+/* taps wide horizontal blur of one row of each gradient product, the input
+rows hold cols+taps-1 values */
+void horizontal_blur_row(
+	const short *row_x2, const short *row_y2, const short *row_xy, uint cols,
+	const float *kernel, uint taps,
+	float *out_x2, float *out_y2, float *out_xy);
+
+/* Vertical blur of taps horizontally blurred rows, rows_x2[k] is weighted by
+kernel[k]. Rows are passed by pointer so they can come from a ring */
+void vertical_blur_row(
+	const float *const *rows_x2, const float *const *rows_y2, const float *const *rows_xy, uint cols,
+	const float *kernel, uint taps,
+	float *out_x2, float *out_y2, float *out_xy);
+
+void harris_response_row(
+	const float *blur_x2, const float *blur_y2, const float *blur_xy, uint cols,
+	float sensitivity, float *response);
+
+/* Append the points of response row y over threshold. When max_response is
+given only points equal to the maximum of their window are kept */
+void collect_candidates_row(
+	const float *response, const float *max_response, uint cols, uint y,
+	float threshold, std::vector<TempPointData> &points);
+
+/* Running maximum over range values either side of each of count values
+spaced stride apart, width adjacent lines are filtered side by side.
+forward and backward need room for (count + 2 * range) * width floats */
+void max_filter_line(
+	const float *input, float *output, uint count, uint stride, uint width, uint range,
+	float *forward, float *backward);
+
+/* Greedy suppression of candidates from a cols x rows response image.
+Candidates are accepted strongest first until max_points are found, each
+suppressing the window range either side of it. Reorders points, fills
+selected and returns how many candidates were suppressed */
+uint select_maxima(
+	std::vector<TempPointData> &points, uint cols, uint rows, uint range,
+	uint max_points, uint batch_factor,
+	std::vector<bool> &suppression, std::vector<TempPointData> &selected);
+
+/* Summed area tables are (cols+1) x (rows+1) with a zero first row and
+column. integral_row writes the prefix sums of input row y into table row
+y+1, integral_accumulate_row then adds the row above to table row y+1 for
+columns [begin, end) */
+void integral_row(const uchar *row, uint cols, uint *out, unsigned long long *out_sq);
+void integral_accumulate_row(
+	const uint *above, const unsigned long long *above_sq, uint begin, uint end,
+	uint *out, unsigned long long *out_sq);
+
+/* Cut the 7x7 template around location from a cols x rows input image,
+repeating the edge pixels, and normalize it through table */
+void cut_signature(const uchar *input, uint cols, uint rows, Point location, const float *table, float *signature);
+
+/* A frame as the correlation search reads it. integral and integral_sq are
+summed area tables of the whole input, when they are nullptr each search sums
+its windows from the 13x13 input pixels around the feature instead */
+struct TrackingFrame {
+	const uchar *input;
+	const uint *integral;
+	const unsigned long long *integral_sq;
+	uint cols;
+	uint rows;
+};
+
+/* Variance in normalized intensities, summed over the 7x7 window, at or
+below which a template or window counts as flat. One grey level of
+difference in one pixel is about 1.5e-5 */
+const float min_correlation_variance = 1e-6f;
+
+/* Normalized cross correlation of a 7x7 template at each point of the 7x7
+area around location. Returns the highest correlation, within [-1, 1], and
+its point. Flat windows never match, if every window is flat or the template
+is flat the smallest positive float is returned */
+float track_template(const TrackingFrame &frame, Point location, const float *signature, Point &best_location);
+
+#endif /* TRACKING_KERNELS_HPP */
@@ -122,7 +122,7 @@ __global__ void _calc_gradients(
 __global__ void _blur_gradients(
 	short * __restrict gradient_image,
 	float * __restrict blur_gradient_image,
-	float *__restrict gaussian_matrix,
+	float *__restrict gaussian_kernel,
 	char filter_range,
 	uint gradient_cols,
 	uint blur_gradient_cols,
@@ -139,11 +139,15 @@ __global__ void _blur_gradients(
 		return;
 	}
 
+	/* Same full (filter_range * 2) + 1 square window and weights as the CPU
+	engines' separable blur, a horizontal pass over each row then a vertical one */
 	float total = 0.0f;
-	for(uint y=thread_2D_pos.y-filter_range, gauss_idx=0; y<thread_2D_pos.y+filter_range; ++y, ++gauss_idx) {
-		for(uint x=thread_2D_pos.x-filter_range; x<thread_2D_pos.x+filter_range; ++x, ++gauss_idx) {
-			total += gaussian_matrix[gauss_idx] * gradient_image[d_idx_1d(x+filter_range, y+filter_range, gradient_cols)];
+	for(uint y=0; y<=filter_range*2; ++y) {
+		float row = 0.0f;
+		for(uint x=0; x<=filter_range*2; ++x) {
+			row += gaussian_kernel[x] * gradient_image[d_idx_1d(thread_2D_pos.x+x, thread_2D_pos.y+y, gradient_cols)];
 		}
+		total += gaussian_kernel[y] * row;
 	}
 	blur_gradient_image[d_idx_1d(thread_2D_pos.x, thread_2D_pos.y, blur_gradient_cols)] = total;
 }
@@ -493,8 +497,8 @@ FeatureTrackingGpu::FeatureTrackingGpu(int cuda_device, const TrackingSettings &
 	checkCudaErrors(cudaMalloc(&d_sobel_y, 9 * sizeof(char)));
 	checkCudaErrors(cudaMemcpy(d_sobel_x, sobel_x, 9 * sizeof(char), cudaMemcpyHostToDevice));
 	checkCudaErrors(cudaMemcpy(d_sobel_y, sobel_y, 9 * sizeof(char), cudaMemcpyHostToDevice));
-	checkCudaErrors(cudaMalloc(&d_gaussian_matrix, filter_width * filter_width * sizeof(float)));
-	checkCudaErrors(cudaMemcpy(d_gaussian_matrix, gaussian_matrix, filter_width * filter_width * sizeof(float), cudaMemcpyHostToDevice));
+	checkCudaErrors(cudaMalloc(&d_gaussian_kernel, filter_width * sizeof(float)));
+	checkCudaErrors(cudaMemcpy(d_gaussian_kernel, gaussian_kernel, filter_width * sizeof(float), cudaMemcpyHostToDevice));
 	checkCudaErrors(cudaMalloc(&d_uchar_normalize_table, 256 * sizeof(float)));
 	checkCudaErrors(cudaMemcpy(d_uchar_normalize_table, uchar_normalize_table, 256 * sizeof(float), cudaMemcpyHostToDevice));
 	checkCudaErrors(cudaMalloc(&d_gradient_x2, gradient_cols * gradient_rows * sizeof(short)));
@@ -520,7 +524,7 @@ FeatureTrackingGpu::~FeatureTrackingGpu() {
 	checkCudaErrors(cudaFree(d_tracked_feature_map));
 	checkCudaErrors(cudaFree(d_sobel_x));
 	checkCudaErrors(cudaFree(d_sobel_y));
-	checkCudaErrors(cudaFree(d_gaussian_matrix));
+	checkCudaErrors(cudaFree(d_gaussian_kernel));
 	checkCudaErrors(cudaFree(d_uchar_normalize_table));
 	checkCudaErrors(cudaFree(d_gradient_x2));
 	checkCudaErrors(cudaFree(d_gradient_y2));
@@ -567,7 +571,7 @@ void FeatureTrackingGpu::blur_gradients() {
 	_blur_gradients<<<blur_gradient_grid_size, block_size>>>(
 		d_gradient_x2,
 		d_blur_gradient_x2,
-		d_gaussian_matrix,
+		d_gaussian_kernel,
 		filter_range,
 		gradient_cols,
 		blur_gradient_cols,
@@ -577,7 +581,7 @@ void FeatureTrackingGpu::blur_gradients() {
 	_blur_gradients<<<blur_gradient_grid_size, block_size>>>(
 		d_gradient_y2,
 		d_blur_gradient_y2,
-		d_gaussian_matrix,
+		d_gaussian_kernel,
 		filter_range,
 		gradient_cols,
 		blur_gradient_cols,
@@ -587,7 +591,7 @@ void FeatureTrackingGpu::blur_gradients() {
 	_blur_gradients<<<blur_gradient_grid_size, block_size>>>(
 		d_gradient_xy,
 		d_blur_gradient_xy,
-		d_gaussian_matrix,
+		d_gaussian_kernel,
 		filter_range,
 		gradient_cols,
 		blur_gradient_cols,
@@ -605,6 +609,13 @@ void FeatureTrackingGpu::calc_harris_response() {
 		blur_gradient_cols,
 		blur_gradient_rows
 	);
+
+	if(capture) {
+		capture->response_cols = harris_response_cols;
+		capture->response_rows = harris_response_rows;
+		capture->response.resize(harris_response_cols * harris_response_rows);
+		checkCudaErrors(cudaMemcpy(&capture->response[0], d_harris_response, capture->response.size() * sizeof(float), cudaMemcpyDeviceToHost));
+	}
 }
 
 void FeatureTrackingGpu::get_maxima_points() {
@@ -651,6 +662,7 @@ void FeatureTrackingGpu::get_maxima_points() {
 	checkCudaErrors(cudaFree(d_points));
 
 	std::sort(&h_points[0], &h_points[num_points-1], sort_by_corner_response());
+	TRACKING_STATS_SET(candidates, num_points);
 
 	harris_points.clear();
 #pragma loop(hint_parallel(MAX_AP_THREADS))
@@ -663,12 +675,20 @@ void FeatureTrackingGpu::get_maxima_points() {
 		harris_points.push_back(harris_point);
 	}
 
+	if(capture) {
+		capture->harris_points.clear();
+		for(size_t i=0; i<harris_points.size(); ++i) {
+			capture->harris_points.push_back(harris_points[i].locations[0]);
+		}
+	}
+
 	free(h_points);
 }
 
 void FeatureTrackingGpu::update_tracked_features() {
 	if(image_count == 0) {
 		tracked_features = harris_points;
+		TRACKING_STATS_SET(added, (uint)harris_points.size());
 		return;
 	}
 
@@ -718,6 +738,9 @@ void FeatureTrackingGpu::update_tracked_features() {
 			tracked_features.push_back(h_tracked_features[i]);
 		}
 	}
+	const uint num_kept = tracked_features.size();
+	TRACKING_STATS_SET(tracked, num_kept);
+	TRACKING_STATS_SET(lost, (uint)num_tracked - num_kept);
 
 	const uint num_harris_points = harris_points.size();
 #pragma loop(hint_parallel(MAX_AP_THREADS))
@@ -743,27 +766,43 @@ void FeatureTrackingGpu::update_tracked_features() {
 		}
 NEXT_POINT:;
 	}
+
+	TRACKING_STATS_SET(added, (uint)tracked_features.size() - num_kept);
 }
 
-std::vector<HarrisPoint> FeatureTrackingGpu::feature_points(uchar *input) {
+const FeatureStore &FeatureTrackingGpu::feature_points(uchar *input) {
 	h_input_image = input;
+	TRACKING_STATS_BEGIN();
 
+	/* The upload and normalization are timed with the gradients, the
+	kernels are launched together and only synchronized after both */
 	checkCudaErrors(cudaMemcpy(d_input_image, h_input_image, input_image_size, cudaMemcpyHostToDevice));
 
 	create_normalised_input_image();
 	calc_gradients();
 	checkCudaErrors(cudaDeviceSynchronize());
+	TRACKING_STATS_MARK(STAGE_GRADIENTS);
 
 	blur_gradients();
 	checkCudaErrors(cudaDeviceSynchronize());
+	TRACKING_STATS_MARK(STAGE_BLUR);
 
 	calc_harris_response();
 	checkCudaErrors(cudaDeviceSynchronize());
+	TRACKING_STATS_MARK(STAGE_RESPONSE);
 
 	get_maxima_points();
+	TRACKING_STATS_MARK(STAGE_MAXIMA);
 	update_tracked_features();
 
+	TRACKING_STATS_MARK(STAGE_TRACKING);
+
 	++image_count;
-	
-	return tracked_features;
+
+	/* Packing the result into the store is not part of tracking, so it is left untimed */
+	tracked_feature_store.clear();
+	for(size_t i=0; i<tracked_features.size(); ++i) {
+		tracked_feature_store.add(tracked_features[i]);
+	}
+	return tracked_feature_store;
 }
@@ -8,6 +8,7 @@
 
 #include "utils/utils.hpp"
 #include "Tracking/feature_tracking.hpp"
+#include "Tracking/feature_store.hpp"
 
 __device__ struct d_Point {
 	uint x, y;
@@ -31,7 +32,7 @@ class FeatureTrackingGpu : public FeatureTracking {
 public:
 	FeatureTrackingGpu(int device, const TrackingSettings &tracking_settings);
 	~FeatureTrackingGpu();
-	std::vector<HarrisPoint> feature_points(uchar *input) override;
+	const FeatureStore &feature_points(uchar *input) override;
 
 private:
 	const TrackingSettings &settings;
@@ -59,7 +60,7 @@ private:
 
 	char *d_sobel_x;
 	char *d_sobel_y;
-	float *d_gaussian_matrix;
+	float *d_gaussian_kernel;
 	float *d_uchar_normalize_table;
 	uchar *d_input_image;
 	float *d_normalized_input_image;
@@ -79,6 +80,8 @@ private:
 
 	std::vector<HarrisPoint> harris_points;
 	std::vector<HarrisPoint> tracked_features;
+	/* Host copy of tracked_features handed out by feature_points */
+	FeatureStore tracked_feature_store;
 
 	uint image_count = 0;
 
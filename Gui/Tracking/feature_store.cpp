@@ -0,0 +1,109 @@
+#include "feature_store.hpp"
+
+#include <cstring>
+
+FeatureStore::FeatureStore() {
+	/* Empty */
+}
+
+void FeatureStore::reserve(uint capacity) {
+	locations.reserve(capacity);
+	signatures.reserve(capacity * 49);
+	new_signatures.reserve(capacity * 49);
+	frame_counts.reserve(capacity);
+	history_heads.reserve(capacity);
+	histories.reserve(capacity * MAX_TRACKED_POINT_LOCATIONS);
+}
+
+void FeatureStore::clear() {
+	locations.clear();
+	signatures.clear();
+	new_signatures.clear();
+	frame_counts.clear();
+	history_heads.clear();
+	histories.clear();
+}
+
+uint FeatureStore::add(Point location, const float *signature) {
+	const uint idx = locations.size();
+
+	locations.push_back(location);
+	signatures.insert(signatures.end(), signature, signature + 49);
+	new_signatures.resize(new_signatures.size() + 49);
+	frame_counts.push_back(0);
+	history_heads.push_back(0);
+	histories.resize(histories.size() + MAX_TRACKED_POINT_LOCATIONS);
+	histories[idx * MAX_TRACKED_POINT_LOCATIONS] = location;
+
+	return idx;
+}
+
+uint FeatureStore::add(const HarrisPoint &harris_point) {
+	const uint idx = add(harris_point.locations[harris_point.location_idx], harris_point.signature);
+
+	memcpy(&new_signatures[idx * 49], harris_point.new_signature, 49 * sizeof(float));
+	frame_counts[idx] = harris_point.track_frames;
+	history_heads[idx] = harris_point.location_idx;
+	memcpy(&histories[idx * MAX_TRACKED_POINT_LOCATIONS], harris_point.locations, MAX_TRACKED_POINT_LOCATIONS * sizeof(Point));
+
+	return idx;
+}
+
+void FeatureStore::remove(uint idx) {
+	const uint last = locations.size() - 1;
+	if(idx != last) {
+		locations[idx] = locations[last];
+		memcpy(&signatures[idx * 49], &signatures[last * 49], 49 * sizeof(float));
+		memcpy(&new_signatures[idx * 49], &new_signatures[last * 49], 49 * sizeof(float));
+		frame_counts[idx] = frame_counts[last];
+		history_heads[idx] = history_heads[last];
+		memcpy(&histories[idx * MAX_TRACKED_POINT_LOCATIONS], &histories[last * MAX_TRACKED_POINT_LOCATIONS], MAX_TRACKED_POINT_LOCATIONS * sizeof(Point));
+	}
+
+	locations.pop_back();
+	signatures.resize(last * 49);
+	new_signatures.resize(last * 49);
+	frame_counts.pop_back();
+	history_heads.pop_back();
+	histories.resize(last * MAX_TRACKED_POINT_LOCATIONS);
+}
+
+void FeatureStore::move(uint idx, Point location) {
+	locations[idx] = location;
+	history_heads[idx] = (history_heads[idx] + 1) % MAX_TRACKED_POINT_LOCATIONS;
+	histories[(idx * MAX_TRACKED_POINT_LOCATIONS) + history_heads[idx]] = location;
+}
+
+void FeatureStore::to_harris_point(uint idx, HarrisPoint &harris_point) const {
+	memcpy(harris_point.locations, history(idx), MAX_TRACKED_POINT_LOCATIONS * sizeof(Point));
+	harris_point.location_idx = history_heads[idx];
+	memcpy(harris_point.signature, &signatures[idx * 49], 49 * sizeof(float));
+	memcpy(harris_point.new_signature, &new_signatures[idx * 49], 49 * sizeof(float));
+	harris_point.track_frames = frame_counts[idx];
+	harris_point.tracked = true;
+}
+
+std::vector<HarrisPoint> FeatureStore::to_harris_points() const {
+	std::vector<HarrisPoint> harris_points(size());
+	for(uint i=0; i<size(); ++i) {
+		to_harris_point(i, harris_points[i]);
+	}
+	return harris_points;
+}
+
+void mark_feature_points(
+	uchar *image,
+	const FeatureStore &points,
+	uint cols, uint rows,
+	uchar radius, Colour colour)
+{
+	for(uint j=0; j<points.size(); ++j) {
+		const Point *locations = points.history(j);
+		if(points.track_frames(j) > 1) {
+			const uint min = points.track_frames(j) < MAX_TRACKED_POINT_LOCATIONS ? points.track_frames(j) : MAX_TRACKED_POINT_LOCATIONS;
+			for(uint k=0; k<min; ++k) {
+				mark_point(image, cols, rows, locations[k].x, locations[k].y, radius, colour);
+			}
+		}
+	}
+}
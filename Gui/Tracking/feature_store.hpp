@@ -0,0 +1,71 @@
+#pragma once
+#ifndef FEATURE_STORE_HPP
+#define FEATURE_STORE_HPP
+
+#include <vector>
+
+#include "Utils/utils.hpp"
+#include "Utils/types.hpp"
+#include "Tracking/feature_tracking.hpp"
+
+/* Tracked features stored as one contiguous array per field. The tracking
+search only reads the current location, the two 7x7 templates and the frame
+count, so the location history is kept in its own ring of
+MAX_TRACKED_POINT_LOCATIONS points per feature and is only touched when a
+feature moves. Features are removed by moving the last feature into the
+hole, so the order of features is not preserved across removals, and as
+the CPU engines merge results in store order neither is the exact set of
+features they go on to track */
+class FeatureStore {
+public:
+	FeatureStore();
+
+	void reserve(uint capacity);
+	void clear();
+	uint size() const { return locations.size(); }
+	bool empty() const { return locations.empty(); }
+
+	/* Append a newly detected feature, returns its index */
+	uint add(Point location, const float *signature);
+	/* Append a feature along with its history and templates */
+	uint add(const HarrisPoint &harris_point);
+
+	/* Remove a feature in O(1) by moving the last feature into its slot */
+	void remove(uint idx);
+
+	/* Record the feature's new location in its current location and history */
+	void move(uint idx, Point location);
+
+	Point location(uint idx) const { return locations[idx]; }
+	float *signature(uint idx) { return &signatures[idx * 49]; }
+	float *new_signature(uint idx) { return &new_signatures[idx * 49]; }
+	uint &track_frames(uint idx) { return frame_counts[idx]; }
+	uint track_frames(uint idx) const { return frame_counts[idx]; }
+
+	/* Location history ring of a feature, location_idx is its newest entry */
+	const Point *history(uint idx) const { return &histories[idx * MAX_TRACKED_POINT_LOCATIONS]; }
+	uint location_idx(uint idx) const { return history_heads[idx]; }
+
+	/* Expand features back into the array of structures layout, this copies
+	about 2 KB per feature so is only for callers which keep the features */
+	void to_harris_point(uint idx, HarrisPoint &harris_point) const;
+	std::vector<HarrisPoint> to_harris_points() const;
+
+private:
+	std::vector<Point> locations;
+	std::vector<float> signatures;
+	std::vector<float> new_signatures;
+	std::vector<uint> frame_counts;
+	std::vector<uint> history_heads;
+	std::vector<Point> histories;
+};
+
+/* Draw the location history of every feature tracked for more than one
+frame into an RGB image */
+void mark_feature_points(
+	uchar *image,
+	const FeatureStore &points,
+	uint cols, uint rows,
+	uchar radius, Colour colour);
+
+#endif /* FEATURE_STORE_HPP */
@@ -52,3 +52,8 @@ const float FeatureTracking::gaussian_matrix[] {
 	0.000031f, 0.000962f, 0.007334f, 0.014357f, 0.007334f, 0.000962f, 0.000031f,
 	0.000001f, 0.000031f, 0.000238f, 0.000465f, 0.000238f, 0.000031f, 0.000001f
 };
+
+/* 1D factor of gaussian_matrix, gaussian_matrix[(y * 7) + x] == gaussian_kernel[y] * gaussian_kernel[x] */
+const float FeatureTracking::gaussian_kernel[] {
+	0.001000f, 0.031016f, 0.236504f, 0.462960f, 0.236504f, 0.031016f, 0.001000f
+};
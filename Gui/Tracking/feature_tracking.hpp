@@ -2,6 +2,8 @@
 #ifndef FEATURE_TRACKING_HPP
 #define FEATURE_TRACKING_HPP
 
+#include <chrono>
+#include <cmath>
 #include <vector>
 
 #include "Utils/utils.hpp"
@@ -9,6 +11,14 @@
 
 #define MAX_TRACKED_POINT_LOCATIONS 200
 
+/* Per-stage timing and feature counts in TrackingStats, define as 0 to
+compile the collection out of every engine */
+#ifndef TRACKING_STATS
+#define TRACKING_STATS 1
+#endif
+
+class FeatureStore;
+
 struct Point {
 	uint x, y;
 	Point() {
@@ -35,6 +45,17 @@ struct HarrisPoint {
 	bool tracked = true;
 };
 
+/* How corner candidates are thinned before the strongest are selected.
+GREEDY accepts candidates strongest first and suppresses the window around
+each accepted point. DENSE first keeps only pixels equal to the maximum of
+their window, found with a separable running max filter, and then applies
+the greedy pass to the much smaller candidate list. The streaming engine
+always uses GREEDY */
+enum SuppressionMode {
+	SUPPRESSION_GREEDY,
+	SUPPRESSION_DENSE
+};
+
 struct TrackingSettings {
 	uint max_frames;
 	float sensitivity;
@@ -43,25 +64,115 @@ struct TrackingSettings {
 	float correlation_threshhold;
 	uint template_update_frames;
 	float template_update_distance_threshhold;
+	uint num_threads;
+	SuppressionMode suppression_mode;
+	uint suppression_range;
 };
 
-static void mark_feature_points(
-	uchar *image,
-	std::vector<HarrisPoint> points,
-	uint cols, uint rows,
-	uchar radius, Colour colour)
-{
-	for(size_t j=0; j<points.size(); ++j) {
-		Point *locations = points[j].locations;
-		if(points[j].track_frames > 1) {
-			const uint min = points[j].track_frames < MAX_TRACKED_POINT_LOCATIONS ? points[j].track_frames : MAX_TRACKED_POINT_LOCATIONS;
-			for(uint k=0; k<min; ++k) {
-				mark_point(image, cols, rows, locations[k].x, locations[k].y, 1, colour);
-			}
-		}
+/* The CPU engines normalize only the templates they cut, and the GPU
+engine's normalize kernel is timed with its gradients, so normalization
+has no stage of its own */
+enum TrackingStage {
+	STAGE_GRADIENTS,
+	STAGE_BLUR,
+	STAGE_RESPONSE,
+	STAGE_MAXIMA,
+	STAGE_TRACKING,
+	NUM_TRACKING_STAGES
+};
+
+inline const char *tracking_stage_name(TrackingStage stage) {
+	switch(stage) {
+		case STAGE_GRADIENTS: return "gradients";
+		case STAGE_BLUR: return "blur";
+		case STAGE_RESPONSE: return "response";
+		case STAGE_MAXIMA: return "maxima";
+		default: return "tracking";
 	}
 }
 
+/* What happened in the last frame an engine processed. Engines which fuse
+stages report the fused work under the last stage it covers and leave the
+others at 0, the streaming engine reports detection as STAGE_RESPONSE */
+struct TrackingStats {
+	/* Frames processed, including the one described */
+	ulong frames;
+	double stage_ms[NUM_TRACKING_STAGES];
+	/* Points over the response threshold entering selection, in dense mode
+	only the maximum of each window */
+	uint candidates;
+	/* Candidates rejected for lying in the window of a stronger point, the
+	selection stops once enough points are accepted so the rest are neither */
+	uint suppressed;
+	/* Features found again, features lost and new features added */
+	uint tracked;
+	uint lost;
+	uint added;
+
+	TrackingStats() {
+		clear();
+	}
+
+	void clear() {
+		frames = 0;
+		for(uint i=0; i<NUM_TRACKING_STAGES; ++i) {
+			stage_ms[i] = 0;
+		}
+		candidates = 0;
+		suppressed = 0;
+		tracked = 0;
+		lost = 0;
+		added = 0;
+	}
+};
+
+/* Intermediate results of one frame, copied out of an engine so engines can
+be compared with each other. The response map holds response_cols x
+response_rows values, one per pixel with a full blur window around it, and
+the corners are those selected from it in image coordinates, before
+tracking decides which of them become new features */
+struct TrackingCapture {
+	uint response_cols;
+	uint response_rows;
+	std::vector<float> response;
+	std::vector<Point> harris_points;
+
+	TrackingCapture() : response_cols(0), response_rows(0) {
+		/* Empty */
+	}
+};
+
+#if TRACKING_STATS
+/* Starts a frame's stats and times its stages, each mark ends the stage in
+progress. Two clock reads per stage so it stays on in release builds */
+class StageTimer {
+public:
+	StageTimer(TrackingStats &stats) : stats(stats), last(std::chrono::steady_clock::now()) {
+		const ulong frames = stats.frames;
+		stats.clear();
+		stats.frames = frames + 1;
+	}
+
+	void mark(TrackingStage stage) {
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		stats.stage_ms[stage] += std::chrono::duration<double, std::milli>(now - last).count();
+		last = now;
+	}
+
+private:
+	TrackingStats &stats;
+	std::chrono::steady_clock::time_point last;
+};
+
+#define TRACKING_STATS_BEGIN() StageTimer stage_timer(stats)
+#define TRACKING_STATS_MARK(stage) stage_timer.mark(stage)
+#define TRACKING_STATS_SET(field, value) (stats.field = (value))
+#else
+#define TRACKING_STATS_BEGIN()
+#define TRACKING_STATS_MARK(stage)
+#define TRACKING_STATS_SET(field, value) ((void)(value))
+#endif
+
 static __inline float distance(Point p1, Point p2) {
 	const float diff_x = (long)p1.x - (long)p2.x;
 	const float diff_y = (long)p1.y - (long)p2.y;
@@ -69,19 +180,37 @@ static __inline float distance(Point p1, Point p2) {
 }
 
 class FeatureTracking {
-protected:
+public:
+	/* Frame size, filters and tables every engine is built with, public so
+	the benchmarks can run the kernels the way the engines do */
 	const static uint image_width = 1024;
 	const static uint image_height = 768;
 	const static float uchar_normalize_table[256];
 	const static char sobel_x[9];
 	const static char sobel_y[9];
 	const static float gaussian_matrix[49];
+	const static float gaussian_kernel[7];
 	const static char filter_width = 7;
 	const static char filter_range = 3;
 	const static char maxima_suppression_width = 7;
 	const static char maxima_suppression_range = 3;
+
+protected:
+	TrackingStats stats;
+	TrackingCapture *capture = nullptr;
+
 public:
-	virtual std::vector<HarrisPoint> feature_points(uchar *input) = 0;
+	/* Track features into the next frame. The returned store belongs to the
+	engine and is only valid until the next call, callers which need to keep
+	the features must copy them */
+	virtual const FeatureStore &feature_points(uchar *input) = 0;
+	/* Stats of the last frame, call from the thread calling feature_points.
+	All zero when built with TRACKING_STATS 0 */
+	const TrackingStats &tracking_stats() const { return stats; }
+	/* Fill capture with every following frame's intermediate results, nullptr
+	stops. Copying the response map costs a frame sized write per frame, so
+	this is for the equivalence harness and not for the Gui */
+	void set_capture(TrackingCapture *capture) { this->capture = capture; }
 	virtual ~FeatureTracking() {}
 };
 
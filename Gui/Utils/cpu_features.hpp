@@ -0,0 +1,87 @@
+#pragma once
+#ifndef CPU_FEATURES_HPP
+#define CPU_FEATURES_HPP
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+#include "Utils/types.hpp"
+
+/* MSVC compiles intrinsics for any instruction set, GCC and Clang need
+functions using wider instruction sets than the build target tagged */
+#if defined(_MSC_VER)
+#define SIMD_TARGET(isa)
+#else
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+enum SimdLevel {
+	SIMD_SCALAR = 0,
+	SIMD_SSE41,
+	SIMD_AVX2,
+	SIMD_AVX512
+};
+
+inline const char *simd_level_name(SimdLevel level) {
+	switch(level) {
+		case SIMD_SSE41: return "SSE4.1";
+		case SIMD_AVX2: return "AVX2";
+		case SIMD_AVX512: return "AVX-512";
+		default: return "Scalar";
+	}
+}
+
+/* Widest instruction set supported by both the processor and the OS */
+inline SimdLevel detect_simd_level() {
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid(info, 0);
+	const int max_leaf = info[0];
+
+	__cpuid(info, 1);
+	const bool sse41 = (info[2] & (1 << 19)) != 0;
+	const bool osxsave = (info[2] & (1 << 27)) != 0;
+	const bool avx = (info[2] & (1 << 28)) != 0;
+
+	if(!sse41) {
+		return SIMD_SCALAR;
+	}
+	if(!osxsave || !avx || max_leaf < 7) {
+		return SIMD_SSE41;
+	}
+
+	/* The OS has to save the YMM and ZMM registers on context switch */
+	const unsigned long long xcr0 = _xgetbv(0);
+	const bool ymm_enabled = (xcr0 & 0x06) == 0x06;
+	const bool zmm_enabled = (xcr0 & 0xe6) == 0xe6;
+
+	__cpuidex(info, 7, 0);
+	const bool avx2 = (info[1] & (1 << 5)) != 0;
+	const bool avx512f = (info[1] & (1 << 16)) != 0;
+	const bool avx512bw = (info[1] & (1 << 30)) != 0;
+
+	if(zmm_enabled && avx512f && avx512bw) {
+		return SIMD_AVX512;
+	}
+	if(ymm_enabled && avx2) {
+		return SIMD_AVX2;
+	}
+	return SIMD_SSE41;
+#else
+	__builtin_cpu_init();
+	if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")) {
+		return SIMD_AVX512;
+	}
+	if(__builtin_cpu_supports("avx2")) {
+		return SIMD_AVX2;
+	}
+	if(__builtin_cpu_supports("sse4.1")) {
+		return SIMD_SSE41;
+	}
+	return SIMD_SCALAR;
+#endif
+}
+
+#endif /* CPU_FEATURES_HPP */
@@ -0,0 +1,150 @@
+#include <algorithm>
+
+#include "thread_pool.hpp"
+
+ThreadPool::ThreadPool(uint num_threads) :
+	queued_tasks(0)
+{
+	if(num_threads == 0) {
+		num_threads = std::max(std::thread::hardware_concurrency(), 1u);
+	}
+	this->num_threads = num_threads;
+
+	/* The calling thread makes up the last thread of the pool */
+	const uint num_workers = num_threads - 1;
+	queues = std::vector<WorkQueue>(std::max(num_workers, 1u));
+	for(uint i=0; i<num_workers; ++i) {
+		workers.push_back(std::thread(&ThreadPool::worker_loop, this, i));
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(wake_lock);
+		exit = true;
+	}
+	wake.notify_all();
+
+	for(size_t i=0; i<workers.size(); ++i) {
+		workers[i].join();
+	}
+}
+
+uint ThreadPool::size() const {
+	return num_threads;
+}
+
+uint ThreadPool::tile_count(uint begin, uint end, uint tile_size) {
+	if(end <= begin) {
+		return 0;
+	}
+	tile_size = std::max(tile_size, 1u);
+	return ((end - begin) + tile_size - 1) / tile_size;
+}
+
+void ThreadPool::parallel_for(uint begin, uint end, uint tile_size, const TileFunction &fn) {
+	tile_size = std::max(tile_size, 1u);
+	const uint num_tiles = tile_count(begin, end, tile_size);
+
+	if(num_tiles == 0) {
+		return;
+	}
+
+	/* Nothing to share the work with */
+	if(workers.empty() || num_tiles == 1) {
+		for(uint tile_begin=begin; tile_begin<end; tile_begin+=tile_size) {
+			fn(tile_begin, std::min(tile_begin + tile_size, end));
+		}
+		return;
+	}
+
+	Batch batch;
+	batch.remaining = num_tiles;
+
+	/* Deal tiles out round robin so each worker starts on its own share.
+	Each tile is counted under its queue's lock before it is pushed, the lock
+	take_task holds while it pops and uncounts it, so the count cannot drop
+	below zero and wake idle workers into a spin */
+	{
+		std::lock_guard<std::mutex> lock(wake_lock);
+		for(uint tile=0; tile<num_tiles; ++tile) {
+			Task task;
+			task.fn = &fn;
+			task.batch = &batch;
+			task.begin = begin + (tile * tile_size);
+			task.end = std::min(task.begin + tile_size, end);
+
+			WorkQueue &queue = queues[tile % queues.size()];
+			std::lock_guard<std::mutex> queue_lock(queue.lock);
+			++queued_tasks;
+			queue.tasks.push_back(task);
+		}
+	}
+	wake.notify_all();
+
+	/* Help out until the queues are empty, then wait for tiles still running */
+	Task task;
+	while(batch.remaining > 0 && take_task((uint)queues.size(), task)) {
+		run_task(task);
+	}
+
+	std::unique_lock<std::mutex> lock(batch.lock);
+	batch.done.wait(lock, [&batch] { return batch.remaining == 0; });
+}
+
+void ThreadPool::worker_loop(uint queue_idx) {
+	Task task;
+	for(;;) {
+		if(take_task(queue_idx, task)) {
+			run_task(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(wake_lock);
+		wake.wait(lock, [this] { return exit || queued_tasks > 0; });
+		if(exit && queued_tasks == 0) {
+			return;
+		}
+	}
+}
+
+/* queue_idx outside the range of queues steals from every queue */
+bool ThreadPool::take_task(uint queue_idx, Task &task) {
+	const uint num_queues = (uint)queues.size();
+
+	if(queue_idx < num_queues) {
+		WorkQueue &own = queues[queue_idx];
+		std::lock_guard<std::mutex> lock(own.lock);
+		if(!own.tasks.empty()) {
+			task = own.tasks.back();
+			own.tasks.pop_back();
+			--queued_tasks;
+			return true;
+		}
+	}
+
+	for(uint i=1; i<=num_queues; ++i) {
+		WorkQueue &victim = queues[(queue_idx + i) % num_queues];
+		std::lock_guard<std::mutex> lock(victim.lock);
+		if(!victim.tasks.empty()) {
+			task = victim.tasks.front();
+			victim.tasks.pop_front();
+			--queued_tasks;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ThreadPool::run_task(Task &task) {
+	(*task.fn)(task.begin, task.end);
+
+	/* Decrement under the batch lock so the waiting caller cannot
+	return and destroy the batch while it is still being notified */
+	Batch *batch = task.batch;
+	std::lock_guard<std::mutex> lock(batch->lock);
+	if(--batch->remaining == 0) {
+		batch->done.notify_all();
+	}
+}
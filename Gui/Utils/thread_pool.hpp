@@ -0,0 +1,71 @@
+#pragma once
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Utils/types.hpp"
+
+/* Work stealing pool for splitting a loop into tiles. Each worker owns a
+queue of tiles, takes work from the back of its own queue and steals from
+the front of the others once it runs dry. The thread calling parallel_for
+works on the tiles too, so a pool of n threads starts n-1 workers */
+class ThreadPool {
+public:
+	typedef std::function<void(uint, uint)> TileFunction;
+
+	/* num_threads of 0 uses one thread per hardware thread */
+	ThreadPool(uint num_threads);
+	~ThreadPool();
+
+	uint size() const;
+
+	/* Calls fn(tile_begin, tile_end) for consecutive tiles of tile_size
+	covering [begin, end) and returns once every tile has completed */
+	void parallel_for(uint begin, uint end, uint tile_size, const TileFunction &fn);
+
+	/* Number of tiles parallel_for will split [begin, end) into */
+	static uint tile_count(uint begin, uint end, uint tile_size);
+
+private:
+	struct Batch {
+		std::atomic<uint> remaining;
+		std::mutex lock;
+		std::condition_variable done;
+	};
+
+	struct Task {
+		const TileFunction *fn;
+		Batch *batch;
+		uint begin;
+		uint end;
+	};
+
+	struct WorkQueue {
+		std::mutex lock;
+		std::deque<Task> tasks;
+	};
+
+	uint num_threads;
+	std::vector<std::thread> workers;
+	std::vector<WorkQueue> queues;
+
+	std::mutex wake_lock;
+	std::condition_variable wake;
+	/* Tiles waiting in the queues, only changed under the lock of the queue
+	the tile is pushed to or popped from */
+	std::atomic<uint> queued_tasks;
+	bool exit = false;
+
+	void worker_loop(uint queue_idx);
+	bool take_task(uint queue_idx, Task &task);
+	static void run_task(Task &task);
+};
+
+#endif /* THREAD_POOL_HPP */
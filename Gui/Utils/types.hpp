@@ -7,4 +7,10 @@ typedef unsigned short ushort;
 typedef unsigned int uint;
 typedef unsigned long ulong;
 
+/* MSVC spelling of a forced inline, GCC and Clang builds of the tracking
+code, such as the benchmark on Linux hosts, use the equivalent attribute */
+#if !defined(_MSC_VER) && !defined(__forceinline)
+#define __forceinline inline __attribute__((always_inline))
+#endif
+
 #endif /* TYPES_HPP */
@@ -93,6 +93,7 @@ void Controller::init_gui_chart() {
 void Controller::start_processing() {
 	if(!running) {
 		update_settings();
+		ui.imageDisplayLabel->clear();
 		running = true;
 		stop = false;
 		processing_thread = std::thread(&Controller::_start_processing, this);
@@ -106,10 +107,12 @@ void Controller::_start_processing() {
 	cpu_tracking_times.frame_times_ms.clear();
 	cpu_tracking_times.total_ms = 0;
 	cpu_tracking_times.max_frame_time_ms = 0;
+	cpu_tracking_times.dropped_frames = 0;
 
 	gpu_tracking_times.frame_times_ms.clear();
 	gpu_tracking_times.total_ms = 0;
 	gpu_tracking_times.max_frame_time_ms = 0;
+	gpu_tracking_times.dropped_frames = 0;
 
 	cpu_tracking_series->clear();
 	gpu_tracking_series->clear();
@@ -119,45 +122,70 @@ void Controller::_start_processing() {
 
 	emit updateUiRequest(QImage(), cpu_frame, gpu_frame);
 
-	steps = PanguServer::read_pangu_steps(flight_file_path);
+	steps = read_pangu_steps(flight_file_path);
 	settings.max_frames = std::min(settings.max_frames, (uint)steps.size());
 
+	/* Render the flight once and track it with both engines side by side */
+	FrameDistributor distributor(pangu);
+	if(pangu.frame_policy == FRAME_POLICY_LATEST) {
+		/* Keep the workers' queues short so stale frames back up into the server's queue and are dropped there */
+		distributor.max_worker_queue_size = 1;
+	}
+	pangu.max_consumer_images = distributor.max_held_images();
 	pangu.start(settings.max_frames);
-	feature_tracking(&(FeatureTrackingCpu(settings)), cpu_frame, cpu_tracking_times, cpu_pen_bgr);
-	pangu.stop();
-
-	pangu.start(settings.max_frames);
-	feature_tracking(&(FeatureTrackingGpu(cuda_device, settings)), gpu_frame, gpu_tracking_times, gpu_pen_bgr);
+	distributor.add_worker([this, &distributor](uint worker_idx) {
+		FeatureTrackingCpu tracking(settings);
+		feature_tracking(&tracking, distributor, worker_idx, processed_image, cpu_frame, cpu_tracking_times, cpu_pen_bgr);
+	});
+	distributor.add_worker([this, &distributor](uint worker_idx) {
+		/* The CUDA device is selected per thread, so the engine is created on
+		its worker. The preview shows the CPU engine's features only, two
+		overlays drawn in turn would flicker */
+		FeatureTrackingGpu tracking(cuda_device, settings);
+		feature_tracking(&tracking, distributor, worker_idx, nullptr, gpu_frame, gpu_tracking_times, gpu_pen_bgr);
+	});
+	distributor.start(settings.max_frames);
+	distributor.join();
 	pangu.stop();
 
 	emit finishedProcessing();
 }
 
-void Controller::feature_tracking(FeatureTracking *tracking, uint &frame_counter, ProcessingTimes &times, Colour pen_colour) {
-	for(frame_counter=1; frame_counter<=settings.max_frames && !stop; ++frame_counter) {
-		uchar *original_image = pangu.get_image(5000);
-		if(!original_image) {
+void Controller::feature_tracking(FeatureTracking *tracking, FrameDistributor &distributor, uint worker_idx, uchar *processed_image, std::atomic<uint> &frame_counter, ProcessingTimes &times, Colour pen_colour) {
+	frame_counter = 0;
+	while(!stop) {
+		SharedFrame *frame = distributor.get_frame(worker_idx, 5000);
+		if(!frame) {
 			break;
 		}
-		gray_arr_to_rgb_mat(&original_image[pangu.image_offset], processed_image, image_width, image_height);
+		/* Progress follows the flight, which skips ahead past dropped frames */
+		frame_counter = frame->frame_idx + 1;
+		times.dropped_frames += frame->dropped;
+		uchar *original_image = frame->image;
+		if(processed_image) {
+			gray_arr_to_rgb_mat(&original_image[pangu.image_offset], processed_image, image_width, image_height);
+		}
 
 		std::chrono::high_resolution_clock::time_point start_time = std::chrono::high_resolution_clock::now();
-		std::vector<HarrisPoint> feature_points = tracking->feature_points(&original_image[pangu.image_offset]);
+		const FeatureStore &feature_points = tracking->feature_points(&original_image[pangu.image_offset]);
 		std::chrono::high_resolution_clock::time_point end_time = std::chrono::high_resolution_clock::now();
 		double duration_ms = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time).count() / 1000.0;
 		times.frame_times_ms.push_back(duration_ms);
 		times.total_ms += duration_ms;
 
-		mark_feature_points(processed_image, feature_points, image_width, image_height, 1, pen_colour);
-
-		QImage tmp = QImage(processed_image, image_width, image_height, QImage::Format::Format_RGB888);
+		/* Workers without the preview still report their progress, with a null image */
+		QImage preview;
+		if(processed_image) {
+			mark_feature_points(processed_image, feature_points, image_width, image_height, 1, pen_colour);
+			preview = QImage(processed_image, image_width, image_height, QImage::Format::Format_RGB888).copy();
+		}
 		emit updateUiRequest(
-			tmp.copy(),
+			preview,
 			(uint)(((float)cpu_frame / (settings.max_frames) * 100.0f)),
 			(uint)(((float)gpu_frame / (settings.max_frames) * 100.0f))
 		);
 
-		free(original_image);
+		distributor.release_frame(frame);
 	}
 }
 
@@ -182,10 +210,27 @@ void Controller::update_settings() {
 	settings.correlation_threshhold = ui.correlationThreshholdSpinBox->value();
 	settings.template_update_frames = ui.templateUpdateFramesSpinBox->value();
 	settings.template_update_distance_threshhold = ui.templateUpdateMaximumDistanceSpinBox->value();
+	settings.num_threads = ui.threadsSpinBox->value();
+	/* Combo box entries are in the order of SuppressionMode */
+	settings.suppression_mode = (SuppressionMode)ui.suppressionModeComboBox->currentIndex();
+	settings.suppression_range = ui.suppressionRangeSpinBox->value();
+
+	/* The server is stopped here, so its settings can be changed directly. Combo box entries are in the order of FramePolicy */
+	pangu.frame_policy = (FramePolicy)ui.framePolicyComboBox->currentIndex();
+	pangu.max_image_queue_bytes = (size_t)ui.imageQueueBudgetSpinBox->value() * 1024 * 1024;
+	/* A malformed server list keeps the servers of the last run */
+	parse_pangu_endpoints(ui.panguServersLineEdit->text().toStdString(), pangu.endpoints);
+	pangu.num_connections = ui.panguConnectionsSpinBox->value();
+	pangu.pipeline_depth = ui.pipelineDepthSpinBox->value();
+	/* An empty path renders every frame */
+	pangu.cache_path = ui.frameCachePathLineEdit->text().trimmed().toStdString();
+	pangu.scene_tag = ui.sceneTagLineEdit->text().toStdString();
 }
 
 void Controller::onUpdateUiRequest(QImage q_image, uint cpu_progress, uint gpu_progress) {
-	ui.imageDisplayLabel->setPixmap(QPixmap::fromImage(q_image));
+	if(!q_image.isNull()) {
+		ui.imageDisplayLabel->setPixmap(QPixmap::fromImage(q_image));
+	}
 
 	ui.cpuProgressBar->setValue(cpu_progress);
 	ui.gpuProgressBar->setValue(gpu_progress);
@@ -229,6 +274,7 @@ void Controller::update_gui_stats() {
 		ui.cpuAverageFrameTimeLabel->setText("N/A");
 		ui.cpuMaxFrameTimeLabel->setText("N/A");
 		ui.cpuTotalProcessingTimeLabel->setText("N/A");
+		ui.cpuDroppedFramesLabel->setText("0");
 	} else {
 		text.sprintf("%u", cpu_num_frames);
 		ui.cpuFramesProcessedLabel->setText(text);
@@ -238,6 +284,8 @@ void Controller::update_gui_stats() {
 		ui.cpuMaxFrameTimeLabel->setText(text);
 		text.sprintf("%.2f seconds", cpu_tracking_times.total_ms/1000);
 		ui.cpuTotalProcessingTimeLabel->setText(text);
+		text.sprintf("%u", cpu_tracking_times.dropped_frames);
+		ui.cpuDroppedFramesLabel->setText(text);
 	}
 
 	uint gpu_num_frames = gpu_tracking_times.frame_times_ms.size();
@@ -246,6 +294,7 @@ void Controller::update_gui_stats() {
 		ui.gpuAverageFrameTimeLabel->setText("N/A");
 		ui.gpuMaxFrameTimeLabel->setText("N/A");
 		ui.gpuTotalProcessingTimeLabel->setText("N/A");
+		ui.gpuDroppedFramesLabel->setText("0");
 	} else {
 		text.sprintf("%u", gpu_num_frames);
 		ui.gpuFramesProcessedLabel->setText(text);
@@ -255,6 +304,8 @@ void Controller::update_gui_stats() {
 		ui.gpuMaxFrameTimeLabel->setText(text);
 		text.sprintf("%.2f seconds", gpu_tracking_times.total_ms/1000);
 		ui.gpuTotalProcessingTimeLabel->setText(text);
+		text.sprintf("%u", gpu_tracking_times.dropped_frames);
+		ui.gpuDroppedFramesLabel->setText(text);
 	}
 }
 
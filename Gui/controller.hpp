@@ -2,6 +2,7 @@
 #ifndef CONTROLLER_HPP
 #define CONTROLLER_HPP
 
+#include <atomic>
 #include <vector>
 #include <chrono>
 
@@ -10,6 +11,7 @@
 #include <QtCharts\QValueAxis>
 
 #include "Pangu/pangu_server.hpp"
+#include "Pangu/frame_distributor.hpp"
 #include "Utils/utils.hpp"
 #include "Tracking/feature_tracking.hpp"
 #include "ui_gui.h"
@@ -18,6 +20,8 @@ struct ProcessingTimes {
 	std::vector<double> frame_times_ms;
 	double max_frame_time_ms = 0;
 	double total_ms = 0;
+	/* Frames skipped because tracking fell behind the renderer */
+	uint dropped_frames = 0;
 };
 
 class Controller : QObject {
@@ -40,12 +44,14 @@ private:
 	std::vector<PanguStep> steps;
 	TrackingSettings settings;
 	size_t processed_image_size;
+	/* Preview of the CPU engine's frames with its features marked */
 	uchar *processed_image;
 	bool running = false;
 	std::atomic<bool> stop = false;
 	std::thread processing_thread;
-	uint cpu_frame;
-	uint gpu_frame;
+	/* Progress of each engine, both workers read both when reporting progress */
+	std::atomic<uint> cpu_frame;
+	std::atomic<uint> gpu_frame;
 	ProcessingTimes cpu_tracking_times;
 	ProcessingTimes gpu_tracking_times;
 	QtCharts::QLineSeries *cpu_tracking_series;
@@ -62,7 +68,7 @@ private:
 
 	void update_settings();
 	void _start_processing();
-	void feature_tracking(FeatureTracking *tracking, uint &frame_counter, ProcessingTimes &times, Colour pen_colour);
+	void feature_tracking(FeatureTracking *tracking, FrameDistributor &distributor, uint worker_idx, uchar *processed_image, std::atomic<uint> &frame_counter, ProcessingTimes &times, Colour pen_colour);
 	void init_gui_chart();
 	void update_gui_chart();
 	void update_gui_stats();
@@ -0,0 +1,427 @@
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#include "kernel_benchmark.hpp"
+#include "Tracking/feature_tracking.hpp"
+#include "Utils/cpu_features.hpp"
+
+/* Side length of the cells texture is switched on and off in, and of the
+blocks of one brightness inside textured cells */
+static const uint texture_cell_size = 16;
+static const uint texture_block_size = 4;
+
+/* Columns of the response filtered side by side by the dense suppression */
+static const uint max_filter_strip_cols = 64;
+
+/* Candidates ordered in the first selection batch per feature wanted, as in FeatureTrackingCpu */
+static const uint candidate_batch_factor = 4;
+
+/* Bytes read and written per unit when every buffer is touched once. The
+correlation search reads the 13x13 input pixels around a feature and its 49
+float template, plus the 14x14 integral image entries when it uses tables */
+static const double signature_bytes = 49 * (1 + 4);
+static const double gradient_bytes = 1 + (3 * 2);
+static const double horizontal_blur_bytes = (3 * 2) + (3 * 4);
+static const double vertical_blur_bytes = (3 * 4) + (3 * 4);
+static const double response_bytes = (3 * 4) + 4;
+static const double greedy_maxima_bytes = 4;
+static const double dense_maxima_bytes = 4 + (2 * 4) + (2 * 4);
+static const double integral_bytes = 1 + (4 + 8) + (2 * (4 + 8));
+static const double track_table_bytes = (49 * 4) + (13 * 13 * 1) + (14 * 14 * (4 + 8));
+static const double track_local_bytes = (49 * 4) + (13 * 13 * 1);
+
+static unsigned long long mix(unsigned long long x) {
+	x ^= x >> 33;
+	x *= 0xFF51AFD7ED558CCDULL;
+	x ^= x >> 33;
+	x *= 0xC4CEB9FE1A85EC53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+static double median(std::vector<double> &values) {
+	std::sort(values.begin(), values.end());
+	return values[values.size() / 2];
+}
+
+/* Paths on Windows hosts carry backslashes, which JSON has to escape */
+static void write_json_string(FILE *file, const std::string &value) {
+	fputc('"', file);
+	for(size_t i=0; i<value.size(); ++i) {
+		if(value[i] == '"' || value[i] == '\\') {
+			fputc('\\', file);
+		}
+		fputc(value[i], file);
+	}
+	fputc('"', file);
+}
+
+KernelBenchmark::KernelBenchmark(const KernelBenchmarkSettings &settings) :
+	settings(settings)
+{
+	/* Empty */
+}
+
+bool KernelBenchmark::run() {
+	for(size_t i=0; i<settings.sizes.size(); ++i) {
+		for(size_t j=0; j<settings.densities.size(); ++j) {
+			Frame frame;
+			frame.size = settings.sizes[i];
+			if(frame.size.cols < 16 || frame.size.rows < 16) {
+				fprintf(stderr, "Skipping %ux%u, images must be at least 16x16\n", frame.size.cols, frame.size.rows);
+				continue;
+			}
+
+			allocate(frame);
+			generate_image(frame, settings.densities[j]);
+			benchmark_frame(frame, settings.densities[j]);
+		}
+	}
+
+	return write_report();
+}
+
+void KernelBenchmark::benchmark_frame(Frame &frame, double density) {
+	/* Run the pipeline once so each kernel reads realistic input */
+	gradients(frame, sobel_row_scalar);
+	horizontal_blur(frame);
+	vertical_blur(frame);
+	response(frame, settings.sensitivity);
+	integral_images(frame);
+	maxima(frame, false);
+
+	/* Features to track are the selected corners with their templates */
+	const uint border = 1 + FeatureTracking::filter_range;
+	frame.features.clear();
+	for(size_t i=0; i<frame.selected.size(); ++i) {
+		frame.features.push_back(Point(frame.selected[i].location.x + border, frame.selected[i].location.y + border));
+	}
+	signatures(frame);
+
+	const size_t pixels = (size_t)frame.size.cols * frame.size.rows;
+	const size_t gradient_pixels = (size_t)frame.gradient_cols * frame.gradient_rows;
+	const size_t horizontal_blur_pixels = (size_t)frame.blur_cols * frame.gradient_rows;
+	const size_t blur_pixels = (size_t)frame.blur_cols * frame.blur_rows;
+
+	/* Each Sobel implementation the processor supports */
+	SobelRowFunction previous = nullptr;
+	for(int level=SIMD_SCALAR; level<=detect_simd_level(); ++level) {
+		const SobelRowFunction sobel_row = sobel_row_function((SimdLevel)level);
+		if(sobel_row == previous) {
+			continue;
+		}
+		previous = sobel_row;
+		measure(frame, density, "gradients", simd_level_name((SimdLevel)level), "pixel", gradient_pixels, gradient_bytes, [&frame, sobel_row]() {
+			gradients(frame, sobel_row);
+		});
+	}
+
+	measure(frame, density, "blur_horizontal", "Scalar", "pixel", horizontal_blur_pixels, horizontal_blur_bytes, [&frame]() {
+		horizontal_blur(frame);
+	});
+	measure(frame, density, "blur_vertical", "Scalar", "pixel", blur_pixels, vertical_blur_bytes, [&frame]() {
+		vertical_blur(frame);
+	});
+
+	const float sensitivity = settings.sensitivity;
+	measure(frame, density, "response", "Scalar", "pixel", blur_pixels, response_bytes, [&frame, sensitivity]() {
+		response(frame, sensitivity);
+	});
+
+	measure(frame, density, "maxima", "greedy", "pixel", blur_pixels, greedy_maxima_bytes, [this, &frame]() {
+		maxima(frame, false);
+	});
+	measure(frame, density, "maxima", "dense", "pixel", blur_pixels, dense_maxima_bytes, [this, &frame]() {
+		maxima(frame, true);
+	});
+
+	measure(frame, density, "integral", "Scalar", "pixel", pixels, integral_bytes, [&frame]() {
+		integral_images(frame);
+	});
+
+	measure(frame, density, "signature", "Scalar", "feature", frame.features.size(), signature_bytes, [&frame]() {
+		signatures(frame);
+	});
+
+	/* The search with summed area tables as FeatureTrackingCpu builds them
+	for its intermediate images, and with sums from the pixels around each
+	feature as the engines search otherwise */
+	std::vector<Point> locations(frame.features.size());
+	measure(frame, density, "track", "table", "feature", frame.features.size(), track_table_bytes, [this, &frame, &locations]() {
+		track(frame, true, locations);
+	});
+	measure(frame, density, "track", "local", "feature", frame.features.size(), track_local_bytes, [this, &frame, &locations]() {
+		track(frame, false, locations);
+	});
+}
+
+void KernelBenchmark::measure(
+	const Frame &frame, double density,
+	const char *kernel, const char *variant, const char *unit,
+	size_t units, double bytes_per_unit,
+	const std::function<void()> &pass)
+{
+	if(units == 0 || std::string(kernel).compare(0, settings.kernel.size(), settings.kernel) != 0) {
+		return;
+	}
+
+	/* One untimed pass brings the buffers into cache as far as they fit */
+	pass();
+
+	std::vector<double> times_ns;
+	std::vector<double> cycles;
+	double total_ms = 0;
+	while(times_ns.size() < std::max(settings.min_passes, 1u) || total_ms < settings.min_time_ms) {
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const unsigned long long start_cycles = __rdtsc();
+		pass();
+		const unsigned long long end_cycles = __rdtsc();
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+		const double time_ns = std::chrono::duration<double, std::nano>(end - start).count();
+		times_ns.push_back(time_ns);
+		cycles.push_back((double)(end_cycles - start_cycles));
+		total_ms += time_ns / 1e6;
+	}
+
+	Result result;
+	result.kernel = kernel;
+	result.variant = variant;
+	result.size = frame.size;
+	result.density = density;
+	result.unit = unit;
+	result.units = units;
+	result.passes = (uint)times_ns.size();
+	result.ns_per_unit = median(times_ns) / units;
+	result.bytes_per_cycle = bytes_per_unit * units / median(cycles);
+	results.push_back(result);
+}
+
+bool KernelBenchmark::write_report() {
+	FILE *file = stdout;
+	bool header = true;
+	if(!settings.output_path.empty()) {
+		file = fopen(settings.output_path.c_str(), settings.format == REPORT_CSV ? "ab" : "wb");
+		if(!file) {
+			fprintf(stderr, "Failed to open %s\n", settings.output_path.c_str());
+			return false;
+		}
+		fseek(file, 0, SEEK_END);
+		header = ftell(file) == 0;
+	}
+
+	const char *simd = simd_level_name(detect_simd_level());
+	if(settings.format == REPORT_CSV) {
+		if(header) {
+			fprintf(file, "simd,kernel,variant,width,height,density,unit,units,passes,ns_per_unit,bytes_per_cycle\n");
+		}
+		for(size_t i=0; i<results.size(); ++i) {
+			const Result &result = results[i];
+			fprintf(file, "%s,%s,%s,%u,%u,%.3f,%s,%zu,%u,%.4f,%.4f\n",
+				simd, result.kernel.c_str(), result.variant.c_str(), result.size.cols, result.size.rows,
+				result.density, result.unit, result.units, result.passes, result.ns_per_unit, result.bytes_per_cycle);
+		}
+	} else {
+		fprintf(file, "{\n");
+		fprintf(file, "\t\"simd\": \"%s\",\n", simd);
+		fprintf(file, "\t\"results\": [\n");
+		for(size_t i=0; i<results.size(); ++i) {
+			const Result &result = results[i];
+			fprintf(file, "\t\t{\"kernel\": \"%s\", \"variant\": ", result.kernel.c_str());
+			write_json_string(file, result.variant);
+			fprintf(file, ", \"width\": %u, \"height\": %u, \"density\": %.3f, \"unit\": \"%s\", \"units\": %zu, \"passes\": %u, \"ns_per_unit\": %.4f, \"bytes_per_cycle\": %.4f}%s\n",
+				result.size.cols, result.size.rows, result.density, result.unit, result.units, result.passes,
+				result.ns_per_unit, result.bytes_per_cycle, i + 1 < results.size() ? "," : "");
+		}
+		fprintf(file, "\t]\n");
+		fprintf(file, "}\n");
+	}
+
+	const bool written = !ferror(file);
+	if(file != stdout) {
+		fclose(file);
+	}
+	return written;
+}
+
+void KernelBenchmark::generate_image(Frame &frame, double density) {
+	const uint cols = frame.size.cols;
+	const uint rows = frame.size.rows;
+
+	/* Cells are textured by a hash of their position, so an image of one
+	size and density is the same on every run and host */
+	for(uint y=0; y<rows; ++y) {
+		for(uint x=0; x<cols; ++x) {
+			const unsigned long long cell = mix(((unsigned long long)(y / texture_cell_size) << 32) | (x / texture_cell_size));
+			const bool textured = (cell >> 11) * (1.0 / 9007199254740992.0) < density;
+
+			uchar value;
+			if(textured) {
+				const unsigned long long block = ((unsigned long long)(y / texture_block_size) << 32) | (x / texture_block_size);
+				value = (uchar)(mix(block ^ 0x9E3779B97F4A7C15ULL) >> 56);
+			} else {
+				value = (uchar)(64 + (((unsigned long long)x + y) * 64) / (cols + rows));
+			}
+			frame.input[idx_1d(x, y, cols)] = value;
+		}
+	}
+}
+
+void KernelBenchmark::allocate(Frame &frame) {
+	const uint filter_range = FeatureTracking::filter_range;
+	frame.gradient_cols = frame.size.cols - 2;
+	frame.gradient_rows = frame.size.rows - 2;
+	frame.blur_cols = frame.gradient_cols - (filter_range * 2);
+	frame.blur_rows = frame.gradient_rows - (filter_range * 2);
+
+	const size_t pixels = (size_t)frame.size.cols * frame.size.rows;
+	const size_t gradient_pixels = (size_t)frame.gradient_cols * frame.gradient_rows;
+	const size_t horizontal_blur_pixels = (size_t)frame.blur_cols * frame.gradient_rows;
+	const size_t blur_pixels = (size_t)frame.blur_cols * frame.blur_rows;
+	const size_t integral_pixels = (size_t)(frame.size.cols + 1) * (frame.size.rows + 1);
+
+	frame.input.resize(pixels);
+	frame.gradient_x2.resize(gradient_pixels);
+	frame.gradient_y2.resize(gradient_pixels);
+	frame.gradient_xy.resize(gradient_pixels);
+	frame.horizontal_blur_x2.resize(horizontal_blur_pixels);
+	frame.horizontal_blur_y2.resize(horizontal_blur_pixels);
+	frame.horizontal_blur_xy.resize(horizontal_blur_pixels);
+	frame.blur_x2.resize(blur_pixels);
+	frame.blur_y2.resize(blur_pixels);
+	frame.blur_xy.resize(blur_pixels);
+	frame.response.resize(blur_pixels);
+	frame.horizontal_max_response.resize(blur_pixels);
+	frame.max_response.resize(blur_pixels);
+	frame.integral.assign(integral_pixels, 0);
+	frame.integral_sq.assign(integral_pixels, 0);
+}
+
+void KernelBenchmark::signatures(Frame &frame) {
+	frame.signatures.resize(frame.features.size() * 49);
+	for(size_t i=0; i<frame.features.size(); ++i) {
+		cut_signature(frame.input.data(), frame.size.cols, frame.size.rows, frame.features[i], FeatureTracking::uchar_normalize_table, &frame.signatures[i * 49]);
+	}
+}
+
+void KernelBenchmark::gradients(Frame &frame, SobelRowFunction sobel_row) {
+	for(uint y=0; y<frame.gradient_rows; ++y) {
+		const uint idx = idx_1d(0, y, frame.gradient_cols);
+		sobel_row(
+			&frame.input[idx_1d(0, y+0, frame.size.cols)],
+			&frame.input[idx_1d(0, y+1, frame.size.cols)],
+			&frame.input[idx_1d(0, y+2, frame.size.cols)],
+			frame.gradient_cols,
+			&frame.gradient_x2[idx], &frame.gradient_y2[idx], &frame.gradient_xy[idx]
+		);
+	}
+}
+
+void KernelBenchmark::horizontal_blur(Frame &frame) {
+	for(uint y=0; y<frame.gradient_rows; ++y) {
+		const uint gradient_idx = idx_1d(0, y, frame.gradient_cols);
+		const uint blur_idx = idx_1d(0, y, frame.blur_cols);
+		horizontal_blur_row(
+			&frame.gradient_x2[gradient_idx], &frame.gradient_y2[gradient_idx], &frame.gradient_xy[gradient_idx], frame.blur_cols,
+			FeatureTracking::gaussian_kernel, FeatureTracking::filter_width,
+			&frame.horizontal_blur_x2[blur_idx], &frame.horizontal_blur_y2[blur_idx], &frame.horizontal_blur_xy[blur_idx]
+		);
+	}
+}
+
+void KernelBenchmark::vertical_blur(Frame &frame) {
+	const float *rows_x2[FeatureTracking::filter_width];
+	const float *rows_y2[FeatureTracking::filter_width];
+	const float *rows_xy[FeatureTracking::filter_width];
+	for(uint y=0; y<frame.blur_rows; ++y) {
+		for(uint k=0; k<FeatureTracking::filter_width; ++k) {
+			const uint idx = idx_1d(0, y+k, frame.blur_cols);
+			rows_x2[k] = &frame.horizontal_blur_x2[idx];
+			rows_y2[k] = &frame.horizontal_blur_y2[idx];
+			rows_xy[k] = &frame.horizontal_blur_xy[idx];
+		}
+
+		const uint idx = idx_1d(0, y, frame.blur_cols);
+		vertical_blur_row(
+			rows_x2, rows_y2, rows_xy, frame.blur_cols,
+			FeatureTracking::gaussian_kernel, FeatureTracking::filter_width,
+			&frame.blur_x2[idx], &frame.blur_y2[idx], &frame.blur_xy[idx]
+		);
+	}
+}
+
+void KernelBenchmark::response(Frame &frame, float sensitivity) {
+	for(uint y=0; y<frame.blur_rows; ++y) {
+		const uint idx = idx_1d(0, y, frame.blur_cols);
+		harris_response_row(&frame.blur_x2[idx], &frame.blur_y2[idx], &frame.blur_xy[idx], frame.blur_cols, sensitivity, &frame.response[idx]);
+	}
+}
+
+void KernelBenchmark::max_response(Frame &frame, uint range) {
+	std::vector<float> forward((frame.blur_cols + (range * 2)) * max_filter_strip_cols);
+	std::vector<float> backward((frame.blur_cols + (range * 2)) * max_filter_strip_cols);
+	for(uint y=0; y<frame.blur_rows; ++y) {
+		const uint idx = idx_1d(0, y, frame.blur_cols);
+		max_filter_line(&frame.response[idx], &frame.horizontal_max_response[idx], frame.blur_cols, 1, 1, range, forward.data(), backward.data());
+	}
+
+	forward.resize((frame.blur_rows + (range * 2)) * max_filter_strip_cols);
+	backward.resize((frame.blur_rows + (range * 2)) * max_filter_strip_cols);
+	for(uint begin=0; begin<frame.blur_cols; begin+=max_filter_strip_cols) {
+		const uint width = std::min(max_filter_strip_cols, frame.blur_cols - begin);
+		max_filter_line(&frame.horizontal_max_response[begin], &frame.max_response[begin], frame.blur_rows, frame.blur_cols, width, range, forward.data(), backward.data());
+	}
+}
+
+void KernelBenchmark::integral_images(Frame &frame) {
+	const uint integral_cols = frame.size.cols + 1;
+	for(uint y=0; y<frame.size.rows; ++y) {
+		integral_row(
+			&frame.input[idx_1d(0, y, frame.size.cols)], frame.size.cols,
+			&frame.integral[idx_1d(0, y+1, integral_cols)], &frame.integral_sq[idx_1d(0, y+1, integral_cols)]
+		);
+	}
+	for(uint y=2; y<=frame.size.rows; ++y) {
+		integral_accumulate_row(
+			&frame.integral[idx_1d(0, y-1, integral_cols)], &frame.integral_sq[idx_1d(0, y-1, integral_cols)], 1, integral_cols,
+			&frame.integral[idx_1d(0, y, integral_cols)], &frame.integral_sq[idx_1d(0, y, integral_cols)]
+		);
+	}
+}
+
+void KernelBenchmark::maxima(Frame &frame, bool dense) {
+	if(dense) {
+		max_response(frame, settings.suppression_range);
+	}
+
+	frame.candidates.clear();
+	for(uint y=0; y<frame.blur_rows; ++y) {
+		const uint idx = idx_1d(0, y, frame.blur_cols);
+		collect_candidates_row(&frame.response[idx], dense ? &frame.max_response[idx] : nullptr, frame.blur_cols, y, settings.harris_response_threshhold, frame.candidates);
+	}
+
+	select_maxima(
+		frame.candidates, frame.blur_cols, frame.blur_rows, settings.suppression_range,
+		settings.max_tracked_features, candidate_batch_factor,
+		frame.suppression, frame.selected
+	);
+}
+
+void KernelBenchmark::track(Frame &frame, bool tables, std::vector<Point> &locations) {
+	TrackingFrame tracking_frame;
+	tracking_frame.input = frame.input.data();
+	tracking_frame.integral = tables ? frame.integral.data() : nullptr;
+	tracking_frame.integral_sq = tables ? frame.integral_sq.data() : nullptr;
+	tracking_frame.cols = frame.size.cols;
+	tracking_frame.rows = frame.size.rows;
+
+	for(size_t i=0; i<frame.features.size(); ++i) {
+		track_template(tracking_frame, frame.features[i], &frame.signatures[i * 49], locations[i]);
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+#ifndef KERNEL_BENCHMARK_HPP
+#define KERNEL_BENCHMARK_HPP
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Tracking/Cpu/sobel_simd.hpp"
+#include "Tracking/Cpu/tracking_kernels.hpp"
+#include "Utils/types.hpp"
+
+enum ReportFormat {
+	REPORT_JSON,
+	REPORT_CSV
+};
+
+struct ImageSize {
+	uint cols;
+	uint rows;
+};
+
+struct KernelBenchmarkSettings {
+	std::vector<ImageSize> sizes;
+	/* Fraction of 16x16 cells of each synthetic image holding texture, the
+	rest is a smooth ramp without corners */
+	std::vector<double> densities;
+	/* Only run kernels whose name starts with this */
+	std::string kernel;
+	/* Each kernel is run over the whole image until both are reached, the
+	median pass is reported */
+	uint min_passes;
+	double min_time_ms;
+	/* Settings the selection and tracking kernels run with, the Gui's defaults */
+	float sensitivity;
+	float harris_response_threshhold;
+	uint suppression_range;
+	uint max_tracked_features;
+	ReportFormat format;
+	/* Report file, printed when empty. CSV rows are appended and the header
+	is only written to a new file */
+	std::string output_path;
+
+	KernelBenchmarkSettings() {
+		const ImageSize default_sizes[] = {{640, 480}, {1024, 768}, {1920, 1080}, {3840, 2160}};
+		sizes.assign(default_sizes, default_sizes + 4);
+		densities.push_back(0.1);
+		densities.push_back(0.5);
+		densities.push_back(1.0);
+		min_passes = 5;
+		min_time_ms = 200;
+		sensitivity = 0.04f;
+		harris_response_threshhold = 1000000.0f;
+		suppression_range = 3;
+		max_tracked_features = 200;
+		format = REPORT_JSON;
+	}
+};
+
+/* Times each CPU pipeline kernel on its own, single threaded, over synthetic
+images. Results are per pixel, or per feature for tracking, with bytes per
+cycle counting the bytes each unit has to read and write once */
+class KernelBenchmark {
+public:
+	KernelBenchmark(const KernelBenchmarkSettings &settings);
+
+	/* Run every kernel on every size and density and write the report.
+	Returns false if the report cannot be written */
+	bool run();
+
+private:
+	struct Result {
+		std::string kernel;
+		std::string variant;
+		ImageSize size;
+		double density;
+		const char *unit;
+		size_t units;
+		uint passes;
+		double ns_per_unit;
+		double bytes_per_cycle;
+	};
+
+	/* Buffers of one image, filled by running the pipeline once so every
+	kernel is timed on the data it would see in an engine */
+	struct Frame {
+		ImageSize size;
+		uint gradient_cols, gradient_rows;
+		uint blur_cols, blur_rows;
+		std::vector<uchar> input;
+		std::vector<short> gradient_x2, gradient_y2, gradient_xy;
+		std::vector<float> horizontal_blur_x2, horizontal_blur_y2, horizontal_blur_xy;
+		std::vector<float> blur_x2, blur_y2, blur_xy;
+		std::vector<float> response;
+		std::vector<float> horizontal_max_response, max_response;
+		std::vector<uint> integral;
+		std::vector<unsigned long long> integral_sq;
+		std::vector<TempPointData> candidates, selected;
+		std::vector<bool> suppression;
+		std::vector<Point> features;
+		std::vector<float> signatures;
+	};
+
+	KernelBenchmarkSettings settings;
+	std::vector<Result> results;
+
+	void benchmark_frame(Frame &frame, double density);
+	void measure(
+		const Frame &frame, double density,
+		const char *kernel, const char *variant, const char *unit,
+		size_t units, double bytes_per_unit,
+		const std::function<void()> &pass);
+	bool write_report();
+
+	static void generate_image(Frame &frame, double density);
+	static void allocate(Frame &frame);
+	static void gradients(Frame &frame, SobelRowFunction sobel_row);
+	static void horizontal_blur(Frame &frame);
+	static void vertical_blur(Frame &frame);
+	static void response(Frame &frame, float sensitivity);
+	static void max_response(Frame &frame, uint range);
+	static void integral_images(Frame &frame);
+	void maxima(Frame &frame, bool dense);
+	static void signatures(Frame &frame);
+	void track(Frame &frame, bool tables, std::vector<Point> &locations);
+};
+
+#endif /* KERNEL_BENCHMARK_HPP */
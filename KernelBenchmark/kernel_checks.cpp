@@ -0,0 +1,254 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <stdio.h>
+
+#include "kernel_checks.hpp"
+#include "Tracking/Cpu/sobel_simd.hpp"
+#include "Tracking/Cpu/tracking_kernels.hpp"
+
+/* Side length of the images the checks search, the feature sits in the middle */
+static const uint check_size = 32;
+
+/* Row widths the Sobel check runs, around and between the 16 and 32 pixel
+vector widths so every implementation also runs its scalar tail */
+static const uint sobel_check_cols[] = {1, 2, 15, 16, 17, 31, 32, 33, 47, 63, 64, 65, 100, 1022};
+
+/* Output columns past cols which must be left alone */
+static const uint sobel_guard_cols = 64;
+static const short sobel_guard = 0x5A5A;
+
+/* Correlation the Gui accepts a match at by default */
+static const float correlation_threshhold = 0.5f;
+
+/* An image with the summed area tables the correlation search reads */
+struct CheckImage {
+	std::vector<uchar> input;
+	std::vector<uint> integral;
+	std::vector<unsigned long long> integral_sq;
+	TrackingFrame frame;
+};
+
+static unsigned long long mix(unsigned long long x) {
+	x ^= x >> 33;
+	x *= 0xFF51AFD7ED558CCDULL;
+	x ^= x >> 33;
+	x *= 0xC4CEB9FE1A85EC53ULL;
+	x ^= x >> 33;
+	return x;
+}
+
+static void build_tables(CheckImage &image) {
+	const uint integral_cols = check_size + 1;
+	image.integral.assign(integral_cols * integral_cols, 0);
+	image.integral_sq.assign(integral_cols * integral_cols, 0);
+	for(uint y=0; y<check_size; ++y) {
+		integral_row(&image.input[idx_1d(0, y, check_size)], check_size, &image.integral[idx_1d(0, y+1, integral_cols)], &image.integral_sq[idx_1d(0, y+1, integral_cols)]);
+	}
+	for(uint y=2; y<=check_size; ++y) {
+		integral_accumulate_row(
+			&image.integral[idx_1d(0, y-1, integral_cols)], &image.integral_sq[idx_1d(0, y-1, integral_cols)], 1, integral_cols,
+			&image.integral[idx_1d(0, y, integral_cols)], &image.integral_sq[idx_1d(0, y, integral_cols)]
+		);
+	}
+
+	image.frame.input = image.input.data();
+	image.frame.integral = image.integral.data();
+	image.frame.integral_sq = image.integral_sq.data();
+	image.frame.cols = check_size;
+	image.frame.rows = check_size;
+}
+
+static void textured_image(CheckImage &image, unsigned long long seed) {
+	image.input.resize(check_size * check_size);
+	for(uint i=0; i<image.input.size(); ++i) {
+		image.input[i] = (uchar)(mix(seed + i) >> 56);
+	}
+	build_tables(image);
+}
+
+static void flat_image(CheckImage &image, uchar level) {
+	image.input.assign(check_size * check_size, level);
+	build_tables(image);
+}
+
+/* The 7x7 template around the middle of image, normalized as the engines cut it */
+static void cut_template(const CheckImage &image, float *signature) {
+	cut_signature(image.input.data(), check_size, check_size, Point(check_size / 2, check_size / 2), FeatureTracking::uchar_normalize_table, signature);
+}
+
+static bool report(const char *name, bool passed) {
+	printf("%s %s\n", passed ? "PASS" : "FAIL", name);
+	return passed;
+}
+
+/* A textured template searched over a window of one grey level, for every
+level. The window has no variance so nothing may match */
+static bool check_flat_window() {
+	CheckImage textured;
+	textured_image(textured, 1);
+	float signature[49];
+	cut_template(textured, signature);
+
+	const Point middle(check_size / 2, check_size / 2);
+	bool passed = true;
+	for(uint level=0; level<256; ++level) {
+		CheckImage flat;
+		flat_image(flat, (uchar)level);
+		Point location;
+		const float correlation = track_template(flat.frame, middle, signature, location);
+		if(!std::isfinite(correlation) || correlation >= correlation_threshhold) {
+			printf("  grey level %u correlates %g\n", level, correlation);
+			passed = false;
+		}
+	}
+	return report("flat search window", passed);
+}
+
+/* A template of one grey level correlates with nothing */
+static bool check_flat_template() {
+	CheckImage textured;
+	textured_image(textured, 2);
+	float signature[49];
+	for(uint i=0; i<49; ++i) {
+		signature[i] = FeatureTracking::uchar_normalize_table[128];
+	}
+
+	Point location;
+	const float correlation = track_template(textured.frame, Point(check_size / 2, check_size / 2), signature, location);
+	return report("flat template", std::isfinite(correlation) && correlation < correlation_threshhold);
+}
+
+/* A template cut from a textured image is found where it was cut with a
+correlation of 1, and templates from other images stay within [-1, 1] */
+static bool check_bounds() {
+	const Point middle(check_size / 2, check_size / 2);
+	bool passed = true;
+	for(unsigned long long seed=10; seed<110; ++seed) {
+		CheckImage image;
+		textured_image(image, seed);
+		float signature[49];
+		cut_template(image, signature);
+
+		Point location;
+		float correlation = track_template(image.frame, middle, signature, location);
+		if(location.x != middle.x || location.y != middle.y || correlation < 0.999f || correlation > 1.0f) {
+			printf("  seed %llu found at (%u, %u) correlating %g\n", seed, location.x, location.y, correlation);
+			passed = false;
+		}
+
+		CheckImage other;
+		textured_image(other, seed * 7919);
+		correlation = track_template(other.frame, middle, signature, location);
+		if(!(correlation >= -1.0f && correlation <= 1.0f)) {
+			printf("  seed %llu against another image correlates %g\n", seed, correlation);
+			passed = false;
+		}
+	}
+	return report("correlation bounds", passed);
+}
+
+/* The search summing its windows from the pixels around the feature finds
+the same location with the same correlation as with the summed area tables,
+at every location including those whose search window crosses the edge */
+static bool check_local_sums() {
+	bool passed = true;
+	for(unsigned long long seed=200; seed<204; ++seed) {
+		CheckImage image;
+		textured_image(image, seed);
+		TrackingFrame local_frame = image.frame;
+		local_frame.integral = nullptr;
+		local_frame.integral_sq = nullptr;
+
+		CheckImage other;
+		textured_image(other, seed * 104729);
+		for(uint y=0; y<check_size; ++y) {
+			for(uint x=0; x<check_size; ++x) {
+				float signature[49];
+				cut_signature(other.input.data(), check_size, check_size, Point(x, y), FeatureTracking::uchar_normalize_table, signature);
+
+				Point table_location, local_location;
+				const float table_correlation = track_template(image.frame, Point(x, y), signature, table_location);
+				const float local_correlation = track_template(local_frame, Point(x, y), signature, local_location);
+				if(table_location.x != local_location.x || table_location.y != local_location.y || table_correlation != local_correlation) {
+					printf("  seed %llu at (%u, %u) tables find (%u, %u) correlating %g, local sums (%u, %u) correlating %g\n",
+						seed, x, y, table_location.x, table_location.y, table_correlation, local_location.x, local_location.y, local_correlation);
+					passed = false;
+				}
+			}
+		}
+	}
+	return report("local window sums", passed);
+}
+
+/* Three rows of cols+2 pixels, pattern 0 is random, the others push the
+gradients to their limits with 0 and 255: a dark row above a bright one,
+alternating pairs of dark and bright columns, and random 0 or 255 pixels */
+static void sobel_rows(uint pattern, uint cols, unsigned long long seed, std::vector<uchar> *rows) {
+	for(uint r=0; r<3; ++r) {
+		rows[r].resize(cols + 2);
+		for(uint x=0; x<cols+2; ++x) {
+			const unsigned long long random = mix(seed + (r * 4099) + x);
+			switch(pattern) {
+				case 0: rows[r][x] = (uchar)(random >> 56); break;
+				case 1: rows[r][x] = r == 0 ? 0 : r == 2 ? 255 : (x & 1) ? 255 : 0; break;
+				case 2: rows[r][x] = (x & 2) ? 255 : 0; break;
+				default: rows[r][x] = (random >> 63) ? 255 : 0; break;
+			}
+		}
+	}
+}
+
+/* Every vectorized Sobel row the processor supports matches the scalar row
+bit for bit, and writes nothing past cols */
+static bool check_sobel_simd() {
+	const SimdLevel supported = detect_simd_level();
+	if(supported == SIMD_SCALAR) {
+		printf("  no vector implementation is supported\n");
+		return report("sobel simd", true);
+	}
+
+	bool passed = true;
+	for(int level=SIMD_SSE41; level<=supported; ++level) {
+		const SobelRowFunction sobel_row = sobel_row_function((SimdLevel)level);
+		for(uint i=0; i<sizeof(sobel_check_cols)/sizeof(sobel_check_cols[0]); ++i) {
+			const uint cols = sobel_check_cols[i];
+			for(uint pattern=0; pattern<4; ++pattern) {
+				for(unsigned long long seed=300; seed<304; ++seed) {
+					std::vector<uchar> rows[3];
+					sobel_rows(pattern, cols, seed, rows);
+
+					std::vector<short> expected[3], actual[3];
+					for(uint j=0; j<3; ++j) {
+						expected[j].assign(cols + sobel_guard_cols, sobel_guard);
+						actual[j].assign(cols + sobel_guard_cols, sobel_guard);
+					}
+					sobel_row_scalar(rows[0].data(), rows[1].data(), rows[2].data(), cols, expected[0].data(), expected[1].data(), expected[2].data());
+					sobel_row(rows[0].data(), rows[1].data(), rows[2].data(), cols, actual[0].data(), actual[1].data(), actual[2].data());
+
+					for(uint j=0; j<3; ++j) {
+						for(uint x=0; x<cols+sobel_guard_cols; ++x) {
+							if(actual[j][x] != expected[j][x]) {
+								printf("  %s, %u columns, pattern %u, seed %llu: product %u at column %u is %d, scalar %d\n",
+									simd_level_name((SimdLevel)level), cols, pattern, seed, j, x, actual[j][x], expected[j][x]);
+								passed = false;
+								break;
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+	return report("sobel simd", passed);
+}
+
+bool run_kernel_checks() {
+	bool passed = true;
+	passed = check_flat_window() && passed;
+	passed = check_flat_template() && passed;
+	passed = check_bounds() && passed;
+	passed = check_local_sums() && passed;
+	passed = check_sobel_simd() && passed;
+	return passed;
+}
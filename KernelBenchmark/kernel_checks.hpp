@@ -0,0 +1,11 @@
+#pragma once
+#ifndef KERNEL_CHECKS_HPP
+#define KERNEL_CHECKS_HPP
+
+/* Checks of kernel results on inputs the benchmark images do not produce,
+such as flat search windows in the correlation search, and of the vector
+kernels against their scalar reference. Each check prints a PASS or FAIL
+line, returns false if any check fails */
+bool run_kernel_checks();
+
+#endif /* KERNEL_CHECKS_HPP */
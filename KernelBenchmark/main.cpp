@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "kernel_benchmark.hpp"
+#include "kernel_checks.hpp"
+
+static void print_usage() {
+	printf(
+		"Usage: KernelBenchmark [options]\n"
+		"  --sizes WxH,...         Image sizes (640x480,1024x768,1920x1080,3840x2160)\n"
+		"  --densities D,...       Fraction of textured cells per image (0.1,0.5,1)\n"
+		"  --kernel NAME           Only run kernels whose name starts with NAME\n"
+		"  --passes N              Minimum timed passes per kernel (5)\n"
+		"  --min-time-ms T         Minimum time per kernel in milliseconds (200)\n"
+		"  --format FORMAT         json or csv (json)\n"
+		"  --output FILE           Write the report to FILE, csv rows are appended\n"
+		"  --check                 Check kernel results on edge cases instead, exits 1 on failure\n"
+		"Times are the median pass. Cycles are read from the time stamp counter,\n"
+		"which runs at the base clock whatever the core's current frequency\n"
+	);
+}
+
+static bool parse_sizes(const std::string &value, std::vector<ImageSize> &sizes) {
+	sizes.clear();
+	size_t begin = 0;
+	while(begin < value.size()) {
+		size_t end = value.find(',', begin);
+		if(end == std::string::npos) {
+			end = value.size();
+		}
+
+		ImageSize size;
+		if(sscanf(value.substr(begin, end - begin).c_str(), "%ux%u", &size.cols, &size.rows) != 2) {
+			return false;
+		}
+		sizes.push_back(size);
+		begin = end + 1;
+	}
+	return !sizes.empty();
+}
+
+static bool parse_densities(const std::string &value, std::vector<double> &densities) {
+	densities.clear();
+	size_t begin = 0;
+	while(begin < value.size()) {
+		size_t end = value.find(',', begin);
+		if(end == std::string::npos) {
+			end = value.size();
+		}
+
+		const double density = atof(value.substr(begin, end - begin).c_str());
+		if(density < 0 || density > 1) {
+			return false;
+		}
+		densities.push_back(density);
+		begin = end + 1;
+	}
+	return !densities.empty();
+}
+
+int main(int argc, char **argv) {
+	KernelBenchmarkSettings settings;
+
+	for(int i=1; i<argc; ++i) {
+		const std::string option = argv[i];
+		if(option == "--check") {
+			return run_kernel_checks() ? 0 : 1;
+		}
+		if(option == "--help" || i + 1 >= argc) {
+			print_usage();
+			return option == "--help" ? 0 : 1;
+		}
+
+		const std::string value = argv[++i];
+		if(option == "--sizes" && parse_sizes(value, settings.sizes)) {
+			continue;
+		} else if(option == "--densities" && parse_densities(value, settings.densities)) {
+			continue;
+		} else if(option == "--kernel") {
+			settings.kernel = value;
+		} else if(option == "--passes") {
+			settings.min_passes = (uint)atoi(value.c_str());
+		} else if(option == "--min-time-ms") {
+			settings.min_time_ms = atof(value.c_str());
+		} else if(option == "--format" && (value == "json" || value == "csv")) {
+			settings.format = value == "csv" ? REPORT_CSV : REPORT_JSON;
+		} else if(option == "--output") {
+			settings.output_path = value;
+		} else {
+			print_usage();
+			return 1;
+		}
+	}
+
+	KernelBenchmark benchmark(settings);
+	return benchmark.run() ? 0 : 1;
+}
@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+
+#include "mock_pangu_server.hpp"
+
+static void print_usage() {
+	printf(
+		"Usage: MockPangu [options]\n"
+		"  --port N             Port to listen on (10363)\n"
+		"  --frames DIR         Serve the PGM files in DIR in name order\n"
+		"  --pack FILE          Serve images from a frame cache pack by viewpoint\n"
+		"  --scene SCENE        Generate blocks, craters or stars for viewpoints without a frame (blocks)\n"
+		"  --seed N             Seed the craters and stars are generated from (1)\n"
+		"  --render-threads N   Threads rendering craters and stars, 0 for one per hardware thread (0)\n"
+		"  --scene-tag TAG      Scene tag the pack was recorded with\n"
+		"  --size WxH           Camera size (1024x768), taken from the files with --frames\n"
+		"  --fov H,V            Camera field of view in degrees (30,30)\n"
+		"  --latency-ms MS      Render time of each image (0)\n"
+		"  --bandwidth-mbps MB  Link speed in megabits per second, 0 for unlimited (0)\n"
+	);
+}
+
+int main(int argc, char **argv) {
+	MockPanguSettings settings;
+
+	for(int i=1; i<argc; ++i) {
+		const std::string option = argv[i];
+		if(option == "--help" || i + 1 >= argc) {
+			print_usage();
+			return option == "--help" ? 0 : 1;
+		}
+
+		const char *value = argv[++i];
+		if(option == "--port") {
+			settings.port = (ushort)atoi(value);
+		} else if(option == "--frames") {
+			settings.frame_directory = value;
+		} else if(option == "--pack") {
+			settings.pack_path = value;
+		} else if(option == "--scene" && (!strcmp(value, "blocks") || !strcmp(value, "craters") || !strcmp(value, "stars"))) {
+			settings.synthetic = strcmp(value, "blocks") != 0;
+			settings.scene_type = !strcmp(value, "stars") ? SCENE_STARS : SCENE_CRATERS;
+		} else if(option == "--seed") {
+			settings.seed = strtoull(value, nullptr, 10);
+		} else if(option == "--render-threads") {
+			settings.render_threads = (uint)atoi(value);
+		} else if(option == "--scene-tag") {
+			settings.scene_tag = value;
+		} else if(option == "--size") {
+			if(sscanf(value, "%lux%lu", &settings.image_width, &settings.image_height) != 2) {
+				print_usage();
+				return 1;
+			}
+		} else if(option == "--fov") {
+			double horizontal, vertical;
+			if(sscanf(value, "%lf,%lf", &horizontal, &vertical) != 2) {
+				print_usage();
+				return 1;
+			}
+			settings.horizontal_fov = horizontal * 3.14159265358979323846 / 180.0;
+			settings.vertical_fov = vertical * 3.14159265358979323846 / 180.0;
+		} else if(option == "--latency-ms") {
+			settings.render_latency_ms = atof(value);
+		} else if(option == "--bandwidth-mbps") {
+			settings.bandwidth_mbps = atof(value);
+		} else {
+			print_usage();
+			return 1;
+		}
+	}
+
+#ifdef _WIN32
+	WSAData wsaData;
+	if(WSAStartup(MAKEWORD(2, 2), &wsaData)) {
+		printf("Failed to initialise winsock\n");
+		return 1;
+	}
+#endif
+
+	MockPanguServer server(settings);
+	return server.run() ? 0 : 1;
+}
@@ -0,0 +1,348 @@
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <dirent.h>
+#define INVALID_SOCKET (-1)
+#endif
+
+#include "mock_pangu_server.hpp"
+
+MockPanguServer::MockPanguServer(const MockPanguSettings &settings) :
+	settings(settings),
+	next_frame(0),
+	pack_miss_reported(false),
+	scene(nullptr),
+	link_free(std::chrono::steady_clock::now())
+{
+	/* Empty */
+}
+
+MockPanguServer::~MockPanguServer() {
+	pack.close();
+	delete scene;
+}
+
+bool MockPanguServer::run() {
+	if(!load_frames()) {
+		return false;
+	}
+
+	if(settings.synthetic) {
+		SceneCamera camera;
+		camera.cols = settings.image_width;
+		camera.rows = settings.image_height;
+		camera.horizontal_fov = settings.horizontal_fov;
+		camera.vertical_fov = settings.vertical_fov;
+		scene = new SyntheticScene(settings.scene_type, camera, settings.render_threads, settings.seed);
+	}
+
+	SOCKET listen_sock = socket(AF_INET, SOCK_STREAM, 0);
+	if(listen_sock == INVALID_SOCKET) {
+		printf("Failed to create socket\n");
+		return false;
+	}
+
+	int reuse = 1;
+	setsockopt(listen_sock, SOL_SOCKET, SO_REUSEADDR, (const char *)&reuse, sizeof(reuse));
+
+	struct sockaddr_in sock_addr;
+	memset(&sock_addr, 0, sizeof(sock_addr));
+	sock_addr.sin_family = AF_INET;
+	sock_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	sock_addr.sin_port = htons(settings.port);
+	if(bind(listen_sock, (struct sockaddr *)&sock_addr, sizeof(sock_addr)) != 0 || listen(listen_sock, 16) != 0) {
+		printf("Failed to listen on port %u\n", settings.port);
+		SOCKET_CLOSE(listen_sock);
+		return false;
+	}
+
+	printf("Mock PANGU server listening on port %u, %lux%lu images\n", settings.port, settings.image_width, settings.image_height);
+	fflush(stdout);
+
+	for(;;) {
+		SOCKET sock = accept(listen_sock, NULL, NULL);
+		if(sock == INVALID_SOCKET) {
+			continue;
+		}
+		std::thread(&MockPanguServer::serve_client, this, sock).detach();
+	}
+}
+
+bool MockPanguServer::load_frames() {
+	if(!settings.pack_path.empty()) {
+		return pack.open(settings.pack_path);
+	}
+
+	if(settings.frame_directory.empty()) {
+		return true;
+	}
+
+	const std::vector<std::string> files = list_frame_files(settings.frame_directory);
+	for(size_t i=0; i<files.size(); ++i) {
+		std::ifstream file(files[i], std::ios::binary);
+		frames.push_back(std::vector<uchar>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+	}
+
+	if(frames.empty()) {
+		printf("No PGM files in %s\n", settings.frame_directory.c_str());
+		return false;
+	}
+
+	/* Report the size of the recorded frames rather than the configured one */
+	unsigned long width = 0;
+	unsigned long height = 0;
+	const std::string header(frames[0].begin(), frames[0].begin() + std::min<size_t>(frames[0].size(), 64));
+	if(sscanf(header.c_str(), "P5 %lu %lu", &width, &height) == 2) {
+		settings.image_width = width;
+		settings.image_height = height;
+	}
+	return true;
+}
+
+void MockPanguServer::serve_client(SOCKET sock) {
+	/* Image replies are written in pieces, so stop Nagle holding back the last of each */
+	pan_socket_set_nodelay(sock);
+
+	/* The session starts with the protocol version the client wants */
+	unsigned long version;
+	if(pan_socket_read_ulong(sock, &version) != 4) {
+		SOCKET_CLOSE(sock);
+		return;
+	}
+	pan_socket_write_ulong(sock, MSG_OKAY);
+
+	double viewpoint[6] = {0, 0, 0, 0, 0, 0};
+	std::vector<uchar> image;
+	bool connected = true;
+	while(connected) {
+		unsigned long message;
+		if(pan_socket_read_ulong(sock, &message) != 4) {
+			break;
+		}
+
+		switch(message) {
+		case MSG_GOODBYE:
+		case MSG_QUIT:
+			connected = false;
+			break;
+		case MSG_GET_CAMERA_PROPERTIES: {
+			unsigned long camera_id;
+			connected = pan_socket_read_ulong(sock, &camera_id) == 4;
+			if(connected) {
+				send_camera_properties(sock, camera_id, viewpoint);
+			}
+			break;
+		}
+		case MSG_GET_IMAGE:
+			connected = send_image(sock, viewpoint, image);
+			break;
+		case MSG_SET_VIEWPOINT_BY_DEGREES_D:
+			connected = read_viewpoint(sock, viewpoint);
+			if(connected) {
+				pan_socket_write_ulong(sock, MSG_OKAY);
+			}
+			break;
+		case MSG_GET_VIEWPOINT_BY_DEGREES_D:
+			connected = read_viewpoint(sock, viewpoint) && send_image(sock, viewpoint, image);
+			break;
+		default: {
+			/* The message's arguments cannot be skipped without knowing its layout */
+			char error[64];
+			sprintf(error, "Message %lu is not supported by the mock server", message);
+			send_error(sock, error);
+			connected = false;
+			break;
+		}
+		}
+	}
+
+	SOCKET_CLOSE(sock);
+}
+
+void MockPanguServer::send_camera_properties(SOCKET sock, ulong camera_id, const double *viewpoint) {
+	/* Message code, reply size, width and height then 9 doubles */
+	char buf[4 + 4 + 2*4 + 9*8];
+	char *p = buf;
+	p = pan_socket_poke_ulong(p, MSG_CAMERA_PROPERTIES);
+	if(camera_id != 0) {
+		/* A size of 0 marks an invalid camera */
+		p = pan_socket_poke_ulong(p, 0);
+		pan_socket_write(sock, buf, p - buf);
+		return;
+	}
+
+	p = pan_socket_poke_ulong(p, 2*4 + 9*8);
+	p = pan_socket_poke_ulong(p, settings.image_width);
+	p = pan_socket_poke_ulong(p, settings.image_height);
+	p = pan_socket_poke_double(p, settings.horizontal_fov);
+	p = pan_socket_poke_double(p, settings.vertical_fov);
+	p = pan_socket_poke_double(p, viewpoint[0]);
+	p = pan_socket_poke_double(p, viewpoint[1]);
+	p = pan_socket_poke_double(p, viewpoint[2]);
+	p = pan_socket_poke_double(p, 1);
+	p = pan_socket_poke_double(p, 0);
+	p = pan_socket_poke_double(p, 0);
+	p = pan_socket_poke_double(p, 0);
+	pan_socket_write(sock, buf, p - buf);
+}
+
+bool MockPanguServer::send_image(SOCKET sock, const double *viewpoint, std::vector<uchar> &image) {
+	const uchar *data = nullptr;
+	size_t size = 0;
+	{
+		/* One image is rendered at a time however many clients are connected */
+		std::lock_guard<std::mutex> guard(render_lock);
+		if(settings.render_latency_ms > 0) {
+			std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(settings.render_latency_ms));
+		}
+
+		if(pack.is_open()) {
+			const unsigned long long key = FrameCache::image_key(
+				viewpoint,
+				settings.image_width, settings.image_height,
+				settings.horizontal_fov, settings.vertical_fov,
+				settings.scene_tag
+			);
+			data = pack.find(key, size);
+			if(!data && !pack_miss_reported.exchange(true)) {
+				printf("Viewpoint (%g, %g, %g) is not in the pack, generating images for missing viewpoints\n", viewpoint[0], viewpoint[1], viewpoint[2]);
+				fflush(stdout);
+			}
+		}
+
+		if(!data && !frames.empty()) {
+			const std::vector<uchar> &frame = frames[next_frame++ % frames.size()];
+			data = frame.data();
+			size = frame.size();
+		} else if(!data) {
+			render(viewpoint, image);
+			data = image.data();
+			size = image.size();
+		}
+	}
+
+	char header[4 + 4];
+	char *p = header;
+	p = pan_socket_poke_ulong(p, MSG_IMAGE);
+	p = pan_socket_poke_ulong(p, (unsigned long)size);
+	return send_throttled(sock, (const uchar *)header, p - header) && send_throttled(sock, data, size);
+}
+
+void MockPanguServer::send_error(SOCKET sock, const char *message) {
+	/* Message code, error code then the padded string */
+	pan_socket_msg reply;
+	pan_socket_msg_init(&reply, sock);
+	char *p = pan_socket_msg_reserve(&reply, 4 + 4 + 2 + strlen(message) + 2);
+	if(p) {
+		p = pan_socket_poke_ulong(p, MSG_ERROR);
+		p = pan_socket_poke_long(p, 1);
+		p = pan_socket_poke_string(p, (char *)message);
+		pan_socket_msg_commit(&reply, p);
+		pan_socket_msg_flush(&reply);
+	}
+	pan_socket_msg_free(&reply);
+}
+
+void MockPanguServer::render(const double *viewpoint, std::vector<uchar> &image) {
+	const uint cols = settings.image_width;
+	const uint rows = settings.image_height;
+
+	char header[64];
+	const int header_size = sprintf(header, "P5\n%u %u 255\n", cols, rows);
+	image.resize(header_size + cols * rows);
+	memcpy(image.data(), header, header_size);
+
+	uchar *pixels = image.data() + header_size;
+	if(scene) {
+		scene->render(PanguStep(viewpoint[0], viewpoint[1], viewpoint[2], viewpoint[3], viewpoint[4], viewpoint[5]), pixels);
+		return;
+	}
+
+	/* Blocks of random brightness which slide with the camera's x and y, so
+	trackers find corners and can follow them between frames */
+	const long long offset_x = (long long)viewpoint[0];
+	const long long offset_y = (long long)viewpoint[1];
+	for(uint j=0; j<rows; ++j) {
+		const unsigned long long block_y = (unsigned long long)((j + offset_y) >> 4);
+		for(uint i=0; i<cols; ++i) {
+			const unsigned long long block_x = (unsigned long long)((i + offset_x) >> 4);
+			unsigned long long h = (block_x * 0x9E3779B97F4A7C15ULL) ^ (block_y * 0xC2B2AE3D27D4EB4FULL);
+			h ^= h >> 29;
+			pixels[j * cols + i] = (uchar)(h * 0xBF58476D1CE4E5B9ULL >> 56);
+		}
+	}
+}
+
+bool MockPanguServer::send_throttled(SOCKET sock, const uchar *data, size_t size) {
+	if(settings.bandwidth_mbps <= 0) {
+		return pan_socket_write(sock, (void *)data, size) == (int)size;
+	}
+
+	/* Send in chunks so connections share the link rather than taking turns with whole images */
+	const size_t chunk_size = 64 * 1024;
+	for(size_t sent=0; sent<size; sent+=chunk_size) {
+		const size_t count = std::min(chunk_size, size - sent);
+		wait_for_link(count);
+		if(pan_socket_write(sock, (void *)(data + sent), count) != (int)count) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void MockPanguServer::wait_for_link(size_t size) {
+	/* Book the next free slot on the link and wait until it has passed */
+	const std::chrono::duration<double> transfer_time(size * 8 / (settings.bandwidth_mbps * 1e6));
+	std::chrono::steady_clock::time_point done;
+	{
+		std::lock_guard<std::mutex> guard(link_lock);
+		link_free = std::max(link_free, std::chrono::steady_clock::now());
+		link_free += std::chrono::duration_cast<std::chrono::steady_clock::duration>(transfer_time);
+		done = link_free;
+	}
+	std::this_thread::sleep_until(done);
+}
+
+bool MockPanguServer::read_viewpoint(SOCKET sock, double *viewpoint) {
+	for(uint i=0; i<6; ++i) {
+		if(pan_socket_read_double(sock, &viewpoint[i]) != 8) {
+			return false;
+		}
+	}
+	return true;
+}
+
+std::vector<std::string> MockPanguServer::list_frame_files(const std::string &directory) {
+	std::vector<std::string> files;
+#ifdef _WIN32
+	WIN32_FIND_DATAA find_data;
+	HANDLE find = FindFirstFileA((directory + "\\*.pgm").c_str(), &find_data);
+	if(find != INVALID_HANDLE_VALUE) {
+		do {
+			files.push_back(directory + "\\" + find_data.cFileName);
+		} while(FindNextFileA(find, &find_data));
+		FindClose(find);
+	}
+#else
+	DIR *dir = opendir(directory.c_str());
+	if(dir) {
+		while(struct dirent *entry = readdir(dir)) {
+			const std::string name = entry->d_name;
+			if(name.size() > 4 && name.compare(name.size() - 4, 4, ".pgm") == 0) {
+				files.push_back(directory + "/" + name);
+			}
+		}
+		closedir(dir);
+	}
+#endif
+
+	/* Served in name order, so number the frames of a recorded flight */
+	std::sort(files.begin(), files.end());
+	return files;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#ifndef MOCK_PANGU_SERVER_HPP
+#define MOCK_PANGU_SERVER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Pangu/pan_protocol_lib.h"
+#include "Pangu/frame_cache.hpp"
+#include "Pangu/synthetic_scene.hpp"
+#include "Utils/types.hpp"
+
+struct MockPanguSettings {
+	ushort port;
+	/* Frames come from a directory of PGM files served in request order, from
+	a frame cache pack looked up by viewpoint or, when neither is set or the
+	viewpoint is not in the pack, are generated from the viewpoint */
+	std::string frame_directory;
+	std::string pack_path;
+	/* Generated images are blocks sliding with the camera's x and y, or when
+	synthetic the view from the viewpoint of a SyntheticScene of scene_type,
+	rendered on render_threads threads */
+	bool synthetic;
+	SceneType scene_type;
+	unsigned long long seed;
+	uint render_threads;
+	/* Camera reported to clients, pack lookups use it and scene_tag to
+	build the same keys as PanguServer */
+	std::string scene_tag;
+	ulong image_width;
+	ulong image_height;
+	double horizontal_fov;
+	double vertical_fov;
+	/* Time spent rendering each image. One mock renders one image at a
+	time like a real server, run several mocks to emulate several servers */
+	double render_latency_ms;
+	/* Speed of the link shared by every connection, 0 for unlimited */
+	double bandwidth_mbps;
+
+	MockPanguSettings() {
+		port = 10363;
+		synthetic = false;
+		scene_type = SCENE_CRATERS;
+		seed = 1;
+		render_threads = 0;
+		image_width = 1024;
+		image_height = 768;
+		horizontal_fov = 0.5235987756;
+		vertical_fov = 0.5235987756;
+		render_latency_ms = 0;
+		bandwidth_mbps = 0;
+	}
+};
+
+/* Stand-in for a PANGU server implementing the messages PanguServer uses:
+start, Goodbye, GetCameraProperties, GetImage, SetViewpointByDegreesD and
+GetViewpointByDegreesD. Any other message is answered with an error and
+the connection is closed */
+class MockPanguServer {
+public:
+	MockPanguServer(const MockPanguSettings &settings);
+	~MockPanguServer();
+
+	/* Load the frames and serve clients, each on its own thread, until the
+	process ends. Returns false if the frames or the port cannot be used */
+	bool run();
+
+private:
+	MockPanguSettings settings;
+	std::vector<std::vector<uchar>> frames;
+	std::atomic<ulong> next_frame;
+	FrameCache pack;
+	std::atomic<bool> pack_miss_reported;
+	SyntheticScene *scene;
+
+	std::mutex render_lock;
+	std::mutex link_lock;
+	std::chrono::steady_clock::time_point link_free;
+
+	bool load_frames();
+	void serve_client(SOCKET sock);
+	void send_camera_properties(SOCKET sock, ulong camera_id, const double *viewpoint);
+	bool send_image(SOCKET sock, const double *viewpoint, std::vector<uchar> &image);
+	void send_error(SOCKET sock, const char *message);
+	void render(const double *viewpoint, std::vector<uchar> &image);
+	bool send_throttled(SOCKET sock, const uchar *data, size_t size);
+	void wait_for_link(size_t size);
+	static bool read_viewpoint(SOCKET sock, double *viewpoint);
+	static std::vector<std::string> list_frame_files(const std::string &directory);
+};
+
+#endif /* MOCK_PANGU_SERVER_HPP */
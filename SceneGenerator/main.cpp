@@ -0,0 +1,74 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "scene_generator.hpp"
+
+static void print_usage() {
+	printf(
+		"Usage: SceneGenerator [options]\n"
+		"  --scene SCENE           craters or stars (craters)\n"
+		"  --seed N                Seed the scene is generated from (1)\n"
+		"  --size WxH              Image size (1024x768)\n"
+		"  --fov H,V               Camera field of view in degrees (30,30)\n"
+		"  --threads N             Render threads, 0 for one per hardware thread (0)\n"
+		"  --flight FILE           Render the steps of a PANGU flight file\n"
+		"  --count N               Steps of the built in flight rendered without --flight (200)\n"
+		"  --output DIR            Write f00000.pgm..., flight.fli and truth.csv to DIR\n"
+		"  --pack FILE             Add the images to a frame cache pack\n"
+		"  --scene-tag TAG         Scene tag the pack is keyed with (synthetic-SCENE-SEED)\n"
+		"  --truth-spacing N       Grid spacing of the ground truth points, 0 for none (32)\n"
+	);
+}
+
+int main(int argc, char **argv) {
+	SceneGeneratorSettings settings;
+
+	for(int i=1; i<argc; ++i) {
+		const std::string option = argv[i];
+		if(option == "--help" || i + 1 >= argc) {
+			print_usage();
+			return option == "--help" ? 0 : 1;
+		}
+
+		const std::string value = argv[++i];
+		if(option == "--scene" && (value == "craters" || value == "stars")) {
+			settings.scene_type = value == "stars" ? SCENE_STARS : SCENE_CRATERS;
+		} else if(option == "--seed") {
+			settings.seed = strtoull(value.c_str(), nullptr, 10);
+		} else if(option == "--size") {
+			if(sscanf(value.c_str(), "%ux%u", &settings.camera.cols, &settings.camera.rows) != 2 || settings.camera.cols == 0 || settings.camera.rows == 0) {
+				print_usage();
+				return 1;
+			}
+		} else if(option == "--fov") {
+			double horizontal, vertical;
+			if(sscanf(value.c_str(), "%lf,%lf", &horizontal, &vertical) != 2) {
+				print_usage();
+				return 1;
+			}
+			settings.camera.horizontal_fov = horizontal * 3.14159265358979323846 / 180.0;
+			settings.camera.vertical_fov = vertical * 3.14159265358979323846 / 180.0;
+		} else if(option == "--threads") {
+			settings.num_threads = (uint)atoi(value.c_str());
+		} else if(option == "--flight") {
+			settings.flight_path = value;
+		} else if(option == "--count") {
+			settings.frames = (uint)atoi(value.c_str());
+		} else if(option == "--output") {
+			settings.output_directory = value;
+		} else if(option == "--pack") {
+			settings.pack_path = value;
+		} else if(option == "--scene-tag") {
+			settings.scene_tag = value;
+		} else if(option == "--truth-spacing") {
+			settings.truth_spacing = (uint)atoi(value.c_str());
+		} else {
+			print_usage();
+			return 1;
+		}
+	}
+
+	SceneGenerator generator(settings);
+	return generator.run() ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "scene_generator.hpp"
+#include "Pangu/frame_cache.hpp"
+
+SceneGenerator::SceneGenerator(const SceneGeneratorSettings &settings) :
+	settings(settings)
+{
+	/* Empty */
+}
+
+bool SceneGenerator::run() {
+	if(settings.output_directory.empty() && settings.pack_path.empty()) {
+		fprintf(stderr, "Nothing to write, give an output directory or a pack\n");
+		return false;
+	}
+
+	if(settings.flight_path.empty()) {
+		steps = synthetic_flight(settings.scene_type, settings.frames);
+	} else {
+		steps = read_pangu_steps(settings.flight_path);
+		if(steps.empty()) {
+			fprintf(stderr, "No steps in %s\n", settings.flight_path.c_str());
+			return false;
+		}
+	}
+
+	std::string scene_tag = settings.scene_tag;
+	if(scene_tag.empty()) {
+		scene_tag = std::string("synthetic-") + scene_type_name(settings.scene_type) + "-" + std::to_string(settings.seed);
+	}
+
+	FrameCache pack;
+	if(!settings.pack_path.empty() && !pack.open(settings.pack_path)) {
+		fprintf(stderr, "Failed to open %s\n", settings.pack_path.c_str());
+		return false;
+	}
+
+	FILE *truth = nullptr;
+	if(!settings.output_directory.empty()) {
+		if(!write_flight()) {
+			return false;
+		}
+		if(settings.truth_spacing) {
+			truth = fopen(output_file("truth.csv").c_str(), "wb");
+			if(!truth) {
+				fprintf(stderr, "Failed to open %s\n", output_file("truth.csv").c_str());
+				return false;
+			}
+			fprintf(truth, "frame,x,y,next_x,next_y\n");
+		}
+	}
+
+	/* Images are PGM files as PANGU sends them, header included */
+	const SceneCamera &camera = settings.camera;
+	char header[64];
+	const int header_size = sprintf(header, "P5\n%u %u 255\n", camera.cols, camera.rows);
+	std::vector<uchar> image(header_size + ((size_t)camera.cols * camera.rows));
+	memcpy(image.data(), header, header_size);
+
+	SyntheticScene scene(settings.scene_type, camera, settings.num_threads, settings.seed);
+	bool written = true;
+	for(uint i=0; i<steps.size() && written; ++i) {
+		scene.render(steps[i], image.data() + header_size);
+
+		if(!settings.output_directory.empty()) {
+			written = write_frame(i, image);
+		}
+		if(pack.is_open()) {
+			const PanguStep &step = steps[i];
+			const double viewpoint[6] = {step.x, step.y, step.z, step.yaw, step.pitch, step.roll};
+			pack.write(FrameCache::image_key(viewpoint, camera.cols, camera.rows, camera.horizontal_fov, camera.vertical_fov, scene_tag), image.data(), image.size());
+		}
+		if(truth && i + 1 < steps.size()) {
+			write_truth(truth, scene, i);
+		}
+	}
+
+	if(truth) {
+		written = !ferror(truth) && written;
+		fclose(truth);
+	}
+	pack.close();
+
+	if(written) {
+		printf("Rendered %zu %s frames at %ux%u, scene tag %s\n", steps.size(), scene_type_name(settings.scene_type), camera.cols, camera.rows, scene_tag.c_str());
+	}
+	return written;
+}
+
+bool SceneGenerator::write_flight() const {
+	const std::string path = output_file("flight.fli");
+	FILE *file = fopen(path.c_str(), "wb");
+	if(!file) {
+		fprintf(stderr, "Failed to open %s\n", path.c_str());
+		return false;
+	}
+
+	/* Written with enough digits to read back the exact doubles, so the
+	Gui flying this file looks up the images in the pack */
+	fprintf(file, "view craft\n");
+	for(size_t i=0; i<steps.size(); ++i) {
+		const PanguStep &step = steps[i];
+		fprintf(file, "start %.17g %.17g %.17g %.17g %.17g %.17g\n", step.x, step.y, step.z, step.yaw, step.pitch, step.roll);
+	}
+
+	const bool written = !ferror(file);
+	fclose(file);
+	return written;
+}
+
+bool SceneGenerator::write_frame(uint frame, const std::vector<uchar> &image) const {
+	char name[32];
+	sprintf(name, "f%05u.pgm", frame);
+	const std::string path = output_file(name);
+
+	FILE *file = fopen(path.c_str(), "wb");
+	if(!file) {
+		fprintf(stderr, "Failed to open %s\n", path.c_str());
+		return false;
+	}
+
+	const bool written = fwrite(image.data(), 1, image.size(), file) == image.size();
+	fclose(file);
+	if(!written) {
+		fprintf(stderr, "Failed to write %s\n", path.c_str());
+	}
+	return written;
+}
+
+void SceneGenerator::write_truth(FILE *file, const SyntheticScene &scene, uint frame) const {
+	const SceneCamera &camera = settings.camera;
+	const uint spacing = settings.truth_spacing;
+	for(uint y=spacing/2; y<camera.rows; y+=spacing) {
+		for(uint x=spacing/2; x<camera.cols; x+=spacing) {
+			double next_x, next_y;
+			if(scene.displace(steps[frame], steps[frame + 1], x, y, next_x, next_y)) {
+				fprintf(file, "%u,%u,%u,%.4f,%.4f\n", frame, x, y, next_x, next_y);
+			}
+		}
+	}
+}
+
+std::string SceneGenerator::output_file(const std::string &name) const {
+	const char last = settings.output_directory[settings.output_directory.size() - 1];
+	if(last == '/' || last == '\\') {
+		return settings.output_directory + name;
+	}
+	return settings.output_directory + "/" + name;
+}
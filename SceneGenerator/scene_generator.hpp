@@ -0,0 +1,66 @@
+#pragma once
+#ifndef SCENE_GENERATOR_HPP
+#define SCENE_GENERATOR_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "Pangu/pangu_step.hpp"
+#include "Pangu/synthetic_scene.hpp"
+#include "Utils/types.hpp"
+
+struct SceneGeneratorSettings {
+	SceneType scene_type;
+	unsigned long long seed;
+	SceneCamera camera;
+	/* Render threads, 0 for one per hardware thread */
+	uint num_threads;
+	/* Steps come from a PANGU flight file when given, otherwise frames steps
+	of synthetic_flight are rendered */
+	std::string flight_path;
+	uint frames;
+	/* Directory the PGM frames, their flight file and the ground truth are
+	written to, it has to exist */
+	std::string output_directory;
+	/* Frame cache pack the images are added to, keyed as PanguServer keys
+	them so the Gui and MockPangu replay it. An empty scene_tag becomes
+	synthetic-<scene>-<seed> */
+	std::string pack_path;
+	std::string scene_tag;
+	/* Spacing in pixels of the grid of image points whose motion to the next
+	frame is written to the ground truth, 0 writes none */
+	uint truth_spacing;
+
+	SceneGeneratorSettings() {
+		scene_type = SCENE_CRATERS;
+		seed = 1;
+		num_threads = 0;
+		frames = 200;
+		truth_spacing = 32;
+	}
+};
+
+/* Renders a flight through a SyntheticScene to PGM files and a frame cache
+pack, so the trackers and the Gui can be run on repeatable frames without a
+PANGU server. truth.csv holds where grid points of each frame are in the
+next, as frame,x,y,next_x,next_y */
+class SceneGenerator {
+public:
+	SceneGenerator(const SceneGeneratorSettings &settings);
+
+	/* Render every step and write the outputs. Returns false if the flight
+	cannot be read or an output cannot be written */
+	bool run();
+
+private:
+	SceneGeneratorSettings settings;
+	std::vector<PanguStep> steps;
+
+	bool write_flight() const;
+	bool write_frame(uint frame, const std::vector<uchar> &image) const;
+	void write_truth(FILE *file, const SyntheticScene &scene, uint frame) const;
+	std::string output_file(const std::string &name) const;
+};
+
+#endif /* SCENE_GENERATOR_HPP */
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "tracking_benchmark.hpp"
+
+static void print_usage() {
+	printf(
+		"Usage: TrackingBenchmark [options]\n"
+		"  --frames DIR            Track the 1024x768 PGM files in DIR in name order\n"
+		"  --pack FILE             Track the images of a frame cache pack in recorded order\n"
+		"  --synthetic SCENE       Track frames rendered of craters or stars, and their accuracy\n"
+		"  --pangu HOST:PORT,...   Track frames acquired from PANGU servers or MockPangu along --flight\n"
+		"  --connections N         Connections acquiring from PANGU, shared round robin by the servers (1)\n"
+		"  --flight FILE           Fly the synthetic scene or PANGU along a PANGU flight file\n"
+		"  --seed N                Seed the synthetic scene is generated from (1)\n"
+		"  --engine NAME           cpu or stream (cpu)\n"
+		"  --warmup N              Frames tracked before timing starts (10)\n"
+		"  --count N               Frames timed, the sequence repeats if shorter (200)\n"
+		"  --threads N             Tracking threads, 0 for one per hardware thread (0)\n"
+		"  --suppression MODE      greedy or dense, dense only with the cpu engine (greedy)\n"
+		"  --max-features N        Maximum tracked features (200)\n"
+		"  --harris-threshold T    Harris response threshold (1000000)\n"
+		"  --format FORMAT         json or csv (json)\n"
+		"  --output FILE           Write the report to FILE, csv rows are appended\n"
+	);
+}
+
+int main(int argc, char **argv) {
+	TrackingBenchmarkSettings settings;
+
+	for(int i=1; i<argc; ++i) {
+		const std::string option = argv[i];
+		if(option == "--help" || i + 1 >= argc) {
+			print_usage();
+			return option == "--help" ? 0 : 1;
+		}
+
+		const std::string value = argv[++i];
+		if(option == "--frames") {
+			settings.frame_directory = value;
+		} else if(option == "--pack") {
+			settings.pack_path = value;
+		} else if(option == "--synthetic" && (value == "craters" || value == "stars")) {
+			settings.synthetic = true;
+			settings.scene_type = value == "stars" ? SCENE_STARS : SCENE_CRATERS;
+		} else if(option == "--pangu") {
+			if(!parse_pangu_endpoints(value, settings.pangu_endpoints)) {
+				print_usage();
+				return 1;
+			}
+		} else if(option == "--connections") {
+			settings.pangu_connections = (uint)atoi(value.c_str());
+		} else if(option == "--flight") {
+			settings.flight_path = value;
+		} else if(option == "--seed") {
+			settings.seed = strtoull(value.c_str(), nullptr, 10);
+		} else if(option == "--engine") {
+			settings.engine = value;
+		} else if(option == "--warmup") {
+			settings.warmup_frames = (uint)atoi(value.c_str());
+		} else if(option == "--count") {
+			settings.frames = (uint)atoi(value.c_str());
+		} else if(option == "--threads") {
+			settings.tracking.num_threads = (uint)atoi(value.c_str());
+		} else if(option == "--suppression" && (value == "greedy" || value == "dense")) {
+			settings.tracking.suppression_mode = value == "dense" ? SUPPRESSION_DENSE : SUPPRESSION_GREEDY;
+		} else if(option == "--max-features") {
+			settings.tracking.max_tracked_features = (uint)atoi(value.c_str());
+		} else if(option == "--harris-threshold") {
+			settings.tracking.harris_response_threshhold = (float)atof(value.c_str());
+		} else if(option == "--format" && (value == "json" || value == "csv")) {
+			settings.format = value == "csv" ? REPORT_CSV : REPORT_JSON;
+		} else if(option == "--output") {
+			settings.output_path = value;
+		} else {
+			print_usage();
+			return 1;
+		}
+	}
+
+	if(!settings.pangu_endpoints.empty() && settings.flight_path.empty()) {
+		fprintf(stderr, "--pangu needs a --flight to request viewpoints along\n");
+		return 1;
+	}
+
+	TrackingBenchmark benchmark(settings);
+	return benchmark.run() ? 0 : 1;
+}
@@ -0,0 +1,420 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <stdio.h>
+
+#include "tracking_benchmark.hpp"
+#include "Pangu/frame_sequence.hpp"
+#include "Pangu/pangu_server.hpp"
+#include "Tracking/feature_store.hpp"
+#include "Tracking/Cpu/feature_tracking_cpu.hpp"
+#include "Tracking/Cpu/feature_tracking_stream.hpp"
+#include "Utils/cpu_features.hpp"
+
+struct Summary {
+	uint threads;
+	double mean_ms;
+	double p50_ms;
+	double p95_ms;
+	double p99_ms;
+	double max_ms;
+	double frames_per_second;
+	double features_per_frame;
+	double tracked_per_frame;
+	/* Means of the engine's own stats, all 0 when built without them */
+	double stage_ms[NUM_TRACKING_STAGES];
+	double candidates_per_frame;
+	double suppressed_per_frame;
+	double lost_per_frame;
+	double added_per_frame;
+	/* Synthetic frames only, over every feature tracked into a frame */
+	double mean_error_px;
+	double p95_error_px;
+	double within_1px;
+};
+
+/* Nearest rank percentile of sorted values */
+static double percentile(const std::vector<double> &sorted, double fraction) {
+	size_t rank = (size_t)std::ceil(fraction * sorted.size());
+	rank = std::max<size_t>(rank, 1);
+	return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+static double mean(const std::vector<uint> &values) {
+	double sum = 0;
+	for(size_t i=0; i<values.size(); ++i) {
+		sum += values[i];
+	}
+	return sum / values.size();
+}
+
+/* Paths on Windows hosts carry backslashes, which JSON has to escape */
+static void write_json_string(FILE *file, const std::string &value) {
+	fputc('"', file);
+	for(size_t i=0; i<value.size(); ++i) {
+		if(value[i] == '"' || value[i] == '\\') {
+			fputc('\\', file);
+		}
+		fputc(value[i], file);
+	}
+	fputc('"', file);
+}
+
+static void write_csv_string(FILE *file, const std::string &value) {
+	fputc('"', file);
+	for(size_t i=0; i<value.size(); ++i) {
+		if(value[i] == '"') {
+			fputc('"', file);
+		}
+		fputc(value[i], file);
+	}
+	fputc('"', file);
+}
+
+TrackingBenchmark::TrackingBenchmark(const TrackingBenchmarkSettings &settings) :
+	settings(settings),
+	total_time_ms(0)
+{
+	/* Empty */
+}
+
+bool TrackingBenchmark::run() {
+	/* The stream engine always suppresses greedily, its report would claim a mode it did not run */
+	if(settings.tracking.suppression_mode == SUPPRESSION_DENSE && settings.engine == "stream") {
+		fprintf(stderr, "The stream engine only has greedy suppression\n");
+		return false;
+	}
+
+	FeatureTracking *engine = create_engine();
+	if(!engine) {
+		fprintf(stderr, "Unknown engine %s\n", settings.engine.c_str());
+		return false;
+	}
+
+	/* The engines only take 1024x768 frames, so the scene is rendered at that size */
+	SyntheticScene *scene = nullptr;
+	if(settings.synthetic) {
+		SceneCamera camera;
+		camera.cols = FeatureTracking::image_width;
+		camera.rows = FeatureTracking::image_height;
+		scene = new SyntheticScene(settings.scene_type, camera, settings.tracking.num_threads, settings.seed);
+		if(!render_frames(*scene)) {
+			delete scene;
+			delete engine;
+			return false;
+		}
+	} else if(!settings.pangu_endpoints.empty()) {
+		if(!acquire_frames()) {
+			delete engine;
+			return false;
+		}
+	} else if(!load_frames()) {
+		delete engine;
+		return false;
+	}
+
+	measure(*engine, scene);
+	delete engine;
+	delete scene;
+
+	return write_report();
+}
+
+bool TrackingBenchmark::load_frames() {
+	return load_frame_sequence(settings.frame_directory, settings.pack_path, FeatureTracking::image_width, FeatureTracking::image_height, frames);
+}
+
+bool TrackingBenchmark::render_frames(SyntheticScene &scene) {
+	/* Enough steps that the timed frames do not wrap around, unless the flight is shorter */
+	const uint num_steps = settings.warmup_frames + settings.frames;
+	if(settings.flight_path.empty()) {
+		steps = synthetic_flight(settings.scene_type, num_steps);
+	} else {
+		steps = read_pangu_steps(settings.flight_path);
+		steps.resize(std::min<size_t>(steps.size(), num_steps));
+		if(steps.empty()) {
+			fprintf(stderr, "No steps in %s\n", settings.flight_path.c_str());
+			return false;
+		}
+	}
+
+	frames.resize(steps.size());
+	for(size_t i=0; i<steps.size(); ++i) {
+		frames[i].resize(FeatureTracking::image_width * FeatureTracking::image_height);
+		scene.render(steps[i], frames[i].data());
+	}
+	return true;
+}
+
+bool TrackingBenchmark::acquire_frames() {
+	/* Enough steps that the timed frames do not wrap around, unless the flight is shorter */
+	steps = read_pangu_steps(settings.flight_path);
+	const uint num_steps = (uint)std::min<size_t>(steps.size(), settings.warmup_frames + settings.frames);
+	if(num_steps == 0) {
+		fprintf(stderr, "No steps in %s\n", settings.flight_path.c_str());
+		return false;
+	}
+
+	PanguServer pangu(&steps);
+	pangu.endpoints = settings.pangu_endpoints;
+	pangu.num_connections = settings.pangu_connections;
+	try {
+		pangu.start(num_steps);
+	} catch(const std::exception &e) {
+		fprintf(stderr, "Failed to start acquiring from PANGU: %s\n", e.what());
+		return false;
+	}
+
+	if(pangu.image_width != FeatureTracking::image_width || pangu.image_height != FeatureTracking::image_height) {
+		fprintf(stderr, "PANGU renders %lux%lu images, the engines take %ux%u\n",
+			pangu.image_width, pangu.image_height, FeatureTracking::image_width, FeatureTracking::image_height);
+		return false;
+	}
+
+	/* Copied out of the server's pool so the tracking run reads them from memory like the other sources */
+	const size_t image_size = FeatureTracking::image_width * FeatureTracking::image_height;
+	const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	frames.reserve(num_steps);
+	while(frames.size() < num_steps) {
+		PanguFrame frame = pangu.get_image(5000);
+		if(!frame.image) {
+			break;
+		}
+		const uchar *image = &frame.image[pangu.image_offset];
+		frames.push_back(std::vector<uchar>(image, image + image_size));
+		pangu.release_image(frame.image);
+	}
+	const double acquire_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	pangu.stop();
+
+	const FrameChannelStats stats = pangu.image_channel_stats();
+	fprintf(stderr, "Acquired %zu of %u frames in %.1f ms, %.2f frames per second, receivers blocked %.1f ms, consumer starved %.1f ms\n",
+		frames.size(), num_steps, acquire_ms, frames.size() * 1000.0 / acquire_ms, stats.producer_blocked_ms, stats.consumer_starved_ms);
+	if(frames.size() < num_steps) {
+		fprintf(stderr, "PANGU stopped sending frames\n");
+		return false;
+	}
+	return true;
+}
+
+FeatureTracking * TrackingBenchmark::create_engine() {
+	if(settings.engine == "cpu") {
+		return new FeatureTrackingCpu(settings.tracking);
+	}
+	if(settings.engine == "stream") {
+		return new FeatureTrackingStream(settings.tracking);
+	}
+	return nullptr;
+}
+
+void TrackingBenchmark::measure(FeatureTracking &engine, const SyntheticScene *scene) {
+	const size_t num_frames = frames.size();
+	for(uint i=0; i<settings.warmup_frames; ++i) {
+		engine.feature_points(frames[i % num_frames].data());
+	}
+
+	frame_times_ms.reserve(settings.frames);
+	feature_counts.reserve(settings.frames);
+	tracked_counts.reserve(settings.frames);
+	frame_stats.reserve(settings.frames);
+
+	/* Only the engine call is timed, counting the features is left outside */
+	const std::chrono::steady_clock::time_point run_start = std::chrono::steady_clock::now();
+	for(uint i=0; i<settings.frames; ++i) {
+		uchar *frame = frames[(settings.warmup_frames + i) % num_frames].data();
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const FeatureStore &features = engine.feature_points(frame);
+		const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		frame_times_ms.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+
+		uint tracked = 0;
+		for(uint j=0; j<features.size(); ++j) {
+			if(features.track_frames(j) > 0) {
+				++tracked;
+			}
+		}
+		feature_counts.push_back(features.size());
+		tracked_counts.push_back(tracked);
+		frame_stats.push_back(engine.tracking_stats());
+		if(scene) {
+			measure_accuracy(*scene, features, (settings.warmup_frames + i) % num_frames);
+		}
+	}
+	total_time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - run_start).count();
+}
+
+void TrackingBenchmark::measure_accuracy(const SyntheticScene &scene, const FeatureStore &features, uint frame) {
+	/* The step before the first frame is the last, which is not where the features came from */
+	if(frame == 0) {
+		return;
+	}
+
+	for(uint i=0; i<features.size(); ++i) {
+		/* Features tracked at least once moved in this frame, new ones did not */
+		if(features.track_frames(i) == 0) {
+			continue;
+		}
+
+		const Point previous = features.history(i)[(features.location_idx(i) + MAX_TRACKED_POINT_LOCATIONS - 1) % MAX_TRACKED_POINT_LOCATIONS];
+		const Point location = features.location(i);
+		double x, y;
+		if(scene.displace(steps[frame - 1], steps[frame], previous.x, previous.y, x, y)) {
+			tracking_errors.push_back(std::sqrt(((location.x - x) * (location.x - x)) + ((location.y - y) * (location.y - y))));
+		}
+	}
+}
+
+bool TrackingBenchmark::write_report() {
+	if(frame_times_ms.empty()) {
+		fprintf(stderr, "No frames were timed\n");
+		return false;
+	}
+
+	std::vector<double> sorted(frame_times_ms);
+	std::sort(sorted.begin(), sorted.end());
+
+	double sum_ms = 0;
+	for(size_t i=0; i<sorted.size(); ++i) {
+		sum_ms += sorted[i];
+	}
+
+	Summary summary;
+	summary.threads = settings.tracking.num_threads ? settings.tracking.num_threads : std::thread::hardware_concurrency();
+	summary.mean_ms = sum_ms / sorted.size();
+	summary.p50_ms = percentile(sorted, 0.50);
+	summary.p95_ms = percentile(sorted, 0.95);
+	summary.p99_ms = percentile(sorted, 0.99);
+	summary.max_ms = sorted.back();
+	/* Over the engine calls alone, the wall time of the run is reported separately */
+	summary.frames_per_second = sorted.size() * 1000.0 / sum_ms;
+	summary.features_per_frame = mean(feature_counts);
+	summary.tracked_per_frame = mean(tracked_counts);
+
+	for(uint i=0; i<NUM_TRACKING_STAGES; ++i) {
+		summary.stage_ms[i] = 0;
+	}
+	summary.candidates_per_frame = 0;
+	summary.suppressed_per_frame = 0;
+	summary.lost_per_frame = 0;
+	summary.added_per_frame = 0;
+	for(size_t i=0; i<frame_stats.size(); ++i) {
+		for(uint j=0; j<NUM_TRACKING_STAGES; ++j) {
+			summary.stage_ms[j] += frame_stats[i].stage_ms[j] / frame_stats.size();
+		}
+		summary.candidates_per_frame += (double)frame_stats[i].candidates / frame_stats.size();
+		summary.suppressed_per_frame += (double)frame_stats[i].suppressed / frame_stats.size();
+		summary.lost_per_frame += (double)frame_stats[i].lost / frame_stats.size();
+		summary.added_per_frame += (double)frame_stats[i].added / frame_stats.size();
+	}
+
+	summary.mean_error_px = 0;
+	summary.p95_error_px = 0;
+	summary.within_1px = 0;
+	if(!tracking_errors.empty()) {
+		std::vector<double> errors(tracking_errors);
+		std::sort(errors.begin(), errors.end());
+		for(size_t i=0; i<errors.size(); ++i) {
+			summary.mean_error_px += errors[i] / errors.size();
+			summary.within_1px += errors[i] <= 1.0 ? 1.0 / errors.size() : 0;
+		}
+		summary.p95_error_px = percentile(errors, 0.95);
+	}
+
+	std::string source = settings.pack_path.empty() ? settings.frame_directory : settings.pack_path;
+	if(!settings.pangu_endpoints.empty()) {
+		source = "pangu";
+		for(size_t i=0; i<settings.pangu_endpoints.size(); ++i) {
+			source += (i ? "," : " ") + settings.pangu_endpoints[i].host + ":" + std::to_string(settings.pangu_endpoints[i].port);
+		}
+		source += " " + settings.flight_path;
+	}
+	if(settings.synthetic) {
+		source = std::string("synthetic ") + scene_type_name(settings.scene_type);
+		if(!settings.flight_path.empty()) {
+			source += " " + settings.flight_path;
+		}
+	}
+	const char *suppression = settings.tracking.suppression_mode == SUPPRESSION_DENSE ? "dense" : "greedy";
+	const char *simd = simd_level_name(detect_simd_level());
+
+	FILE *file = stdout;
+	bool header = true;
+	if(!settings.output_path.empty()) {
+		file = fopen(settings.output_path.c_str(), settings.format == REPORT_CSV ? "ab" : "wb");
+		if(!file) {
+			fprintf(stderr, "Failed to open %s\n", settings.output_path.c_str());
+			return false;
+		}
+		fseek(file, 0, SEEK_END);
+		header = ftell(file) == 0;
+	}
+
+	if(settings.format == REPORT_CSV) {
+		if(header) {
+			fprintf(file, "engine,simd,threads,suppression,source,frames_loaded,warmup_frames,frames,wall_time_ms,mean_ms,p50_ms,p95_ms,p99_ms,max_ms,frames_per_second,features_per_frame,tracked_per_frame");
+			for(uint i=0; i<NUM_TRACKING_STAGES; ++i) {
+				fprintf(file, ",%s_ms", tracking_stage_name((TrackingStage)i));
+			}
+			fprintf(file, ",candidates_per_frame,suppressed_per_frame,lost_per_frame,added_per_frame,mean_error_px,p95_error_px,within_1px\n");
+		}
+		fprintf(file, "%s,%s,%u,%s,", settings.engine.c_str(), simd, summary.threads, suppression);
+		write_csv_string(file, source);
+		fprintf(file, ",%zu,%u,%u,%.3f,%.4f,%.4f,%.4f,%.4f,%.4f,%.2f,%.2f,%.2f",
+			frames.size(), settings.warmup_frames, settings.frames, total_time_ms,
+			summary.mean_ms, summary.p50_ms, summary.p95_ms, summary.p99_ms, summary.max_ms,
+			summary.frames_per_second, summary.features_per_frame, summary.tracked_per_frame);
+		for(uint i=0; i<NUM_TRACKING_STAGES; ++i) {
+			fprintf(file, ",%.4f", summary.stage_ms[i]);
+		}
+		fprintf(file, ",%.2f,%.2f,%.2f,%.2f", summary.candidates_per_frame, summary.suppressed_per_frame, summary.lost_per_frame, summary.added_per_frame);
+		if(settings.synthetic) {
+			fprintf(file, ",%.4f,%.4f,%.4f\n", summary.mean_error_px, summary.p95_error_px, summary.within_1px);
+		} else {
+			fprintf(file, ",,,\n");
+		}
+	} else {
+		fprintf(file, "{\n");
+		fprintf(file, "\t\"engine\": \"%s\",\n", settings.engine.c_str());
+		fprintf(file, "\t\"simd\": \"%s\",\n", simd);
+		fprintf(file, "\t\"threads\": %u,\n", summary.threads);
+		fprintf(file, "\t\"suppression\": \"%s\",\n", suppression);
+		fprintf(file, "\t\"source\": ");
+		write_json_string(file, source);
+		fprintf(file, ",\n");
+		fprintf(file, "\t\"frames_loaded\": %zu,\n", frames.size());
+		fprintf(file, "\t\"warmup_frames\": %u,\n", settings.warmup_frames);
+		fprintf(file, "\t\"frames\": %u,\n", settings.frames);
+		fprintf(file, "\t\"wall_time_ms\": %.3f,\n", total_time_ms);
+		fprintf(file, "\t\"mean_ms\": %.4f,\n", summary.mean_ms);
+		fprintf(file, "\t\"p50_ms\": %.4f,\n", summary.p50_ms);
+		fprintf(file, "\t\"p95_ms\": %.4f,\n", summary.p95_ms);
+		fprintf(file, "\t\"p99_ms\": %.4f,\n", summary.p99_ms);
+		fprintf(file, "\t\"max_ms\": %.4f,\n", summary.max_ms);
+		fprintf(file, "\t\"frames_per_second\": %.2f,\n", summary.frames_per_second);
+		fprintf(file, "\t\"features_per_frame\": %.2f,\n", summary.features_per_frame);
+		fprintf(file, "\t\"tracked_per_frame\": %.2f,\n", summary.tracked_per_frame);
+		fprintf(file, "\t\"stage_ms\": {");
+		for(uint i=0; i<NUM_TRACKING_STAGES; ++i) {
+			fprintf(file, "%s\"%s\": %.4f", i ? ", " : "", tracking_stage_name((TrackingStage)i), summary.stage_ms[i]);
+		}
+		fprintf(file, "},\n");
+		fprintf(file, "\t\"candidates_per_frame\": %.2f,\n", summary.candidates_per_frame);
+		fprintf(file, "\t\"suppressed_per_frame\": %.2f,\n", summary.suppressed_per_frame);
+		fprintf(file, "\t\"lost_per_frame\": %.2f,\n", summary.lost_per_frame);
+		fprintf(file, "\t\"added_per_frame\": %.2f%s\n", summary.added_per_frame, settings.synthetic ? "," : "");
+		if(settings.synthetic) {
+			fprintf(file, "\t\"mean_error_px\": %.4f,\n", summary.mean_error_px);
+			fprintf(file, "\t\"p95_error_px\": %.4f,\n", summary.p95_error_px);
+			fprintf(file, "\t\"within_1px\": %.4f\n", summary.within_1px);
+		}
+		fprintf(file, "}\n");
+	}
+
+	const bool written = !ferror(file);
+	if(file != stdout) {
+		fclose(file);
+	}
+	return written;
+}
@@ -0,0 +1,105 @@
+#pragma once
+#ifndef TRACKING_BENCHMARK_HPP
+#define TRACKING_BENCHMARK_HPP
+
+#include <string>
+#include <vector>
+
+#include "Pangu/pangu_connection.hpp"
+#include "Pangu/synthetic_scene.hpp"
+#include "Tracking/feature_tracking.hpp"
+#include "Utils/types.hpp"
+
+enum ReportFormat {
+	REPORT_JSON,
+	REPORT_CSV
+};
+
+struct TrackingBenchmarkSettings {
+	/* Frames come from a directory of PGM files in name order or from every
+	image in a frame cache pack in the order it was recorded. All of them are
+	loaded before the run so no file access is timed */
+	std::string frame_directory;
+	std::string pack_path;
+	/* Or frames rendered by a SyntheticScene, along the flight file when one
+	is given and along synthetic_flight otherwise. Tracking accuracy is then
+	measured against the scene's exact displacements */
+	bool synthetic;
+	SceneType scene_type;
+	std::string flight_path;
+	unsigned long long seed;
+	/* Or frames acquired from PANGU servers, or MockPangu, along the flight
+	file through PanguServer before the run, over pangu_connections
+	connections. The acquisition rate is reported on stderr */
+	std::vector<PanguEndpoint> pangu_endpoints;
+	uint pangu_connections;
+	/* cpu or stream */
+	std::string engine;
+	/* Frames tracked before timing starts, then frames timed. Both walk the
+	loaded sequence in order, wrapping around when it is shorter */
+	uint warmup_frames;
+	uint frames;
+	ReportFormat format;
+	/* Report file, printed when empty. CSV rows are appended and the header
+	is only written to a new file, so runs on one host can be collected */
+	std::string output_path;
+	TrackingSettings tracking;
+
+	TrackingBenchmarkSettings() {
+		synthetic = false;
+		scene_type = SCENE_CRATERS;
+		seed = 1;
+		pangu_connections = 1;
+		engine = "cpu";
+		warmup_frames = 10;
+		frames = 200;
+		format = REPORT_JSON;
+
+		/* The Gui's default settings */
+		tracking.max_frames = 0;
+		tracking.sensitivity = 0.04f;
+		tracking.max_tracked_features = 200;
+		tracking.harris_response_threshhold = 1000000.0f;
+		tracking.correlation_threshhold = 0.5f;
+		tracking.template_update_frames = 3;
+		tracking.template_update_distance_threshhold = 3.5f;
+		tracking.num_threads = 0;
+		tracking.suppression_mode = SUPPRESSION_GREEDY;
+		tracking.suppression_range = 3;
+	}
+};
+
+/* Times a FeatureTracking engine on frames held in memory, without PANGU,
+the Gui or any image conversion on the tracking thread */
+class TrackingBenchmark {
+public:
+	TrackingBenchmark(const TrackingBenchmarkSettings &settings);
+
+	/* Load the frames, run the engine and write the report. Returns false if
+	the frames cannot be loaded or the report cannot be written */
+	bool run();
+
+private:
+	TrackingBenchmarkSettings settings;
+	std::vector<std::vector<uchar>> frames;
+	/* Steps the synthetic frames were rendered from */
+	std::vector<PanguStep> steps;
+
+	std::vector<double> frame_times_ms;
+	std::vector<uint> feature_counts;
+	std::vector<uint> tracked_counts;
+	std::vector<TrackingStats> frame_stats;
+	/* Pixels between each tracked feature and where the scene moved it */
+	std::vector<double> tracking_errors;
+	double total_time_ms;
+
+	bool load_frames();
+	bool render_frames(SyntheticScene &scene);
+	bool acquire_frames();
+	FeatureTracking * create_engine();
+	void measure(FeatureTracking &engine, const SyntheticScene *scene);
+	void measure_accuracy(const SyntheticScene &scene, const FeatureStore &features, uint frame);
+	bool write_report();
+};
+
+#endif /* TRACKING_BENCHMARK_HPP */
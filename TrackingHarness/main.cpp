@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+#include "tracking_harness.hpp"
+
+static void print_usage() {
+	printf(
+		"Usage: TrackingHarness [options]\n"
+		"  --frames DIR             Compare on the 1024x768 PGM files in DIR in name order\n"
+		"  --pack FILE              Compare on the images of a frame cache pack in recorded order\n"
+		"  --reference NAME         Reference engine, cpu or stream (cpu)\n"
+		"  --reference-threads N    Reference threads, 0 for one per hardware thread (1)\n"
+		"  --candidate NAME         Candidate engine, cpu or stream (stream)\n"
+		"  --candidate-threads N    Candidate threads, 0 for one per hardware thread (0)\n"
+		"  --count N                Frames compared, the sequence repeats if shorter (each once)\n"
+		"  --suppression MODE       greedy or dense, dense only with two cpu engines (greedy)\n"
+		"  --max-features N         Maximum tracked features (200)\n"
+		"  --harris-threshold T     Harris response threshold (1000000)\n"
+		"  --relative-tolerance R   Relative response tolerance (0.00001)\n"
+		"  --absolute-tolerance A   Absolute response tolerance (1)\n"
+		"  --reported-frames N      Differing frames reported in detail (10)\n"
+		"  --listed N               Differing corners and tracks listed per frame (5)\n"
+		"  --output FILE            Write the report to FILE\n"
+		"Exits with 0 when every frame matches, 1 when one differs and 2 on errors\n"
+	);
+}
+
+int main(int argc, char **argv) {
+	TrackingHarnessSettings settings;
+
+	for(int i=1; i<argc; ++i) {
+		const std::string option = argv[i];
+		if(option == "--help" || i + 1 >= argc) {
+			print_usage();
+			return option == "--help" ? HARNESS_MATCH : HARNESS_ERROR;
+		}
+
+		const std::string value = argv[++i];
+		if(option == "--frames") {
+			settings.frame_directory = value;
+		} else if(option == "--pack") {
+			settings.pack_path = value;
+		} else if(option == "--reference") {
+			settings.reference_engine = value;
+		} else if(option == "--reference-threads") {
+			settings.reference_threads = (uint)atoi(value.c_str());
+		} else if(option == "--candidate") {
+			settings.candidate_engine = value;
+		} else if(option == "--candidate-threads") {
+			settings.candidate_threads = (uint)atoi(value.c_str());
+		} else if(option == "--count") {
+			settings.frames = (uint)atoi(value.c_str());
+		} else if(option == "--suppression" && (value == "greedy" || value == "dense")) {
+			settings.tracking.suppression_mode = value == "dense" ? SUPPRESSION_DENSE : SUPPRESSION_GREEDY;
+		} else if(option == "--max-features") {
+			settings.tracking.max_tracked_features = (uint)atoi(value.c_str());
+		} else if(option == "--harris-threshold") {
+			settings.tracking.harris_response_threshhold = (float)atof(value.c_str());
+		} else if(option == "--relative-tolerance") {
+			settings.response_relative_tolerance = (float)atof(value.c_str());
+		} else if(option == "--absolute-tolerance") {
+			settings.response_absolute_tolerance = (float)atof(value.c_str());
+		} else if(option == "--reported-frames") {
+			settings.reported_frames = (uint)atoi(value.c_str());
+		} else if(option == "--listed") {
+			settings.listed_entries = (uint)atoi(value.c_str());
+		} else if(option == "--output") {
+			settings.output_path = value;
+		} else {
+			print_usage();
+			return HARNESS_ERROR;
+		}
+	}
+
+	TrackingHarness harness(settings);
+	return harness.run();
+}
@@ -0,0 +1,311 @@
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <thread>
+
+#include "tracking_harness.hpp"
+#include "Pangu/frame_sequence.hpp"
+#include "Tracking/feature_store.hpp"
+#include "Tracking/Cpu/feature_tracking_cpu.hpp"
+#include "Tracking/Cpu/feature_tracking_stream.hpp"
+
+static bool point_less(const Point &a, const Point &b) {
+	return a.y != b.y ? a.y < b.y : a.x < b.x;
+}
+
+static bool point_equal(const Point &a, const Point &b) {
+	return a.x == b.x && a.y == b.y;
+}
+
+static bool history_less(const std::vector<Point> &a, const std::vector<Point> &b) {
+	return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), point_less);
+}
+
+static bool history_equal(const std::vector<Point> &a, const std::vector<Point> &b) {
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), point_equal);
+}
+
+TrackingHarness::TrackingHarness(const TrackingHarnessSettings &settings) :
+	settings(settings),
+	report(stdout),
+	differing_frames(0),
+	first_differing_frame(0)
+{
+	/* Empty */
+}
+
+HarnessResult TrackingHarness::run() {
+	/* The stream engine always suppresses greedily, against a dense engine every frame would differ */
+	if(settings.tracking.suppression_mode == SUPPRESSION_DENSE && (settings.reference_engine == "stream" || settings.candidate_engine == "stream")) {
+		fprintf(stderr, "The stream engine only has greedy suppression, compare dense suppression between cpu engines\n");
+		return HARNESS_ERROR;
+	}
+
+	/* Engines keep a reference to their settings, so each gets its own copy */
+	TrackingSettings reference_settings = settings.tracking;
+	TrackingSettings candidate_settings = settings.tracking;
+	FeatureTracking *reference = create_engine(settings.reference_engine, settings.reference_threads, reference_settings);
+	FeatureTracking *candidate = create_engine(settings.candidate_engine, settings.candidate_threads, candidate_settings);
+	if(!reference || !candidate) {
+		fprintf(stderr, "Unknown engine %s\n", reference ? settings.candidate_engine.c_str() : settings.reference_engine.c_str());
+		delete reference;
+		delete candidate;
+		return HARNESS_ERROR;
+	}
+
+	if(!load_frame_sequence(settings.frame_directory, settings.pack_path, FeatureTracking::image_width, FeatureTracking::image_height, frames)) {
+		delete reference;
+		delete candidate;
+		return HARNESS_ERROR;
+	}
+
+	if(!settings.output_path.empty()) {
+		report = fopen(settings.output_path.c_str(), "wb");
+		if(!report) {
+			fprintf(stderr, "Failed to open %s\n", settings.output_path.c_str());
+			delete reference;
+			delete candidate;
+			return HARNESS_ERROR;
+		}
+	}
+
+	TrackingCapture reference_capture;
+	TrackingCapture candidate_capture;
+	reference->set_capture(&reference_capture);
+	candidate->set_capture(&candidate_capture);
+
+	const uint num_frames = settings.frames ? settings.frames : (uint)frames.size();
+	fprintf(report, "Reference %s on %u threads, candidate %s on %u threads, %s suppression, %u frames\n",
+		settings.reference_engine.c_str(), reference_settings.num_threads,
+		settings.candidate_engine.c_str(), candidate_settings.num_threads,
+		settings.tracking.suppression_mode == SUPPRESSION_DENSE ? "dense" : "greedy", num_frames);
+
+	for(uint i=0; i<num_frames; ++i) {
+		/* Engines may write to the frame they are given, so each gets its own copy */
+		std::vector<uchar> reference_frame(frames[i % frames.size()]);
+		std::vector<uchar> candidate_frame(frames[i % frames.size()]);
+		const FeatureStore &reference_features = reference->feature_points(reference_frame.data());
+		const FeatureStore &candidate_features = candidate->feature_points(candidate_frame.data());
+		compare_frame(i, reference_capture, reference_features, candidate_capture, candidate_features);
+	}
+
+	if(differing_frames) {
+		fprintf(report, "FAIL: %u of %u frames differ, the first is frame %u\n", differing_frames, num_frames, first_differing_frame);
+	} else {
+		fprintf(report, "PASS: all %u frames match\n", num_frames);
+	}
+
+	delete reference;
+	delete candidate;
+
+	const bool written = !ferror(report);
+	if(report != stdout) {
+		fclose(report);
+	}
+	if(!written) {
+		fprintf(stderr, "Failed to write the report\n");
+		return HARNESS_ERROR;
+	}
+	return differing_frames ? HARNESS_MISMATCH : HARNESS_MATCH;
+}
+
+FeatureTracking * TrackingHarness::create_engine(const std::string &engine, uint threads, TrackingSettings &tracking) {
+	tracking.num_threads = threads ? threads : std::thread::hardware_concurrency();
+	if(engine == "cpu") {
+		return new FeatureTrackingCpu(tracking);
+	}
+	if(engine == "stream") {
+		return new FeatureTrackingStream(tracking);
+	}
+	return nullptr;
+}
+
+void TrackingHarness::compare_frame(
+	uint frame,
+	const TrackingCapture &reference_capture, const FeatureStore &reference_features,
+	const TrackingCapture &candidate_capture, const FeatureStore &candidate_features)
+{
+	const bool detailed = differing_frames < settings.reported_frames;
+
+	/* Every check runs so a detailed frame lists all of its differences */
+	const bool response_match = compare_response(frame, reference_capture, candidate_capture, detailed);
+	const bool harris_points_match = compare_harris_points(frame, reference_capture.harris_points, candidate_capture.harris_points, detailed);
+	const bool tracks_match = compare_tracks(frame, reference_features, candidate_features, detailed);
+
+	if(!response_match || !harris_points_match || !tracks_match) {
+		if(!differing_frames) {
+			first_differing_frame = frame;
+		}
+		++differing_frames;
+		if(differing_frames == settings.reported_frames) {
+			fprintf(report, "Later differing frames are only counted\n");
+		}
+	}
+}
+
+bool TrackingHarness::compare_response(uint frame, const TrackingCapture &reference, const TrackingCapture &candidate, bool detailed) {
+	if(reference.response_cols != candidate.response_cols || reference.response_rows != candidate.response_rows) {
+		if(detailed) {
+			fprintf(report, "Frame %u: response map is %ux%u in the reference and %ux%u in the candidate\n",
+				frame, reference.response_cols, reference.response_rows, candidate.response_cols, candidate.response_rows);
+		}
+		return false;
+	}
+
+	size_t mismatches = 0;
+	size_t worst = 0;
+	float worst_difference = 0;
+	for(size_t i=0; i<reference.response.size(); ++i) {
+		const float expected = reference.response[i];
+		const float actual = candidate.response[i];
+		const float difference = std::fabs(actual - expected);
+		/* NaN only matches NaN */
+		const bool nan = std::isnan(expected) || std::isnan(actual);
+		if(nan ? std::isnan(expected) != std::isnan(actual) : difference > settings.response_absolute_tolerance + settings.response_relative_tolerance * std::fabs(expected)) {
+			if(!mismatches || nan || difference > worst_difference) {
+				worst = i;
+				worst_difference = nan ? INFINITY : difference;
+			}
+			++mismatches;
+		}
+	}
+
+	if(mismatches && detailed) {
+		/* Response coordinates are offset from the image by the Sobel and blur borders */
+		const uint border = 1 + FeatureTracking::filter_range;
+		fprintf(report, "Frame %u: %zu of %zu response values outside tolerance, the worst at (%u, %u) is %g in the reference and %g in the candidate\n",
+			frame, mismatches, reference.response.size(),
+			(uint)(worst % reference.response_cols) + border, (uint)(worst / reference.response_cols) + border,
+			reference.response[worst], candidate.response[worst]);
+	}
+	return mismatches == 0;
+}
+
+bool TrackingHarness::compare_harris_points(uint frame, std::vector<Point> reference, std::vector<Point> candidate, bool detailed) {
+	std::sort(reference.begin(), reference.end(), point_less);
+	std::sort(candidate.begin(), candidate.end(), point_less);
+
+	std::vector<Point> reference_only;
+	std::vector<Point> candidate_only;
+	std::set_difference(reference.begin(), reference.end(), candidate.begin(), candidate.end(), std::back_inserter(reference_only), point_less);
+	std::set_difference(candidate.begin(), candidate.end(), reference.begin(), reference.end(), std::back_inserter(candidate_only), point_less);
+	if(reference_only.empty() && candidate_only.empty()) {
+		return true;
+	}
+
+	if(detailed) {
+		fprintf(report, "Frame %u: %zu corners selected by the reference and %zu by the candidate, %zu only by the reference and %zu only by the candidate\n",
+			frame, reference.size(), candidate.size(), reference_only.size(), candidate_only.size());
+		for(size_t i=0; i<reference_only.size() && i<settings.listed_entries; ++i) {
+			fprintf(report, "\tReference only corner at (%u, %u)\n", reference_only[i].x, reference_only[i].y);
+		}
+		for(size_t i=0; i<candidate_only.size() && i<settings.listed_entries; ++i) {
+			fprintf(report, "\tCandidate only corner at (%u, %u)\n", candidate_only[i].x, candidate_only[i].y);
+		}
+	}
+	return false;
+}
+
+bool TrackingHarness::compare_tracks(uint frame, const FeatureStore &reference_features, const FeatureStore &candidate_features, bool detailed) {
+	/* Stores reorder features on removal, so tracks are compared as sorted sets */
+	const std::vector<Track> reference = sorted_tracks(reference_features);
+	const std::vector<Track> candidate = sorted_tracks(candidate_features);
+
+	std::vector<const Track *> reference_only;
+	std::vector<const Track *> candidate_only;
+	size_t i = 0;
+	size_t j = 0;
+	while(i < reference.size() || j < candidate.size()) {
+		if(i < reference.size() && j < candidate.size() && history_equal(reference[i].history, candidate[j].history)) {
+			if(reference[i].track_frames != candidate[j].track_frames) {
+				reference_only.push_back(&reference[i]);
+				candidate_only.push_back(&candidate[j]);
+			}
+			++i;
+			++j;
+		} else if(j == candidate.size() || (i < reference.size() && history_less(reference[i].history, candidate[j].history))) {
+			reference_only.push_back(&reference[i++]);
+		} else {
+			candidate_only.push_back(&candidate[j++]);
+		}
+	}
+	if(reference_only.empty() && candidate_only.empty()) {
+		return true;
+	}
+
+	if(detailed) {
+		fprintf(report, "Frame %u: %zu tracks in the reference and %zu in the candidate, %zu only in the reference and %zu only in the candidate\n",
+			frame, reference.size(), candidate.size(), reference_only.size(), candidate_only.size());
+
+		/* Tracks which started at the same corner are reported where they part */
+		uint listed = 0;
+		std::vector<bool> candidate_listed(candidate_only.size(), false);
+		for(size_t k=0; k<reference_only.size() && listed<settings.listed_entries; ++k, ++listed) {
+			const Track &track = *reference_only[k];
+			const Point start = track.history.front();
+			const Point end = track.history.back();
+
+			size_t match = candidate_only.size();
+			for(size_t l=0; l<candidate_only.size() && match==candidate_only.size(); ++l) {
+				if(!candidate_listed[l] && point_equal(candidate_only[l]->history.front(), start)) {
+					match = l;
+				}
+			}
+
+			if(match == candidate_only.size()) {
+				fprintf(report, "\tReference only track from (%u, %u) to (%u, %u) over %zu locations, tracked %u frames\n",
+					start.x, start.y, end.x, end.y, track.history.size(), track.track_frames);
+				continue;
+			}
+
+			candidate_listed[match] = true;
+			const Track &other = *candidate_only[match];
+			size_t part = 0;
+			while(part < track.history.size() && part < other.history.size() && point_equal(track.history[part], other.history[part])) {
+				++part;
+			}
+			if(part < track.history.size() && part < other.history.size()) {
+				fprintf(report, "\tTrack from (%u, %u) parts at location %zu, (%u, %u) in the reference and (%u, %u) in the candidate\n",
+					start.x, start.y, part, track.history[part].x, track.history[part].y, other.history[part].x, other.history[part].y);
+			} else {
+				fprintf(report, "\tTrack from (%u, %u) has %zu locations and %u tracked frames in the reference and %zu and %u in the candidate\n",
+					start.x, start.y, track.history.size(), track.track_frames, other.history.size(), other.track_frames);
+			}
+		}
+		listed = 0;
+		for(size_t k=0; k<candidate_only.size() && listed<settings.listed_entries; ++k) {
+			if(candidate_listed[k]) {
+				continue;
+			}
+			const Track &track = *candidate_only[k];
+			fprintf(report, "\tCandidate only track from (%u, %u) to (%u, %u) over %zu locations, tracked %u frames\n",
+				track.history.front().x, track.history.front().y, track.history.back().x, track.history.back().y,
+				track.history.size(), track.track_frames);
+			++listed;
+		}
+	}
+	return false;
+}
+
+std::vector<TrackingHarness::Track> TrackingHarness::sorted_tracks(const FeatureStore &features) {
+	std::vector<Track> tracks(features.size());
+	for(uint i=0; i<features.size(); ++i) {
+		/* Every successful track moves the feature once, so the ring holds
+		track_frames + 1 locations until it wraps */
+		const uint length = std::min(features.track_frames(i) + 1, (uint)MAX_TRACKED_POINT_LOCATIONS);
+		const uint head = features.location_idx(i);
+		const Point *history = features.history(i);
+
+		Track &track = tracks[i];
+		track.track_frames = features.track_frames(i);
+		track.history.reserve(length);
+		for(uint k=0; k<length; ++k) {
+			track.history.push_back(history[(head + MAX_TRACKED_POINT_LOCATIONS + 1 - length + k) % MAX_TRACKED_POINT_LOCATIONS]);
+		}
+	}
+
+	std::sort(tracks.begin(), tracks.end(), [](const Track &a, const Track &b) {
+		return history_less(a.history, b.history);
+	});
+	return tracks;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#ifndef TRACKING_HARNESS_HPP
+#define TRACKING_HARNESS_HPP
+
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+#include "Tracking/feature_tracking.hpp"
+#include "Utils/types.hpp"
+
+/* Exit codes of the harness */
+enum HarnessResult {
+	HARNESS_MATCH = 0,
+	HARNESS_MISMATCH = 1,
+	HARNESS_ERROR = 2
+};
+
+struct TrackingHarnessSettings {
+	/* Frames come from a directory of PGM files in name order or from every
+	image in a frame cache pack in the order it was recorded */
+	std::string frame_directory;
+	std::string pack_path;
+	/* Engines compared, cpu or stream, each with its own thread count */
+	std::string reference_engine;
+	uint reference_threads;
+	std::string candidate_engine;
+	uint candidate_threads;
+	/* Frames compared, walking the loaded sequence in order and wrapping
+	around when it is shorter. 0 compares each loaded frame once */
+	uint frames;
+	/* A response matches when it is within absolute + relative * |reference|
+	of the reference. Corners and tracks have to match exactly */
+	float response_relative_tolerance;
+	float response_absolute_tolerance;
+	/* Frames reported in detail and entries listed per frame, once tracks
+	diverge every later frame differs so only the first few are useful */
+	uint reported_frames;
+	uint listed_entries;
+	/* Report file, printed when empty */
+	std::string output_path;
+	TrackingSettings tracking;
+
+	TrackingHarnessSettings() {
+		reference_engine = "cpu";
+		reference_threads = 1;
+		candidate_engine = "stream";
+		candidate_threads = 0;
+		frames = 0;
+		response_relative_tolerance = 1e-5f;
+		response_absolute_tolerance = 1.0f;
+		reported_frames = 10;
+		listed_entries = 5;
+
+		/* The Gui's default settings */
+		tracking.max_frames = 0;
+		tracking.sensitivity = 0.04f;
+		tracking.max_tracked_features = 200;
+		tracking.harris_response_threshhold = 1000000.0f;
+		tracking.correlation_threshhold = 0.5f;
+		tracking.template_update_frames = 3;
+		tracking.template_update_distance_threshhold = 3.5f;
+		tracking.num_threads = 0;
+		tracking.suppression_mode = SUPPRESSION_GREEDY;
+		tracking.suppression_range = 3;
+	}
+};
+
+/* Runs a reference and a candidate FeatureTracking engine side by side over
+the same frames and compares each frame's Harris response map, selected
+corners and the location history of every track. Meant for landing SIMD,
+multithreaded and fused rewrites of an engine without checking the overlay
+by eye */
+class TrackingHarness {
+public:
+	TrackingHarness(const TrackingHarnessSettings &settings);
+
+	/* Load the frames, run both engines and write the report */
+	HarnessResult run();
+
+private:
+	/* A track's locations oldest first, as far as its history ring reaches */
+	struct Track {
+		std::vector<Point> history;
+		uint track_frames;
+	};
+
+	TrackingHarnessSettings settings;
+	std::vector<std::vector<uchar>> frames;
+	FILE *report;
+	uint differing_frames;
+	uint first_differing_frame;
+
+	FeatureTracking * create_engine(const std::string &engine, uint threads, TrackingSettings &tracking);
+	void compare_frame(uint frame, const TrackingCapture &reference_capture, const FeatureStore &reference_features, const TrackingCapture &candidate_capture, const FeatureStore &candidate_features);
+	bool compare_response(uint frame, const TrackingCapture &reference, const TrackingCapture &candidate, bool detailed);
+	bool compare_harris_points(uint frame, std::vector<Point> reference, std::vector<Point> candidate, bool detailed);
+	bool compare_tracks(uint frame, const FeatureStore &reference, const FeatureStore &candidate, bool detailed);
+
+	static std::vector<Track> sorted_tracks(const FeatureStore &features);
+};
+
+#endif /* TRACKING_HARNESS_HPP */